@@ -10,6 +10,8 @@
 #include "xrt.h"
 #include "ert.h"
 
+#include <atomic>
+
 /**
  * class command - Command API expected by sws and kds command monitor
  */
@@ -18,6 +20,24 @@ namespace xrt_core {
 class command : public std::enable_shared_from_this<command>
 {
 public:
+  /**
+   * struct queue_link - intrusive link for lock free command queues
+   *
+   * Used by the command manager to track managed commands without
+   * allocating or locking on submission.  A command can be linked in
+   * at most one queue at a time.
+   *
+   * @next:      next link in queue
+   * @cancelled: command was queued but failed submission
+   * @cmd:       the command owning this link, nullptr for a stub link
+   */
+  struct queue_link
+  {
+    std::atomic<queue_link*> next {nullptr};
+    std::atomic<bool> cancelled {false};
+    command* cmd = nullptr;
+  };
+
   /**
    * command() - construct a command object
    */
@@ -25,6 +45,7 @@ public:
   {
     static unsigned int count = 0;
     m_uid = count++;
+    m_link.cmd = this;
   }
 
   virtual
@@ -75,8 +96,18 @@ public:
   virtual hwctx_handle*
   get_hwctx_handle() const = 0;
 
+  /**
+   * get_queue_link() - intrusive link used by command manager
+   */
+  queue_link*
+  get_queue_link()
+  {
+    return &m_link;
+  }
+
 private:
   unsigned long m_uid;
+  queue_link m_link;
 };
 
 
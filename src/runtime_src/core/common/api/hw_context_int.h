@@ -7,7 +7,10 @@
 // This file defines implementation extensions to the XRT XCLBIN APIs.
 #include "core/include/experimental/xrt_hw_context.h"
 
+#include <chrono>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 // Provide access to xrt::xclbin data that is not directly exposed
 // to end users via xrt::xclbin.   These functions are used by
@@ -43,6 +46,24 @@ XRT_CORE_COMMON_EXPORT
 xrt::hw_context
 create_hw_context_from_implementation(void* hwctx_impl);
 
+// Spin budget of command waits on the hw queue of this context if
+// set through cfg_param "exec_wait_spin_us" or set_exec_wait_spin_budget
+std::optional<std::chrono::microseconds>
+get_exec_wait_spin_budget(const xrt::hw_context& ctx);
+
+// Set the time a thread waiting for a command of this context spins
+// before blocking, see xrt_core::hw_queue::set_spin_budget.  Contexts
+// without a hw queue of their own share the queue of the device.
+XRT_CORE_COMMON_EXPORT
+void
+set_exec_wait_spin_budget(const xrt::hw_context& ctx, const std::chrono::microseconds& budget);
+
+// Command completion latency histogram of the hw queue of this
+// context, see xrt_core::hw_queue::get_latency_histogram
+XRT_CORE_COMMON_EXPORT
+std::vector<uint64_t>
+get_exec_wait_latency_histogram(const xrt::hw_context& ctx);
+
 }} // hw_context_int, xrt_core
 
 #endif
@@ -9,8 +9,10 @@
 #include "hw_context_int.h"
 #include "fence_int.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/debug.h"
 #include "core/common/device.h"
+#include "core/common/message.h"
 #include "core/common/thread.h"
 #include "core/include/ert.h"
 #include "core/include/xrt_hwqueue.h"
@@ -19,12 +21,15 @@
 #include "experimental/xrt_fence.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <sstream>
 #include <thread>
 
 using namespace std::chrono_literals;
@@ -38,7 +43,6 @@ using namespace std::chrono_literals;
 ////////////////////////////////////////////////////////////////
 namespace {
 
-using command_queue_type = std::vector<xrt_core::command*>;
 static std::exception_ptr s_exception;
 
 inline ert_cmd_state
@@ -74,11 +78,177 @@ notify_host(xrt_core::command* cmd)
   notify_host(cmd, get_command_state(cmd));
 }
 
+// class latency_histogram - log2 histogram of command completion latency
+//
+// Bucket 0 counts latencies below 1us, bucket i counts latencies in
+// [2^(i-1), 2^i) us.  The last bucket is open ended.  Counters are
+// updated without locking by threads waiting for commands.
+class latency_histogram
+{
+public:
+  static constexpr size_t num_buckets = 24;
+
+private:
+  std::array<std::atomic<uint64_t>, num_buckets> m_buckets {};
+
+public:
+  void
+  record(const std::chrono::nanoseconds& latency)
+  {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    size_t idx = 0;
+    for (; us > 0 && idx < num_buckets - 1; us >>= 1)
+      ++idx;
+    m_buckets[idx].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::vector<uint64_t>
+  snapshot() const
+  {
+    std::vector<uint64_t> counts;
+    counts.reserve(num_buckets);
+    for (const auto& bucket : m_buckets)
+      counts.push_back(bucket.load(std::memory_order_relaxed));
+    return counts;
+  }
+
+  // Format non-empty buckets, e.g. "[8,16)us: 1024 [16,32)us: 12"
+  std::string
+  to_string() const
+  {
+    std::ostringstream ostr;
+    auto counts = snapshot();
+    for (size_t idx = 0; idx < counts.size(); ++idx) {
+      if (!counts[idx])
+        continue;
+      uint64_t lo = idx ? (1ULL << (idx - 1)) : 0;
+      ostr << " [" << lo << ",";
+      if (idx < num_buckets - 1)
+        ostr << (1ULL << idx);
+      else
+        ostr << "inf";
+      ostr << ")us: " << counts[idx];
+    }
+    return ostr.str();
+  }
+};
+
+// class command_queue - lock free multi producer single consumer queue
+//
+// Intrusive queue of commands linked through their queue_link.  A
+// producer pushes a command with one atomic exchange followed by a
+// store to link the previous tail, no allocation or locking.  The
+// single consumer pops without locking.
+//
+// A push that is in progress (exchange done, link store not yet done)
+// temporarily hides itself and subsequent pushes from the consumer.
+// The consumer therefore uses the count of queued commands to know
+// how many commands it must wait for when draining the queue.  The
+// count is incremented by producers before pushing.
+class command_queue
+{
+  using link_type = xrt_core::command::queue_link;
+
+  std::atomic<link_type*> m_head;     // producer end
+  link_type* m_tail;                  // consumer end
+  link_type m_stub;                   // sentinel
+  std::atomic<size_t> m_queued {0};   // number of commands queued
+
+  void
+  push(link_type* link)
+  {
+    link->next.store(nullptr, std::memory_order_relaxed);
+    auto prev = m_head.exchange(link, std::memory_order_acq_rel);
+    prev->next.store(link, std::memory_order_release);
+  }
+
+  // Pop one command, returns nullptr if queue is empty or if a push
+  // is in progress.
+  link_type*
+  pop()
+  {
+    auto tail = m_tail;
+    auto next = tail->next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+      if (!next)
+        return nullptr;
+      m_tail = tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+
+    if (tail != m_head.load(std::memory_order_acquire))
+      return nullptr; // push in progress
+
+    // tail is last element, re-insert stub to pop it
+    push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+
+    return nullptr; // push in progress
+  }
+
+public:
+  command_queue()
+    : m_head(&m_stub), m_tail(&m_stub)
+  {}
+
+  // Number of commands queued but not yet drained.  Sequentially
+  // consistent for use in sleep / wake-up protocol with consumer.
+  size_t
+  size() const
+  {
+    return m_queued.load();
+  }
+
+  // Add a command to the queue, called by any thread
+  void
+  enqueue(xrt_core::command* cmd)
+  {
+    ++m_queued;
+    push(cmd->get_queue_link());
+  }
+
+  // Move all commands queued prior to this call to the argument
+  // vector in queue order, called by consumer only.  Commands that
+  // are being pushed concurrently are waited for if they were counted
+  // as queued.  Commands that failed submission are skipped.
+  void
+  drain(std::vector<xrt_core::command*>& cmds)
+  {
+    auto count = m_queued.load();
+    while (count) {
+      auto link = pop();
+      if (!link) {
+        // producer is between exchange and link store
+        std::this_thread::yield();
+        continue;
+      }
+
+      --count;
+      --m_queued;
+      if (link->cancelled.exchange(false))
+        continue;
+
+      cmds.push_back(link->cmd);
+    }
+  }
+};
+
 // class command_manager - managed command executuon
 //
 // @m_qimpl: The hw queue used for command submission
 // @work_mutex: Syncrhonize monitor thread with launched commands
 // @work_cond: Kick off monitor thread when there are new commands
+// @submitted_cmds: Lock free queue of launched commands
+// @monitor_idle: Monitor thread is sleeping or about to sleep
 // @monitor_thread: Thread for asynchronous monitoring of command execution
 // @stop: Stop the monitor thread
 //
@@ -90,6 +260,9 @@ notify_host(xrt_core::command* cmd)
 //
 // The command manager requires submission and wait APIs to be implemented
 // by which ever object (hw queue) uses the manager.
+//
+// Launching a command does not lock unless the monitor thread is idle
+// and must be woken up.
 class command_manager
 {
 public:
@@ -106,13 +279,33 @@ private:
   executor* m_impl;
   std::mutex work_mutex;
   std::condition_variable work_cond;
-  command_queue_type submitted_cmds;
-  uint64_t exec_wait_call_count = 0;
+  command_queue submitted_cmds;
+  std::atomic<bool> monitor_idle {false};
   bool stop = false;
 
+  // Commands that failed submission are retained until drained by
+  // monitor thread.  Rare, so protected by a lock.
+  std::mutex cancel_mutex;
+  std::vector<std::shared_ptr<xrt_core::command>> cancelled_cmds;
+  std::atomic<bool> has_cancelled {false};
+
   // thread can be constructed only after data members are initialized
   std::thread monitor_thread;
 
+  // Release commands that failed submission once they have been
+  // drained from the submitted commands.
+  void
+  release_cancelled()
+  {
+    std::lock_guard lk(cancel_mutex);
+    auto itr = std::remove_if(cancelled_cmds.begin(), cancelled_cmds.end(),
+                              [](const auto& cmd) {
+                                return !cmd->get_queue_link()->cancelled.load();
+                              });
+    cancelled_cmds.erase(itr, cancelled_cmds.end());
+    has_cancelled = !cancelled_cmds.empty();
+  }
+
   // monitor_loop() - Manage running commands and notify on completion
   //
   // The monitor thread services managed command and asynchronously
@@ -128,44 +321,67 @@ private:
 
     while (1) {
 
-      // Larger wait synchronized with launch()
-      {
+      // Larger wait synchronized with launch().  The idle flag and
+      // the queue size form a Dekker style handshake with launch()
+      // which only locks and notifies if the monitor is idle.
+      if (running_cmds.empty() && !submitted_cmds.size()) {
         std::unique_lock<std::mutex> lk(work_mutex);
-        while (!stop && running_cmds.empty() && submitted_cmds.empty())
+        monitor_idle = true;
+        while (!stop && !submitted_cmds.size())
           work_cond.wait(lk);
+        monitor_idle = false;
       }
 
       if (stop)
         return;
 
+      // Retire commands that failed submission without waiting for
+      // other commands to complete, the finer wait would otherwise
+      // block if only cancelled commands are pending.  Draining
+      // before the finer wait is harmless since submitted_cmds is
+      // drained again after it.
+      if (has_cancelled) {
+        submitted_cmds.drain(running_cmds);
+        auto itr = std::remove_if(running_cmds.begin(), running_cmds.end(),
+                                  [](auto cmd) {
+                                    return cmd->get_queue_link()->cancelled.exchange(false);
+                                  });
+        running_cmds.erase(itr, running_cmds.end());
+        release_cancelled();
+        if (running_cmds.empty())
+          continue;
+      }
+
       // Finer wait
       m_impl->wait(0);
 
       // Drain submitted commands.  It is important that this comes
-      // after exec_wait and is synchronized with launch() that added
-      // to submitted_cmds.
+      // after exec_wait and that launch() adds to submitted_cmds
+      // before exec_buf.
       //
       // Scenario if before exec_wait is that a new command was added
-      // to submitted_cmds and exec_buf immediately after the critical
-      // section above and that the command completion happens in the
-      // exec_wait call. If submitted_cmds was drained, in for example
-      // above critical section, before the call to exec_wait it would
-      // not be in running_cmds and would not be notified of
-      // completion.
+      // to submitted_cmds and exec_buf immediately after the drain and
+      // that the command completion happens in the exec_wait call. If
+      // submitted_cmds was drained, in for example above critical
+      // section, before the call to exec_wait it would not be in
+      // running_cmds and would not be notified of completion.
       //
       // The sequence is very important.  It must be guaranteed that
       // exec_wait will never return for a command that is not yet
-      // in either running_cmds or submitted_cmds.
-      {
-        std::lock_guard<std::mutex> lk(work_mutex);
-        std::copy(submitted_cmds.begin(), submitted_cmds.end(), std::back_inserter(running_cmds));
-        submitted_cmds.clear();
-      }
+      // in either running_cmds or submitted_cmds.  The lock free
+      // queue guarantees that a command that was enqueued before
+      // exec_wait returned is drained here.
+      submitted_cmds.drain(running_cmds);
+
       // At this point running_cmds is guaranteed to contain the
       // command(s) for which exec_wait returned.
 
-      // Preserve order of processing
+      // Preserve order of processing.  A command that failed submission
+      // after it was drained is dropped.
       for (auto cmd : running_cmds) {
+        if (cmd->get_queue_link()->cancelled.exchange(false))
+          continue;
+
         if (completed(cmd))
           notify_host(cmd);
         else
@@ -174,6 +390,9 @@ private:
 
       running_cmds.swap(busy_cmds);
       busy_cmds.clear();
+
+      if (has_cancelled)
+        release_cancelled();
     } // while (1)
   }
 
@@ -244,27 +463,45 @@ public:
     // Store command so completion can be tracked.  Make sure this is
     // done prior to exec_buf as exec_wait can otherwise be missed.
     // See detailed explanation in monitor loop.
-    {
-      std::lock_guard<std::mutex> lk(work_mutex);
-      submitted_cmds.push_back(cmd);
-    }
+    //
+    // A command that failed submission is removed from tracking by
+    // the monitor thread when it sees the cancelled flag.  If this
+    // thread clears the flag first, the command is still tracked by
+    // the monitor (queued or running) and must not be enqueued again.
+    if (!cmd->get_queue_link()->cancelled.exchange(false))
+      submitted_cmds.enqueue(cmd);
 
     // Submit the command
     try {
       m_impl->submit(cmd);
     }
     catch (...) {
-      // Remove the pending command
-      std::lock_guard<std::mutex> lk(work_mutex);
+      // The pending command cannot be removed from the lock free
+      // queue, mark it cancelled so monitor skips it and retain it
+      // until monitor has drained it.
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
-      if (!submitted_cmds.empty())
-        submitted_cmds.pop_back();
+      {
+        std::lock_guard lk(cancel_mutex);
+        cancelled_cmds.push_back(cmd->shared_from_this());
+        cmd->get_queue_link()->cancelled = true;
+        has_cancelled = true;
+      }
+
+      // Wake up the monitor thread to retire the command
+      {
+        std::lock_guard lk(work_mutex);
+        work_cond.notify_one();
+      }
       throw;
     }
 
-    // This is somewhat expensive, it is better to have this after the
+    // Wake up the monitor thread only if it is idle.  This is
+    // somewhat expensive, it is better to have this after the
     // exec_buf call so that actual execution doesn't have to wait.
-    work_cond.notify_one();
+    if (monitor_idle) {
+      std::lock_guard lk(work_mutex);
+      work_cond.notify_one();
+    }
   }
 };
 
@@ -307,6 +544,8 @@ class hw_queue_impl : public command_manager::executor
 {
   std::unique_ptr<command_manager> m_cmd_manager;
   unsigned int m_uid = 0;
+  std::atomic<uint64_t> m_spin_budget_us {xrt_core::config::get_exec_wait_spin_us()};
+  std::unique_ptr<latency_histogram> m_latency;
 
   // Thread safe on-demand creation of m_cmd_manager
   command_manager*
@@ -335,6 +574,8 @@ public:
   {
     static unsigned int count = 0;
     m_uid = count++;
+    if (xrt_core::config::get_exec_wait_latency_histogram())
+      m_latency = std::make_unique<latency_histogram>();
     XRT_DEBUGF("hw_queue_impl::hw_queue_impl(%d) this(0x%x)\n", m_uid, this);
   }
 
@@ -342,6 +583,13 @@ public:
   ~hw_queue_impl()
   {
     XRT_DEBUGF("hw_queue_impl::~hw_queue_impl(%d)\n", m_uid);
+    if (m_latency) {
+      auto histogram = m_latency->to_string();
+      if (!histogram.empty())
+        xrt_core::message::send(xrt_core::message::severity_level::info, "XRT",
+                                "hw_queue(" + std::to_string(m_uid) + ") command completion latency:" + histogram);
+    }
+
     if (m_cmd_manager) {
       m_cmd_manager->clear_executor();
       std::lock_guard lk(s_pool_mutex);
@@ -353,6 +601,10 @@ public:
   virtual void
   submit(xrt_core::command* cmd) = 0;
 
+  // Submit list of commands for execution as one unit
+  virtual void
+  submit(const std::vector<xrt_core::command*>& cmds) = 0;
+
   // Wait for some command to finish
   virtual std::cv_status
   wait(size_t timeout_ms) = 0;
@@ -369,6 +621,80 @@ public:
   virtual void
   submit_signal(const xrt::fence& fence) = 0;
 
+  void
+  set_spin_budget(const std::chrono::microseconds& budget)
+  {
+    m_spin_budget_us = budget.count();
+  }
+
+  std::vector<uint64_t>
+  get_latency_histogram() const
+  {
+    return m_latency ? m_latency->snapshot() : std::vector<uint64_t>{};
+  }
+
+  // Start time of a command wait, used to compute completion latency
+  // and spin budget.  Returns epoch if neither is enabled.
+  std::chrono::steady_clock::time_point
+  wait_start() const
+  {
+    return (m_latency || m_spin_budget_us)
+      ? std::chrono::steady_clock::now()
+      : std::chrono::steady_clock::time_point{};
+  }
+
+  // Record completion latency of a command wait that started at
+  // specified time.
+  void
+  record_latency(const std::chrono::steady_clock::time_point& start)
+  {
+    if (m_latency)
+      m_latency->record(std::chrono::steady_clock::now() - start);
+  }
+
+  // Spin on command state for at most the spin budget starting from
+  // specified time.  Spinning avoids the cost of blocking in the
+  // driver and waking up for commands that complete within the budget.
+  //
+  // The spin is clamped to the wait timeout (0 is no timeout).
+  // Returns no_timeout if the command completed while spinning and
+  // timeout if the wait timed out while spinning.  Otherwise the
+  // caller must block for the remaining timeout, which is updated.
+  std::optional<std::cv_status>
+  spin_wait(const ert_packet* pkt, const std::chrono::steady_clock::time_point& start,
+            size_t& timeout_ms) const
+  {
+    auto budget = std::chrono::microseconds(m_spin_budget_us.load(std::memory_order_relaxed));
+    if (budget.count() == 0)
+      return std::nullopt;
+
+    std::chrono::milliseconds timeout{timeout_ms};
+    if (timeout_ms)
+      budget = std::min<std::chrono::microseconds>(budget, timeout);
+
+    while (pkt->state < ERT_CMD_STATE_COMPLETED) {
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      if (elapsed < budget) {
+        std::this_thread::yield();
+
+        // Command state is updated by driver, force a re-read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        continue;
+      }
+
+      if (!timeout_ms)
+        return std::nullopt;
+
+      if (elapsed >= timeout)
+        return std::cv_status::timeout;
+
+      timeout_ms = (timeout - std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)).count();
+      return std::nullopt;
+    }
+
+    return std::cv_status::no_timeout;
+  }
+
   // Managed start uses command manager for monitoring command
   // completion
   void
@@ -385,8 +711,28 @@ public:
     submit(cmd);
   }
 
+  // Unmanaged start of a list of commands submits the commands
+  // directly for execution as one unit.  Command completion must
+  // be explicitly managed by application
+  void
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+  {
+    submit(cmds);
+  }
 };
 
+// Collect the exec buffers of a list of commands for submission
+// as one unit.
+static std::vector<xrt_core::buffer_handle*>
+get_exec_bos(const std::vector<xrt_core::command*>& cmds)
+{
+  std::vector<xrt_core::buffer_handle*> bos;
+  bos.reserve(cmds.size());
+  std::transform(cmds.begin(), cmds.end(), std::back_inserter(bos),
+                 [](auto cmd) { return cmd->get_exec_bo(); });
+  return bos;
+}
+
 // class qds_device - queue implementation for shim queue support
 class qds_device : public hw_queue_impl
 {
@@ -416,9 +762,12 @@ public:
     // Dispatch wait to shim hwqueue_handle rather than accessing
     // pkt state directly.  This is done to allow shim direct control
     // over command completion and command state.
+    auto start = wait_start();
     if (m_qhdl->wait_command(cmd->get_exec_bo(), static_cast<int>(timeout_ms)) == 0)
       return std::cv_status::timeout;
 
+    record_latency(start);
+
     // Validate command state
     auto pkt = cmd->get_ert_packet();
     if (pkt->state < ERT_CMD_STATE_COMPLETED)
@@ -439,6 +788,12 @@ public:
     m_qhdl->submit_command(cmd->get_exec_bo());
   }
 
+  void
+  submit(const std::vector<xrt_core::command*>& cmds) override
+  {
+    m_qhdl->submit_command(get_exec_bos(cmds));
+  }
+
   void
   submit_wait(const xrt::fence& fence) override
   {
@@ -583,16 +938,28 @@ public:
     return exec_wait(timeout_ms);
   }
 
+  // Wait for specified command to complete.  If a spin budget is
+  // configured, the command state is polled for the budget before
+  // falling back to blocking in device::exec_wait.
   std::cv_status
   wait(const xrt_core::command* cmd, size_t timeout_ms) override
   {
     volatile auto pkt = cmd->get_ert_packet();
-    while (pkt->state < ERT_CMD_STATE_COMPLETED) {
-      // return immediately on timeout
-      if (exec_wait(timeout_ms) == std::cv_status::timeout)
-        return std::cv_status::timeout;
+    auto start = wait_start();
+    auto spin = spin_wait(pkt, start, timeout_ms);
+    if (spin == std::cv_status::timeout)
+      return std::cv_status::timeout;
+
+    if (!spin) {
+      while (pkt->state < ERT_CMD_STATE_COMPLETED) {
+        // return immediately on timeout
+        if (exec_wait(timeout_ms) == std::cv_status::timeout)
+          return std::cv_status::timeout;
+      }
     }
 
+    record_latency(start);
+
     // notify_host is not strictly necessary for unmanaged
     // command execution but provides a central place to update
     // and mark commands as done so they can be re-executed.
@@ -614,6 +981,24 @@ public:
     m_device->exec_buf(cmd->get_exec_bo());
   }
 
+  // All commands in the list must share the same hw context, which
+  // is guaranteed by the caller.  The shim hw context submits the
+  // list as one unit if it supports chained execution.
+  void
+  submit(const std::vector<xrt_core::command*>& cmds) override
+  {
+    if (cmds.empty())
+      return;
+
+    if (auto hwctx = cmds.front()->get_hwctx_handle()) {
+      hwctx->exec_buf(get_exec_bos(cmds));
+      return;
+    }
+
+    for (auto cmd : cmds)
+      m_device->exec_buf(cmd->get_exec_bo());
+  }
+
   void
   submit_wait(const xrt::fence&) override
   {
@@ -702,6 +1087,10 @@ get_hw_queue_impl(const xrt::hw_context& hwctx)
     queues[hwctx_hdl] = hwqimpl = (hwqueue_hdl == nullptr)
       ? get_kds_device_nolock(queues, device)
       : queue_ptr{new xrt_core::qds_device(hwctx, hwqueue_hdl)};
+
+    // Spin budget configured for the context
+    if (auto budget = xrt_core::hw_context_int::get_exec_wait_spin_budget(hwctx))
+      hwqimpl->set_spin_budget(*budget);
   }
   return hwqimpl;
 }
@@ -776,6 +1165,13 @@ unmanaged_start(xrt_core::command* cmd)
   get_handle()->unmanaged_start(cmd);
 }
 
+void
+hw_queue::
+unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+{
+  get_handle()->unmanaged_start(cmds);
+}
+
 // Wait for command completion for unmanaged command execution
 void
 hw_queue::
@@ -784,6 +1180,20 @@ wait(const xrt_core::command* cmd) const
   get_handle()->wait(cmd, 0);
 }
 
+void
+hw_queue::
+set_spin_budget(const std::chrono::microseconds& budget)
+{
+  get_handle()->set_spin_budget(budget);
+}
+
+std::vector<uint64_t>
+hw_queue::
+get_latency_histogram() const
+{
+  return get_handle()->get_latency_histogram();
+}
+
 void
 hw_queue::
 submit_wait(const xrt::fence& fence)
@@ -9,6 +9,7 @@
 #include "experimental/xrt_fence.h"
 
 #include <chrono>
+#include <cstdint>
 #include <condition_variable>
 #include <vector>
 
@@ -53,6 +54,14 @@ public:
   void
   unmanaged_start(xrt_core::command* cmd);
 
+  // Start a list of commands as one unit with explicit completion
+  // control from application.  The commands are submitted in list
+  // order through a single call to the shim.  Completion of each
+  // command must be waited on explicitly.
+  XRT_CORE_COMMON_EXPORT
+  void
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds);
+
   // Wait for command completion.  Supports both managed and unmanaged
   // commands.
   XRT_CORE_COMMON_EXPORT
@@ -64,6 +73,23 @@ public:
   std::cv_status
   wait(const xrt_core::command* cmd, const std::chrono::milliseconds& timeout_ms) const;
 
+  // Set the time a thread waiting for a command spins on the command
+  // state before blocking in the driver.  Overrides the xrt.ini
+  // setting Runtime.exec_wait_spin_us for this queue.  A budget of 0
+  // disables spinning.
+  XRT_CORE_COMMON_EXPORT
+  void
+  set_spin_budget(const std::chrono::microseconds& budget);
+
+  // Histogram of command completion latency as observed by wait() on
+  // this queue.  Bucket 0 counts latencies below 1us, bucket i counts
+  // latencies in [2^(i-1), 2^i) us, the last bucket is open ended.
+  // The histogram is empty unless enabled through xrt.ini setting
+  // Runtime.exec_wait_latency_histogram.
+  XRT_CORE_COMMON_EXPORT
+  std::vector<uint64_t>
+  get_latency_histogram() const;
+
   // Enqueue a command dependency
   void
   submit_wait(const xrt::fence& fence);
@@ -8,6 +8,7 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
 #include "core/include/xrt/xrt_hw_context.h"
 #include "hw_context_int.h"
+#include "hw_queue.h"
 
 #include "core/common/device.h"
 #include "core/common/trace.h"
@@ -15,6 +16,7 @@
 #include "core/common/usage_metrics.h"
 #include "core/common/xdp/profile.h"
 
+#include <atomic>
 #include <limits>
 #include <memory>
 
@@ -35,6 +37,14 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
   std::unique_ptr<xrt_core::hwctx_handle> m_hdl;
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  std::atomic<int64_t> m_spin_budget_us {-1}; // -1 if not set
+
+  void
+  init_spin_budget()
+  {
+    if (auto itr = m_cfg_param.find("exec_wait_spin_us"); itr != m_cfg_param.end())
+      m_spin_budget_us = itr->second;
+  }
 
 public:
   hw_context_impl(std::shared_ptr<xrt_core::device> device, const xrt::uuid& xclbin_id, const cfg_param_type& cfg_param)
@@ -44,6 +54,7 @@ public:
     , m_mode(xrt::hw_context::access_mode::shared)
     , m_hdl{m_core_device->create_hw_context(xclbin_id, m_cfg_param, m_mode)}
   {
+    init_spin_budget();
   }
 
   hw_context_impl(std::shared_ptr<xrt_core::device> device, const xrt::uuid& xclbin_id, access_mode mode)
@@ -123,6 +134,19 @@ public:
   {
     return m_usage_logger.get();
   }
+
+  std::optional<std::chrono::microseconds>
+  get_spin_budget() const
+  {
+    auto us = m_spin_budget_us.load();
+    return (us < 0) ? std::nullopt : std::optional<std::chrono::microseconds>{us};
+  }
+
+  void
+  set_spin_budget(const std::chrono::microseconds& budget)
+  {
+    m_spin_budget_us = budget.count();
+  }
 };
 
 } // xrt
@@ -160,6 +184,27 @@ create_hw_context_from_implementation(void* hwctx_impl)
   return xrt::hw_context(impl_ptr->get_shared_ptr());
 }
 
+std::optional<std::chrono::microseconds>
+get_exec_wait_spin_budget(const xrt::hw_context& hwctx)
+{
+  return hwctx.get_handle()->get_spin_budget();
+}
+
+// The budget is kept by the context so it applies also to a hw queue
+// created after this call
+void
+set_exec_wait_spin_budget(const xrt::hw_context& hwctx, const std::chrono::microseconds& budget)
+{
+  hwctx.get_handle()->set_spin_budget(budget);
+  xrt_core::hw_queue(hwctx).set_spin_budget(budget);
+}
+
+std::vector<uint64_t>
+get_exec_wait_latency_histogram(const xrt::hw_context& hwctx)
+{
+  return xrt_core::hw_queue(hwctx).get_latency_histogram();
+}
+
 }} // hw_context_int, xrt_core
 
 ////////////////////////////////////////////////////////////////
@@ -62,6 +62,7 @@
 #include <stdexcept>
 #include <fstream>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 using namespace std::chrono_literals;
 
@@ -353,8 +354,6 @@ struct device_type
   xrt_core::bo_cache exec_buffer_cache;
   uint32_t uid; // internal unique id for debug
 
-  static constexpr unsigned int cache_size = 128;
-
   static uint32_t
   create_uid()
   {
@@ -365,7 +364,7 @@ struct device_type
   explicit
   device_type(xrtDeviceHandle dhdl)
     : core_device(xrt_core::device_int::get_core_device(dhdl))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
+    , exec_buffer_cache(core_device->get_device_handle(), xrt_core::config::get_exec_buffer_cache_size())
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
@@ -374,7 +373,7 @@ struct device_type
   explicit
   device_type(std::shared_ptr<xrt_core::device> cdev)
     : core_device(std::move(cdev))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
+    , exec_buffer_cache(core_device->get_device_handle(), xrt_core::config::get_exec_buffer_cache_size())
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
@@ -391,11 +390,19 @@ struct device_type
   device_type& operator=(device_type&) = delete;
   device_type& operator=(device_type&&) = delete;
 
+  // Exec buffer that can hold a command packet of specified bytes
   template <typename CommandType>
   xrt_core::bo_cache::cmd_bo<CommandType>
-  create_exec_buf()
+  create_exec_buf(size_t bytes)
+  {
+    return exec_buffer_cache.alloc<CommandType>(bytes);
+  }
+
+  template <typename CommandType>
+  void
+  release_exec_buf(xrt_core::bo_cache::cmd_bo<CommandType>&& execbuf, size_t bytes)
   {
-    return exec_buffer_cache.alloc<CommandType>();
+    exec_buffer_cache.release(std::move(execbuf), bytes);
   }
 
   xrt_core::device*
@@ -702,12 +709,21 @@ private:
 
 
 public:
+  // Default size of exec buffer, sufficient for control commands
+  static constexpr size_t default_execbuf_size = 4096;
+
+  // @dev:     device on which command executes
+  // @hwqueue: queue for command submission
+  // @hwctx:   context of command, null for device level commands
+  // @bytes:   size of command packet, sizes the exec buffer
   explicit
-  kernel_command(std::shared_ptr<device_type> dev, xrt_core::hw_queue hwqueue, xrt::hw_context hwctx = xrt::hw_context())
+  kernel_command(std::shared_ptr<device_type> dev, xrt_core::hw_queue hwqueue,
+                 xrt::hw_context hwctx = xrt::hw_context(), size_t bytes = default_execbuf_size)
     : m_device(std::move(dev))
     , m_hwqueue(std::move(hwqueue))
     , m_hwctx(std::move(hwctx))
-    , m_execbuf(m_device->create_exec_buf<ert_start_kernel_cmd>())
+    , m_execbuf(m_device->create_exec_buf<ert_start_kernel_cmd>(bytes))
+    , m_execbuf_size(bytes)
     , m_done(true)
   {
     static unsigned int count = 0;
@@ -719,7 +735,7 @@ public:
   {
     XRT_DEBUGF("kernel_command::~kernel_command(%d)\n", m_uid);
     // This is problematic, bo_cache should return managed BOs
-    m_device->exec_buffer_cache.release(std::move(m_execbuf));
+    m_device->release_exec_buf(std::move(m_execbuf), m_execbuf_size);
   }
 
   kernel_command(const kernel_command&) = delete;
@@ -746,18 +762,21 @@ public:
   bool
   is_done() const
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
     return m_done;
   }
 
   // Return state of command object.  The underlying packet
   // state is reflected in the command itself.  If function
   // returns completed, then the run object can be reused.
+  //
+  // Managed commands are notified only by the monitor thread, which
+  // must have retired the command before it can be relaunched.
   ert_cmd_state
   get_state() const
   {
     auto state = get_state_raw();
-    notify(state);  // update command state accordingly
+    if (!m_managed)
+      notify(state);  // update command state accordingly
     return state;
   }
 
@@ -851,26 +870,74 @@ public:
   run()
   {
     {
-      std::lock_guard<std::mutex> lk(m_mutex);
+      std::unique_lock<std::mutex> lk(m_mutex);
+
+      // A managed command can be observed completed before the
+      // monitor thread has retired it, wait for it to be done
+      if (!m_done && m_managed && get_state_raw() >= ERT_CMD_STATE_COMPLETED) {
+        ++m_waiters;
+        m_exec_done.wait(lk, [this] { return m_done.load(); });
+        --m_waiters;
+      }
+
       if (!m_done)
         throw std::runtime_error("bad command state, can't launch");
       m_managed = (m_callbacks && !m_callbacks->empty());
       m_done = false;
     }
-    if (m_managed)
-      m_hwqueue.managed_start(this);
-    else
-      m_hwqueue.unmanaged_start(this);
+    try {
+      if (m_managed)
+        m_hwqueue.managed_start(this);
+      else
+        m_hwqueue.unmanaged_start(this);
+    }
+    catch (...) {
+      // Revert to done state so the command can be relaunched
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_done = true;
+      throw;
+    }
+  }
+
+  // Prepare the command for unmanaged execution as part of a list of
+  // commands.  The command is marked running, but submission is done
+  // by the owner of the list.  Commands with callbacks cannot be part
+  // of a list since the list is not monitored for completion.
+  void
+  prep_list_start()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_done)
+      throw std::runtime_error("bad command state, can't launch");
+    if (m_callbacks && !m_callbacks->empty())
+      throw xrt_core::error(ENOTSUP, "Cannot execute command with callbacks as part of a list");
+    m_managed = false;
+    m_done = false;
+  }
+
+  // Revert command to done state if submission of the list failed
+  void
+  abort_list_start()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_done = true;
   }
 
   // Wait for command completion
+  //
+  // Managed commands are marked done by the monitor thread.  The
+  // condition variable is used only if the command is not already
+  // done and notify() locks only if there are waiters.
   ert_cmd_state
   wait() const
   {
     if (m_managed) {
-      std::unique_lock<std::mutex> lk(m_mutex);
-      while (!m_done)
-        m_exec_done.wait(lk);
+      if (!m_done) {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        ++m_waiters;
+        m_exec_done.wait(lk, [this] { return m_done.load(); });
+        --m_waiters;
+      }
     }
     else {
       m_hwqueue.wait(this);
@@ -883,10 +950,14 @@ public:
   wait(const std::chrono::milliseconds& timeout_ms) const
   {
     if (m_managed) {
-      std::unique_lock<std::mutex> lk(m_mutex);
-      while (!m_done)
-        if (m_exec_done.wait_for(lk, timeout_ms) == std::cv_status::timeout)
+      if (!m_done) {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        ++m_waiters;
+        auto done = m_exec_done.wait_for(lk, timeout_ms, [this] { return m_done.load(); });
+        --m_waiters;
+        if (!done)
           return {get_state_raw(), std::cv_status::timeout};
+      }
     }
     else {
       if (m_hwqueue.wait(this, timeout_ms) == std::cv_status::timeout)
@@ -925,30 +996,32 @@ public:
       : nullptr;
   }
 
+  // Mark the command done.  The done state is atomic so that
+  // completion of a command without waiters doesn't lock.  Waiters
+  // increment the waiter count before checking done state, and
+  // notify checks the waiter count after setting done state, so
+  // either the waiter sees done or notify sees the waiter.
   void
   notify(ert_cmd_state s) const override
   {
-    bool complete = false;
-    bool callbacks = false;
-    if (s >= ERT_CMD_STATE_COMPLETED) {
-      std::lock_guard<std::mutex> lk(m_mutex);
+    if (s < ERT_CMD_STATE_COMPLETED)
+      return;
 
-      // Handle potential race if multiple threads end up here. This
-      // condition is by design because there are multiple paths into
-      // this function and first conditional check should not be locked
-      if (m_done)
-        return;
+    // Handle potential race if multiple threads end up here. This
+    // condition is by design because there are multiple paths into
+    // this function and first conditional check should not be locked
+    if (m_done.exchange(true))
+      return;
 
-      XRT_DEBUGF("kernel_command::notify() m_uid(%d) m_state(%d)\n", m_uid, s);
-      complete = m_done = true;
-      callbacks = (m_callbacks && !m_callbacks->empty());
-    }
+    XRT_DEBUGF("kernel_command::notify() m_uid(%d) m_state(%d)\n", m_uid, s);
 
-    if (complete) {
+    if (m_waiters) {
+      std::lock_guard<std::mutex> lk(m_mutex);
       m_exec_done.notify_all();
-      if (callbacks)
-        run_callbacks(s);
     }
+
+    if (m_managed)
+      run_callbacks(s);
   }
 
   void
@@ -965,9 +1038,11 @@ private:
   xrt_core::hw_queue m_hwqueue;  // hwqueue for command submission
   xrt::hw_context m_hwctx;       // hw_context for command
   execbuf_type m_execbuf;        // underlying execution buffer
+  size_t m_execbuf_size;         // requested size of execution buffer
   unsigned int m_uid = 0;
   bool m_managed = false;
-  mutable bool m_done = false;
+  mutable std::atomic<bool> m_done {false};
+  mutable std::atomic<uint32_t> m_waiters {0};
 
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_exec_done;
@@ -1300,6 +1375,7 @@ private:
   xrt::xclbin xclbin;                  // xclbin with this kernel
   xrt::xclbin::kernel xkernel;         // kernel xclbin metadata
   std::vector<argument> args;          // kernel args sorted by argument index
+  std::unordered_map<std::string, int> argindex; // argument name to index
   std::vector<ipctx> ipctxs;           // CU context locks
   const property_type& properties;     // Kernel properties from XML meta
   std::bitset<max_cus> cumask;         // cumask for command execution
@@ -1571,6 +1647,12 @@ public:
     // amend args with computed data based on kernel protocol
     amend_args();
 
+    // name lookup for set_arg by name, first argument wins as in
+    // a scan of the sorted args
+    argindex.reserve(args.size());
+    for (const auto& arg : args)
+      argindex.emplace(arg.name(), static_cast<int>(arg.index()));
+
     m_usage_logger->log_kernel_info(device->core_device.get(), hwctx, name, args.size());
   }
 
@@ -1789,8 +1871,18 @@ public:
     return arg;
   }
 
+  int
+  get_arg_index(const std::string& argnm) const
+  {
+    auto itr = argindex.find(argnm);
+    if (itr == argindex.end())
+      throw xrt_core::error(EINVAL, "No such kernel argument '" + argnm + "'");
+
+    return itr->second;
+  }
+
   size_t
-  get_regmap_size()
+  get_regmap_size() const
   {
     return regmap_size;
   }
@@ -2081,6 +2173,20 @@ class run_impl
     return payload;
   }
 
+  // Size in bytes of the command packet for this run object.  The
+  // packet is the header, the cu masks, the register map, and for
+  // DPU kernels the prepended instruction buffer data.  Headroom is
+  // added for driver appended command state timestamps.
+  size_t
+  get_command_size() const
+  {
+    size_t words = 1 + kernel->get_num_cumasks() + kernel->get_regmap_size();
+    if (m_module)
+      words += xrt_core::module_int::get_ctrlcode_addr_and_size(m_module).size()
+        * (sizeof(ert_dpu_data) / sizeof(uint32_t));
+    return words * sizeof(uint32_t) + sizeof(cu_cmd_state_timestamps);
+  }
+
   using callback_function_type = std::function<void(ert_cmd_state)>;
   std::shared_ptr<kernel_impl> kernel;    // shared ownership
   xrt::module m_module;                   // instruction module (optional)
@@ -2136,7 +2242,7 @@ public:
     , ips(kernel->get_ips())
     , cumask(kernel->get_cumask())
     , core_device(kernel->get_core_device())
-    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context()))
+    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context(), get_command_size()))
     , data(initialize_command(cmd.get()))
     , m_header(0)
     , uid(create_uid())
@@ -2154,7 +2260,7 @@ public:
     , ips(rhs->ips)
     , cumask(rhs->cumask)
     , core_device(rhs->core_device)
-    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context()))
+    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context(), get_command_size()))
     , data(clone_command_data(rhs))
     , m_header(rhs->m_header)
     , uid(create_uid())
@@ -2311,11 +2417,7 @@ public:
   int
   get_arg_index(const std::string& argnm) const
   {
-    for (const auto& arg : kernel->get_args())
-      if (arg.name() == argnm)
-        return arg.index();
-
-    throw xrt_core::error(EINVAL, "No such kernel argument '" + argnm + "'");
+    return kernel->get_arg_index(argnm);
   }
 
   // If this run object's cus were filtered compared to kernel cus
@@ -2367,6 +2469,34 @@ public:
     cmd->run();
   }
 
+  // prep_list_start() - prepare the run object for execution as part
+  // of a runlist.  The command is submitted by the runlist along with
+  // the commands of other run objects in the list.
+  virtual xrt_core::command*
+  prep_list_start()
+  {
+    if (m_module)
+      xrt_core::module_int::sync(m_module);
+
+    prep_start();
+    m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
+    cmd->prep_list_start();
+    return cmd.get();
+  }
+
+  // Revert the run object if runlist submission failed
+  void
+  abort_list_start()
+  {
+    cmd->abort_list_start();
+  }
+
+  const xrt_core::hw_queue&
+  get_hw_queue() const
+  {
+    return m_hwqueue;
+  }
+
   void
   start(const autostart& iterations)
   {
@@ -2757,6 +2887,17 @@ public:
     // Regular start
     run_impl::start();
   }
+
+  xrt_core::command*
+  prep_list_start() override
+  {
+    // same as start() but without submitting the command
+    write();
+    constexpr size_t ap_ctrl_reserved = 4;
+    auto pkt = cmd->get_ert_packet();
+    pkt->count = kernel->get_num_cumasks() + ap_ctrl_reserved;
+    return run_impl::prep_list_start();
+  }
 };
 
 // struct run_update_type - RTP update
@@ -2862,6 +3003,146 @@ public:
   }
 };
 
+// class runlist_impl - The internals of an xrt::runlist
+//
+// A runlist is an ordered list of run objects that are submitted for
+// execution as one unit through the hw queue of the hw context from
+// which the runlist was constructed.  All run objects in the list
+// must be associated with the same hw context.
+//
+// The runlist is executed with unmanaged semantics.  Completion is
+// checked in list order when waiting on the runlist, which for shims
+// that complete chained commands together amounts to one wait.
+class runlist_impl
+{
+  xrt::hw_context m_hwctx;
+  xrt_core::hw_queue m_hwqueue;
+  std::vector<xrt::run> m_runlist;
+  std::vector<xrt_core::command*> m_cmds;
+  bool m_executing = false;
+
+  static xrt_core::hwctx_handle*
+  get_hwctx_handle(const xrt::hw_context& hwctx)
+  {
+    return static_cast<xrt_core::hwctx_handle*>(hwctx);
+  }
+
+  void
+  not_executing_or_error() const
+  {
+    if (m_executing)
+      throw xrt_core::error(EBUSY, "runlist is executing");
+  }
+
+public:
+  explicit
+  runlist_impl(xrt::hw_context hwctx)
+    : m_hwctx(std::move(hwctx))
+    , m_hwqueue(m_hwctx)
+  {}
+
+  void
+  add(const xrt::run& run)
+  {
+    not_executing_or_error();
+
+    const auto& rimpl = run.get_handle();
+    if (get_hwctx_handle(rimpl->get_kernel()->get_hw_context()) != get_hwctx_handle(m_hwctx))
+      throw xrt_core::error(EINVAL, "run object hw context does not match runlist hw context");
+
+    m_runlist.push_back(run);
+    m_cmds.reserve(m_runlist.size());
+  }
+
+  void
+  execute()
+  {
+    not_executing_or_error();
+
+    if (m_runlist.empty())
+      return;
+
+    m_cmds.clear();
+    try {
+      for (const auto& run : m_runlist)
+        m_cmds.push_back(run.get_handle()->prep_list_start());
+
+      m_hwqueue.unmanaged_start(m_cmds);
+    }
+    catch (...) {
+      for (size_t idx = 0; idx < m_cmds.size(); ++idx)
+        m_runlist[idx].get_handle()->abort_list_start();
+      throw;
+    }
+
+    m_executing = true;
+  }
+
+  // Wait for all run objects in list order.  A run object that has
+  // completed is not waited on again, so a timeout can be followed
+  // by another wait.  The timeout applies to the list as a whole,
+  // each run object is waited on for the time that remains.
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout_ms)
+  {
+    if (!m_executing)
+      return std::cv_status::no_timeout;
+
+    auto deadline = std::chrono::steady_clock::now() + timeout_ms;
+    for (const auto& run : m_runlist) {
+      auto remaining = timeout_ms;
+      if (timeout_ms.count()) {
+        // At least 1ms since 0 means wait forever
+        remaining = std::max(1ms, std::chrono::duration_cast<std::chrono::milliseconds>
+                             (deadline - std::chrono::steady_clock::now()));
+      }
+      auto state = run.get_handle()->wait(remaining);
+      if (state == ERT_CMD_STATE_TIMEOUT)
+        return std::cv_status::timeout;
+    }
+
+    m_executing = false;
+
+    for (const auto& run : m_runlist) {
+      auto state = run.get_handle()->state();
+      if (state != ERT_CMD_STATE_COMPLETED)
+        throw xrt::run::command_error
+          (state, "Runlist command failed to complete successfully (" + cmd_state_to_string(state) + ")");
+    }
+
+    return std::cv_status::no_timeout;
+  }
+
+  // The state of the runlist is the state of the first run object
+  // that has not completed successfully, or completed if all run
+  // objects have completed successfully.
+  ert_cmd_state
+  state() const
+  {
+    for (const auto& run : m_runlist) {
+      auto state = run.get_handle()->state();
+      if (state != ERT_CMD_STATE_COMPLETED)
+        return state;
+    }
+
+    return ERT_CMD_STATE_COMPLETED;
+  }
+
+  size_t
+  size() const
+  {
+    return m_runlist.size();
+  }
+
+  void
+  reset()
+  {
+    not_executing_or_error();
+    m_runlist.clear();
+    m_cmds.clear();
+  }
+};
+
 class run::command_error_impl
 {
 public:
@@ -3561,6 +3842,59 @@ set_arg_at_index(int index, const xrt::bo& glb)
 ////////////////////////////////////////////////////////////////
 namespace xrt {
 
+runlist::
+runlist(const xrt::hw_context& hwctx)
+  : detail::pimpl<runlist_impl>(std::make_shared<runlist_impl>(hwctx))
+{}
+
+void
+runlist::
+add(const xrt::run& run)
+{
+  handle->add(run);
+}
+
+void
+runlist::
+execute()
+{
+  XRT_TRACE_POINT_SCOPE(xrt_runlist_execute);
+  xdp::native::profiling_wrapper("xrt::runlist::execute", [this] {
+    handle->execute();
+  });
+}
+
+std::cv_status
+runlist::
+wait(const std::chrono::milliseconds& timeout_ms) const
+{
+  XRT_TRACE_POINT_SCOPE(xrt_runlist_wait);
+  return xdp::native::profiling_wrapper("xrt::runlist::wait", [this, &timeout_ms] {
+    return handle->wait(timeout_ms);
+  });
+}
+
+ert_cmd_state
+runlist::
+state() const
+{
+  return handle->state();
+}
+
+size_t
+runlist::
+size() const
+{
+  return handle->size();
+}
+
+void
+runlist::
+reset()
+{
+  handle->reset();
+}
+
 run::command_error::
 command_error(ert_cmd_state state, const std::string& msg)
   : m_impl(std::make_shared<run::command_error_impl>(state, msg))
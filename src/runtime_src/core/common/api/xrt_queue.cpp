@@ -8,10 +8,13 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "core/include/experimental/xrt_queue.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( disable : 4244 )
@@ -22,68 +25,163 @@ namespace xrt {
 // class queue_impl - insulated implemention of an xrt::queue
 //
 // Manages and executes enqueued tasks.
-// Tasks are executed and completed in order of enqueuing.
 //
-// A queue is associated with exactly one handler thread that executes
-// the task asynchronously to the enqueuer.
+// Tasks enqueued without dependencies are executed and completed in
+// order of enqueuing.  Each such task implicitly depends on the
+// previous one.  Tasks enqueued with dependencies are executed when
+// their dependencies are ready.
+//
+// A queue is associated with one or more handler threads that execute
+// the tasks asynchronously to the enqueuer.  A handler prefers a task
+// whose dependencies are all ready.  If there is none, it picks the
+// oldest task whose in-order predecessor is done and blocks on its
+// remaining dependencies, which are events from other queues or
+// fences, or events of older tasks in this queue.  Since a task can
+// only depend on tasks enqueued before it, the oldest blocked handler
+// always makes progress.
 class queue_impl
 {
-  std::queue<xrt::queue::task> m_queue;  // task queue
+  struct node
+  {
+    queue::task task;
+    std::vector<queue::event> deps;  // events that must be ready
+    std::shared_ptr<node> prev;      // previous in-order task
+    bool done = false;               // guarded by queue mutex
+
+    node(queue::task&& t, std::vector<queue::event>&& d, std::shared_ptr<node> p)
+      : task(std::move(t)), deps(std::move(d)), prev(std::move(p))
+    {}
+
+    bool
+    eligible() const
+    {
+      return !prev || prev->done;
+    }
+
+    bool
+    ready() const
+    {
+      return std::all_of(deps.begin(), deps.end(),
+                         [](const auto& ev) { return ev.ready(); });
+    }
+  };
+
+  std::list<std::shared_ptr<node>> m_pending;  // tasks not yet started
+  std::shared_ptr<node> m_last;                // last in-order task
   std::mutex m_mutex;
   std::condition_variable m_work;
   bool m_stop = false;
 
-  // single worker thread to run the tasks
-  std::thread m_worker;
+  // worker threads to run the tasks
+  std::vector<std::thread> m_workers;
+
+  // Select next task to execute, nullptr if no task can start
+  // Must be called with m_mutex locked
+  std::shared_ptr<node>
+  next()
+  {
+    auto candidate = m_pending.end();
+    for (auto itr = m_pending.begin(); itr != m_pending.end(); ++itr) {
+      auto& n = *itr;
+      if (!n->eligible())
+        continue;
+
+      if (n->ready()) {
+        candidate = itr;
+        break;
+      }
+
+      if (candidate == m_pending.end())
+        candidate = itr;
+    }
+
+    if (candidate == m_pending.end())
+      return nullptr;
+
+    auto n = std::move(*candidate);
+    m_pending.erase(candidate);
+    n->prev.reset();  // done, no need to keep the chain alive
+    return n;
+  }
 
   // worker thread, executes tasks as they become ready
   void
   run()
   {
-    while (!m_stop) {
-      xrt::queue::task task;
+    while (true) {
+      std::shared_ptr<node> n;
 
       // exclusive synchronized region
       {
         std::unique_lock lk(m_mutex);
-        m_work.wait(lk, [this] { return m_stop || !m_queue.empty(); });
+        m_work.wait(lk, [this, &n] { return m_stop || (n = next()); });
 
         if (m_stop)
           return;
+      }
+
+      // allow enqueue while waiting and executing
+      for (auto& ev : n->deps)
+        ev.wait();
+
+      n->task.execute();
 
-        task = std::move(m_queue.front());
-        m_queue.pop();
+      {
+        std::lock_guard lk(m_mutex);
+        n->done = true;
       }
 
-      // allow enqueue while executing
-      task.execute();
+      // completion can make several tasks ready
+      m_work.notify_all();
     }
   }
 
+  void
+  enqueue(std::shared_ptr<node> n)
+  {
+    std::lock_guard lk(m_mutex);
+    m_pending.push_back(std::move(n));
+    m_work.notify_one();
+  }
+
 public:
-  queue_impl()
-    : m_worker([this] { run(); })
-  {}
+  explicit
+  queue_impl(unsigned int workers)
+  {
+    workers = std::max(workers, 1u);
+    m_workers.reserve(workers);
+    for (unsigned int i = 0; i < workers; ++i)
+      m_workers.emplace_back([this] { run(); });
+  }
 
-  // Shut down worker thread
+  // Shut down worker threads
   ~queue_impl()
   {
     {
       std::lock_guard lk(m_mutex);
       m_stop = true;
-      m_work.notify_one();
+      m_work.notify_all();
     }
-    m_worker.join();
+    for (auto& worker : m_workers)
+      worker.join();
   }
 
-  // Enqueue a task and notify worker
+  // Enqueue a task in order of enqueuing and notify worker
   void
   enqueue(queue::task&& t)
   {
     std::lock_guard lk(m_mutex);
-    m_queue.push(std::move(t));
+    m_last = std::make_shared<node>(std::move(t), std::vector<queue::event>{}, m_last);
+    m_pending.push_back(m_last);
     m_work.notify_one();
   }
+
+  // Enqueue a task with dependencies and notify worker
+  void
+  enqueue(queue::task&& t, std::vector<queue::event>&& deps)
+  {
+    enqueue(std::make_shared<node>(std::move(t), std::move(deps), nullptr));
+  }
 };
 
 } // xrt
@@ -95,7 +193,12 @@ namespace xrt {
 
 queue::
 queue()
-  : m_impl(std::make_shared<queue_impl>())
+  : m_impl(std::make_shared<queue_impl>(1))
+{}
+
+queue::
+queue(unsigned int workers)
+  : m_impl(std::make_shared<queue_impl>(workers))
 {}
 
 void
@@ -105,4 +208,11 @@ add_task(task&& t)
   m_impl->enqueue(std::move(t));
 }
 
+void
+queue::
+add_task(task&& t, std::vector<event>&& deps)
+{
+  m_impl->enqueue(std::move(t), std::move(deps));
+}
+
 } // xrt
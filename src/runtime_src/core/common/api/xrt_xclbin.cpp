@@ -10,9 +10,11 @@
 
 #include "core/common/system.h"
 #include "core/common/device.h"
+#include "core/common/detail/mapped_file.h"
 #include "core/common/message.h"
 #include "core/common/module_loader.h"
 #include "core/common/query_requests.h"
+#include "core/common/xclbin_cache.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/xclbin_swemu.h"
 
@@ -382,6 +384,7 @@ class xclbin_impl
   struct xclbin_info
   {
     const xclbin_impl* m_ximpl;
+    xrt_core::xclbin::metadata m_xml;     // parsed XML meta data, kernels are moved
     std::string m_project_name;           // <project name="foo">
     std::string m_fpga_device_name;       // <device fpgaDevice="foo">
     std::vector<xclbin::mem> m_mems;
@@ -439,30 +442,41 @@ class xclbin_impl
       return ips;
     }
 
-    // init_kernels() - populate m_kernels with xclbin::kernel objects
-    //
-    // Iterate the XML meta data section and collect kernel meta data along
-    // with compute units grouped by the kernel.
+    // init_xml() - parse the XML meta data section
     //
-    // Pre-condition for this function is that init_mems() and init_ips()
-    // have been called.
-    static std::vector<xclbin::kernel>
-    init_kernels(const xclbin_impl* ximpl, const std::vector<xclbin::ip>& ips)
+    // The XML is parsed once for all kernels, or the parsed meta data
+    // is loaded from the xclbin meta data cache if enabled.
+    static xrt_core::xclbin::metadata
+    init_xml(const xclbin_impl* ximpl)
     {
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       if (!xml.first)
         return {};
 
+      return xrt_core::xclbin_cache::get_metadata(ximpl->get_uuid(), xml.first, xml.second);
+    }
+
+    // init_kernels() - populate m_kernels with xclbin::kernel objects
+    //
+    // Iterate the XML meta data and collect kernel meta data along
+    // with compute units grouped by the kernel.
+    //
+    // Pre-condition for this function is that init_xml(), init_mems()
+    // and init_ips() have been called.
+    static std::vector<xclbin::kernel>
+    init_kernels(xrt_core::xclbin::metadata& xml, const std::vector<xclbin::ip>& ips)
+    {
       // get kernel CUs from xclbin meta data
       std::vector<xclbin::kernel> kernels;
-      for (auto& kernel : xrt_core::xclbin::get_kernels(xml.first, xml.second)) {
-        auto props = xrt_core::xclbin::get_kernel_properties(xml.first, xml.second, kernel.name);
+      for (auto& kernel : xml.kernels) {
+        auto name = kernel.properties.name;
         std::vector<xclbin::ip> cus;
-        copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), kernel.name);
+        copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), name);
         kernels.emplace_back
           (std::make_shared<xclbin::kernel_impl>
-           (std::move(kernel.name), std::move(props), std::move(cus), std::move(kernel.args)));
+           (std::move(name), std::move(kernel.properties), std::move(cus), std::move(kernel.args)));
       }
+      xml.kernels.clear();
 
       return kernels;
     }
@@ -479,24 +493,6 @@ class xclbin_impl
       return aie_partitions;
     }
 
-    static std::string
-    init_project_name(const xclbin_impl* ximpl)
-    {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      return xml.first
-        ? xrt_core::xclbin::get_project_name(xml.first, xml.second)
-        : "";
-    }
-
-    static std::string
-    init_fpga_device_name(const xclbin_impl* ximpl)
-    {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      return xml.first
-        ? xrt_core::xclbin::get_fpga_device_name(xml.first, xml.second)
-        : "";
-    }
-
     // init_mem_encoding() - compress memory indices
     //
     // Mapping from memory index to encoded index.  The compressed
@@ -571,11 +567,12 @@ class xclbin_impl
     explicit
     xclbin_info(const xrt::xclbin_impl* impl)
       : m_ximpl(impl)
-      , m_project_name(init_project_name(m_ximpl))
-      , m_fpga_device_name(init_fpga_device_name(m_ximpl))
+      , m_xml(init_xml(m_ximpl))
+      , m_project_name(m_xml.project_name)
+      , m_fpga_device_name(m_xml.fpga_device_name)
       , m_mems(init_mems(m_ximpl))
       , m_ips(init_ips(m_ximpl, m_mems))
-      , m_kernels(init_kernels(m_ximpl, m_ips))
+      , m_kernels(init_kernels(m_xml, m_ips))
       , m_aie_partitions(init_aie_partitions(m_ximpl))
       , m_membank_encoding(init_mem_encoding(m_mems))
     {}
@@ -751,23 +748,45 @@ public:
 // class xclbin_full - Implementation of full xclbin
 //
 // A full xclbin is constructed from a file on disk or from a complete
-// binary images for file content
+// binary images for file content.
+//
+// An xclbin file is memory mapped read only rather than copied into
+// process memory, sections are views into the raw data.  Pages of the
+// file are loaded on demand and are shared between processes mapping
+// the same file.  The xclbin meta data is extracted only when first
+// accessed (see xclbin_impl::get_xclbin_info()).
 class xclbin_full : public xclbin_impl
 {
-  std::vector<char> m_axlf;    // complete copy of xclbin raw data
+  using section_view = std::pair<const char*, size_t>;
+
+  std::unique_ptr<xrt_core::detail::mapped_file> m_mapped; // mapped xclbin file
+  std::vector<char> m_axlf;    // complete copy of xclbin raw data if not mapped
   const axlf* m_top = nullptr; // axlf pointer to the raw data
+  size_t m_size = 0;           // size of raw data
   uuid m_uuid;                 // uuid of xclbin
   uuid m_intf_uuid;
 
-  // sections within this xclbin
-  std::multimap<axlf_section_kind, std::vector<char>> m_axlf_sections;
+  // sections within this xclbin, views into raw data
+  std::multimap<axlf_section_kind, section_view> m_axlf_sections;
+
+  static std::unique_ptr<xrt_core::detail::mapped_file>
+  map_xclbin(const std::string& fnm)
+  {
+    if (fnm.empty())
+      throw std::runtime_error("No xclbin specified");
+
+    auto path = xrt_core::environment::platform_path(fnm);
+    return std::make_unique<xrt_core::detail::mapped_file>(path.string());
+  }
 
   void
   emplace_section(const axlf_section_header* hdr, axlf_section_kind kind)
   {
+    if (hdr->m_sectionOffset > m_size || hdr->m_sectionSize > m_size - hdr->m_sectionOffset)
+      throw std::runtime_error("Invalid xclbin, section exceeds xclbin size");
+
     auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
-    std::vector<char> data{section_data, section_data + hdr->m_sectionSize};
-    m_axlf_sections.emplace(kind , std::move(data));
+    m_axlf_sections.emplace(kind, section_view{section_data, hdr->m_sectionSize});
   }
 
   void
@@ -780,12 +799,13 @@ class xclbin_full : public xclbin_impl
   }
 
   void
-  init_axlf()
+  init_axlf(const char* data, size_t size)
   {
-    const axlf* tmp = reinterpret_cast<const axlf*>(m_axlf.data());
-    if (strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
+    const axlf* tmp = reinterpret_cast<const axlf*>(data);
+    if (size < sizeof(axlf) || strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
       throw std::runtime_error("Invalid xclbin");
     m_top = tmp;
+    m_size = size;
 
     m_uuid = uuid(m_top->m_header.uuid);
     m_intf_uuid = uuid(m_top->m_header.m_interface_uuid);
@@ -807,13 +827,16 @@ class xclbin_full : public xclbin_impl
   void
   init()
   {
-    init_axlf();
+    if (m_mapped)
+      init_axlf(m_mapped->data(), m_mapped->size());
+    else
+      init_axlf(m_axlf.data(), m_axlf.size());
   }
 
 public:
   explicit
   xclbin_full(const std::string& filename)
-    : m_axlf(read_xclbin(filename))
+    : m_mapped(map_xclbin(filename))
   {
     init();
   }
@@ -874,7 +897,7 @@ public:
   {
     auto itr = m_axlf_sections.find(kind);
     return itr != m_axlf_sections.end()
-      ? std::make_pair((*itr).second.data(), (*itr).second.size())
+      ? (*itr).second
       : std::make_pair(nullptr, size_t(0));
   }
 
@@ -889,7 +912,7 @@ public:
       std::vector<std::pair<const char*, size_t>> return_sections;
 
       for (auto itr = result.first; itr != result.second; itr++)
-        return_sections.emplace_back(std::make_pair(itr->second.data(), itr->second.size()));
+        return_sections.emplace_back(itr->second);
 
       return return_sections;
     }
@@ -10,9 +10,13 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/include/ert.h"
 
-#include <vector>
-#include <utility>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( push )
@@ -21,8 +25,24 @@
 
 namespace xrt_core {
 
-// Create a cache of CMD BO objects -- for now only used for M2M -- to reduce
-// the overhead of BO life cycle management.
+// Create a cache of CMD BO objects to reduce the overhead of BO life
+// cycle management.
+//
+// The cache is divided into shards, each with its own free lists and
+// lock.  A thread is assigned a home shard on first use so that
+// concurrent threads allocating and releasing command BOs rarely
+// contend on the same lock.  A thread whose home shard is empty
+// borrows from other shards before falling back to allocating a new
+// BO.
+//
+// Command BOs are allocated in page sized classes based on the size
+// of the command packet.  An ert packet is at most 2048 words
+// (11 bit count plus header), so two classes of one and two pages
+// cover all commands.  Larger requests are rounded up to whole pages
+// and are not cached.
+//
+// The total number of cached BOs across all shards and classes is
+// bounded by the configured cache size.
 class bo_cache {
 public:
   // Helper typedef for std::pair. Note the elements are const so that the
@@ -34,70 +54,124 @@ private:
   // We are really allocating a page size as that is what xocl/zocl do. Note on
   // POWER9 pagesize maybe more than 4K, xocl would upsize the allocation to the
   // correct pagesize. unmap always unmaps the full page.
-  static const size_t mBOSize = 4096;
+  static constexpr size_t mBOSize = 4096;
+  static constexpr size_t mNumSizeClasses = 2;
+  static constexpr size_t mNumShards = 8;
+
+  struct shard
+  {
+    std::mutex mutex;
+    std::array<std::vector<cmd_bo<void>>, mNumSizeClasses> free;
+  };
+
   std::shared_ptr<device> mDevice;
   // Maximum number of BOs that can be cached in the pool. Value of 0 indicates
   // caching should be disabled.
   const unsigned int mCacheMaxSize;
-  std::vector<cmd_bo<void>> mCmdBOCache;
-  std::mutex mCacheMutex;
+  // Number of BOs currently cached in all shards
+  std::atomic<size_t> mCacheSize {0};
+  std::array<shard, mNumShards> mShards;
+
+  // Size class of a packet is its number of pages minus one.  Classes
+  // at or beyond mNumSizeClasses are not cached.
+  static size_t
+  size_class(size_t bytes)
+  {
+    return bytes ? (bytes - 1) / mBOSize : 0;
+  }
+
+  static bool
+  cached_class(size_t sc)
+  {
+    return sc < mNumSizeClasses;
+  }
+
+  // Home shard of calling thread
+  static size_t
+  home_shard()
+  {
+    static thread_local size_t idx = std::hash<std::thread::id>{}(std::this_thread::get_id()) % mNumShards;
+    return idx;
+  }
 
 public:
   bo_cache(xclDeviceHandle handle, unsigned int max_size)
-    : mDevice(get_userpf_device(handle)), mCacheMaxSize(max_size)
+    : mDevice(get_userpf_device(handle))
+    , mCacheMaxSize(max_size)
   {}
 
   ~bo_cache()
   {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    for (auto& bo : mCmdBOCache)
-      destroy(bo);
+    for (auto& shard : mShards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (auto& bos : shard.free)
+        for (auto& bo : bos)
+          destroy(bo);
+    }
   }
 
+  // Allocate a command BO that can hold a packet of specified bytes.
   template<typename T>
   cmd_bo<T>
-  alloc()
+  alloc(size_t bytes = mBOSize)
   {
-    auto bo = alloc_impl();
+    auto bo = alloc_impl(size_class(bytes));
     return std::make_pair(std::move(bo.first), static_cast<T *>(bo.second));
   }
 
+  // Release a command BO allocated with specified bytes
   template<typename T>
   void
-  release(cmd_bo<T>&& bo)
+  release(cmd_bo<T>&& bo, size_t bytes = mBOSize)
   {
-    release_impl(std::make_pair(std::move(bo.first), static_cast<void *>(bo.second)));
+    release_impl(std::make_pair(std::move(bo.first), static_cast<void *>(bo.second)), size_class(bytes));
   }
 
 private:
   cmd_bo<void>
-  alloc_impl()
+  alloc_impl(size_t sc)
   {
-    if (mCacheMaxSize) {
-      // If caching is enabled first look up in the BO cache
-      std::lock_guard<std::mutex> lock(mCacheMutex);
-      if (!mCmdBOCache.empty()) {
-        auto bo = std::move(mCmdBOCache.back());
-        mCmdBOCache.pop_back();
-        return bo;
+    if (mCacheMaxSize && cached_class(sc)) {
+      // If caching is enabled first look up in the BO cache, starting
+      // with the thread's home shard
+      auto home = home_shard();
+      for (size_t n = 0; n < mNumShards; ++n) {
+        auto& shard = mShards[(home + n) % mNumShards];
+        std::unique_lock<std::mutex> lock(shard.mutex, std::defer_lock);
+        if (n == 0)
+          lock.lock();
+        else if (!lock.try_lock())
+          continue;  // don't wait for other threads' shards
+
+        auto& bos = shard.free[sc];
+        if (!bos.empty()) {
+          auto bo = std::move(bos.back());
+          bos.pop_back();
+          --mCacheSize;
+          return bo;
+        }
       }
     }
 
-    auto execHandle = mDevice->alloc_bo(mBOSize, XCL_BO_FLAGS_EXECBUF);
+    auto execHandle = mDevice->alloc_bo(mBOSize * (sc + 1), XCL_BO_FLAGS_EXECBUF);
     auto map = execHandle->map(buffer_handle::map_type::write);
     return std::make_pair(std::move(execHandle), map);
   }
 
   void
-  release_impl(cmd_bo<void>&& bo)
+  release_impl(cmd_bo<void>&& bo, size_t sc)
   {
-    if (mCacheMaxSize) {
-      // If caching is enabled and BO cache is not fully populated add this the cache
-      std::lock_guard<std::mutex> lock(mCacheMutex);
-      if (mCmdBOCache.size() < mCacheMaxSize) {
-        mCmdBOCache.push_back(std::move(bo));
+    if (mCacheMaxSize && cached_class(sc)) {
+      // If caching is enabled and the cache is not fully populated
+      // add this to the home shard.  The count is reserved before
+      // the BO is added so concurrent releases cannot exceed the max.
+      if (mCacheSize.fetch_add(1) < mCacheMaxSize) {
+        auto& shard = mShards[home_shard()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.free[sc].push_back(std::move(bo));
         return;
       }
+      --mCacheSize;
     }
     destroy(bo);
   }
@@ -232,6 +232,17 @@ get_trace_file_dump_interval_s()
   return value;
 }
 
+/**
+ * Format of device trace files, "csv" or "binary".  Binary files are
+ * converted to csv with the xdp vtf_converter tool.
+ */
+inline std::string
+get_device_trace_file_format()
+{
+  static std::string value = detail::get_string_value("Debug.device_trace_file_format", "csv");
+  return value;
+}
+
 inline std::string
 get_trace_buffer_size()
 {
@@ -602,6 +613,17 @@ get_noop_completion_delay_us()
   return delay;
 }
 
+/**
+ * Fail every Nth command submission in the noop shim, 0 disables.
+ * Used to test handling of failed command submission.
+ */
+inline unsigned int
+get_noop_exec_buf_fail_interval()
+{
+  static unsigned int interval = detail::get_uint_value("Runtime.noop_exec_buf_fail_interval", 0);
+  return interval;
+}
+
 /**
  * Set CMD BO cache size. CUrrently it is only used in xclCopyBO()
  */
@@ -612,6 +634,62 @@ get_cmdbo_cache()
   return value;
 }
 
+/**
+ * Maximum number of command exec buffers cached per device for reuse
+ * by xrt::run objects.  A value of 0 disables caching.
+ */
+inline unsigned int
+get_exec_buffer_cache_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_buffer_cache_size",128);
+  return value;
+}
+
+/**
+ * Number of microseconds a thread waiting for a command to complete
+ * spins on the command state before blocking in the driver.  A value
+ * of 0 disables spinning.
+ */
+inline unsigned int
+get_exec_wait_spin_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_wait_spin_us",0);
+  return value;
+}
+
+/**
+ * Collect histograms of command completion latency per hw queue.
+ * The histograms are reported when the queue is destroyed.
+ */
+inline bool
+get_exec_wait_latency_histogram()
+{
+  static bool value = detail::get_bool_value("Runtime.exec_wait_latency_histogram",false);
+  return value;
+}
+
+/**
+ * Cache parsed xclbin meta data on disk keyed by xclbin uuid so that
+ * subsequent processes skip parsing of the xclbin XML.
+ */
+inline bool
+get_xclbin_metadata_cache()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_metadata_cache",false);
+  return value;
+}
+
+/**
+ * Directory for xclbin meta data cache files.  Empty string selects
+ * the default platform cache directory.
+ */
+inline std::string
+get_xclbin_metadata_cache_dir()
+{
+  static std::string value = detail::get_string_value("Runtime.xclbin_metadata_cache_dir","");
+  return value;
+}
+
 inline std::string
 get_hw_em_driver()
 {
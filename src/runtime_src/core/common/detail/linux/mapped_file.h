@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Read only memory mapping of a file using mmap.  The mapping is
+// private, pages are loaded on demand and shared with other processes
+// mapping the same file.
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xrt_core::detail {
+
+class mapped_file
+{
+  void* m_addr = nullptr;
+  size_t m_size = 0;
+
+public:
+  explicit
+  mapped_file(const std::string& fnm)
+  {
+    auto fd = ::open(fnm.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::runtime_error("Failed to open file '" + fnm + "' for reading: " + std::strerror(errno));
+
+    struct stat st = {};
+    if (::fstat(fd, &st) < 0 || st.st_size <= 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to stat file '" + fnm + "'");
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    m_addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // mapping keeps its own reference
+    if (m_addr == MAP_FAILED) {
+      m_addr = nullptr;
+      throw std::runtime_error("Failed to map file '" + fnm + "': " + std::strerror(errno));
+    }
+  }
+
+  ~mapped_file()
+  {
+    if (m_addr)
+      ::munmap(m_addr, m_size);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const char*
+  data() const
+  {
+    return static_cast<const char*>(m_addr);
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+} // xrt_core::detail
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef core_common_detail_mapped_file_h
+#define core_common_detail_mapped_file_h
+
+#ifdef _WIN32
+# include "core/common/detail/windows/mapped_file.h"
+#else
+# include "core/common/detail/linux/mapped_file.h"
+#endif
+
+#endif
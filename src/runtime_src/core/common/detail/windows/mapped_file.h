@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Read only memory mapping of a file using a Win32 file mapping
+// object.  Pages are loaded on demand and shared with other processes
+// mapping the same file.
+#include <stdexcept>
+#include <string>
+
+#include <windows.h>
+
+namespace xrt_core::detail {
+
+class mapped_file
+{
+  const void* m_addr = nullptr;
+  size_t m_size = 0;
+
+public:
+  explicit
+  mapped_file(const std::string& fnm)
+  {
+    auto file = CreateFileA(fnm.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      throw std::runtime_error("Failed to open file '" + fnm + "' for reading");
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+      CloseHandle(file);
+      throw std::runtime_error("Failed to stat file '" + fnm + "'");
+    }
+
+    auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // mapping keeps its own reference
+    if (!mapping)
+      throw std::runtime_error("Failed to map file '" + fnm + "'");
+
+    m_addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // view keeps its own reference
+    if (!m_addr)
+      throw std::runtime_error("Failed to map file '" + fnm + "'");
+
+    m_size = static_cast<size_t>(size.QuadPart);
+  }
+
+  ~mapped_file()
+  {
+    if (m_addr)
+      UnmapViewOfFile(m_addr);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const char*
+  data() const
+  {
+    return static_cast<const char*>(m_addr);
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+} // xrt_core::detail
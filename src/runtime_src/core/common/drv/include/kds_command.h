@@ -75,6 +75,8 @@ struct in_kernel_cb {
  * struct kds_command: KDS command struct
  * @client: the client that the command belongs to
  * @hw_ctx_id: This command specific to this hw context
+ * @cu_policy: CU selection policy of the hw context, resolved when
+ *             the command is created
  * @type:   type of the command. Use this to determin controller
  */
 struct kds_command {
@@ -83,6 +85,7 @@ struct kds_command {
 	u32			 rcode;
 	int			 cu_idx;
 	u32			 hw_ctx_id;
+	u32			 cu_policy;
 	u32			 type;
 	u32			 opcode;
 	struct list_head	 list;
@@ -106,6 +109,8 @@ struct kds_command {
 	u32			 cu_mask[4];
 	u32			 num_mask;
 	u64			 start;
+	/* Track CU execution time for latency based CU selection */
+	bool			 cu_latency;
 
 	/* execbuf is used to update the header
 	 * of execbuf when notifying host
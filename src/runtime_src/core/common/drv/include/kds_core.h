@@ -23,6 +23,7 @@
 
 #include "kds_client.h"
 #include "kds_command.h"
+#include "kds_cu_policy.h"
 #include "xrt_cu.h"
 #include "kds_stat.h"
 #include "xclbin.h"
@@ -100,6 +101,9 @@ struct kds_cu_mgmt {
 	u32			  cu_refs[MAX_CUS];
 	struct cu_stats __percpu *cu_stats;
 	int			  rw_shared;
+	/* CU selection for hw contexts without their own policy */
+	u32			  cu_policy;
+	u32			  cu_rr;
 };
 
 #define cu_stat_read(cu_mgmt, field) \
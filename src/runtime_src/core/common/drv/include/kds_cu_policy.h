@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+/*
+ * Xilinx Kernel Driver Scheduler
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * This file is dual-licensed; you may select either the GNU General Public
+ * License version 2 or Apache License, Version 2.0.
+ */
+
+#ifndef _KDS_CU_POLICY_H
+#define _KDS_CU_POLICY_H
+
+/* CU selection policies used by KDS when a command may run on more than
+ * one CU. This header has no kernel dependency so the same selection code
+ * can be built in user space (see drv/sim) to compare policies.
+ *
+ * All policies apply when KDS schedules commands on its CU threads (ERT
+ * disabled). When ERT schedules the commands, the CU load is not tracked
+ * by KDS, and the least outstanding and latency policies fall back to
+ * least used. Least used and round robin apply in both modes.
+ */
+#ifdef __KERNEL__
+#include <linux/types.h>
+#else
+#include <stdbool.h>
+#include <stdint.h>
+typedef uint32_t u32;
+typedef uint64_t u64;
+#endif
+
+enum kds_cu_policy {
+	/* Use the policy of the device (hw context) or least used (device) */
+	KDS_CU_POLICY_DEFAULT = 0,
+	/* Fewest commands submitted since the CU was added */
+	KDS_CU_POLICY_LEAST_USED,
+	/* Fewest commands submitted and not yet completed */
+	KDS_CU_POLICY_LEAST_OUTSTANDING,
+	/* Shortest expected wait, outstanding commands times execution time */
+	KDS_CU_POLICY_LATENCY,
+	/* Rotate over the candidate CUs */
+	KDS_CU_POLICY_ROUND_ROBIN,
+	KDS_CU_POLICY_MAX,
+};
+
+/* Policies that need the outstanding count or execution time that are
+ * tracked only by the KDS CU thread.
+ */
+static inline bool kds_cu_policy_needs_cu_thread(u32 policy)
+{
+	return policy == KDS_CU_POLICY_LEAST_OUTSTANDING ||
+	       policy == KDS_CU_POLICY_LATENCY;
+}
+
+/* Load of one candidate CU. Only the fields used by the policy need
+ * to be filled in.
+ */
+struct kds_cu_load {
+	u64	usage;
+	u32	outstanding;
+	u64	latency_ns;
+};
+
+/* The latency of a CU is an exponentially weighted moving average of
+ * the time from starting a command on the CU to its completion. Each
+ * new sample has weight 1/(1 << SHIFT).
+ */
+#define KDS_CU_EWMA_SHIFT	3
+
+static inline u64 kds_cu_ewma_update(u64 ewma, u64 sample)
+{
+	if (!ewma)
+		return sample;
+
+	return ewma - (ewma >> KDS_CU_EWMA_SHIFT) + (sample >> KDS_CU_EWMA_SHIFT);
+}
+
+static inline const char *kds_cu_policy2str(u32 policy)
+{
+	switch (policy) {
+	case KDS_CU_POLICY_DEFAULT:		return "default";
+	case KDS_CU_POLICY_LEAST_USED:		return "least_used";
+	case KDS_CU_POLICY_LEAST_OUTSTANDING:	return "least_outstanding";
+	case KDS_CU_POLICY_LATENCY:		return "latency";
+	case KDS_CU_POLICY_ROUND_ROBIN:		return "round_robin";
+	default:				return "unknown";
+	}
+}
+
+/**
+ * kds_cu_load_less - Compare the load of two CUs
+ *
+ * @policy: CU selection policy, not KDS_CU_POLICY_ROUND_ROBIN
+ * @a: Load of first CU
+ * @b: Load of second CU
+ *
+ * Returns: true if the command should rather go to the first CU
+ */
+static inline bool
+kds_cu_load_less(u32 policy, const struct kds_cu_load *a,
+		 const struct kds_cu_load *b)
+{
+	u64 cost_a, cost_b;
+
+	switch (policy) {
+	case KDS_CU_POLICY_LEAST_OUTSTANDING:
+		return a->outstanding < b->outstanding;
+	case KDS_CU_POLICY_LATENCY:
+		/* A CU without latency samples counts as the fastest one,
+		 * so every CU is measured before the averages are trusted.
+		 */
+		cost_a = (u64)(a->outstanding + 1) * a->latency_ns;
+		cost_b = (u64)(b->outstanding + 1) * b->latency_ns;
+		if (cost_a != cost_b)
+			return cost_a < cost_b;
+		return a->outstanding < b->outstanding;
+	default:
+		return a->usage < b->usage;
+	}
+}
+
+#endif
@@ -43,6 +43,9 @@ struct kds_client_hw_ctx {
 	/* To support multiple CU context */
 	struct list_head		cu_ctx_list;
 
+	/* CU selection policy, see kds_cu_policy.h */
+	u32				cu_policy;
+
 	/* Per context statistics. Use percpu variable for two reasons
 	 * 1. no lock is need while modifying these counters
 	 * 2. do not need to worry about cache false share
@@ -75,6 +78,9 @@ kds_alloc_hw_ctx(struct kds_client *client, uuid_t *xclbin_id, uint32_t slot_id)
 
 int kds_free_hw_ctx(struct kds_client *client, struct kds_client_hw_ctx *hw_ctx);
 
+int kds_set_hw_ctx_cu_policy(struct kds_client_hw_ctx *hw_ctx, u32 policy);
+u32 kds_get_hw_ctx_cu_policy(struct kds_client *client, uint32_t hw_ctx_id);
+
 ssize_t
 show_kds_cuctx_stat_raw(struct kds_sched *kds, char *buf, size_t buf_size,
 			loff_t offset, uint32_t domain);
@@ -23,6 +23,7 @@
 #include <linux/kthread.h>
 #include <linux/circ_buf.h>
 #include "kds_command.h"
+#include "kds_cu_policy.h"
 
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
 #define ioremap_nocache         ioremap
@@ -370,6 +371,13 @@ struct xrt_cu {
 	u32			  force_intr;
 
 	struct xrt_cu_stats        stats;
+
+	/* Load information used by KDS to select a CU. outstanding is
+	 * updated by both the submitting and the completing thread.
+	 * latency_ns is only written by the completing thread.
+	 */
+	atomic_t		   outstanding;
+	u64			   latency_ns;
 	/**
 	 * @funcs:
 	 *
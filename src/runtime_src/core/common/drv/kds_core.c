@@ -402,15 +402,89 @@ kds_client_set_cu_refs_zero(struct kds_client *client, int domain)
 	return ret;
 }
 
+static inline void
+get_cu_load(struct kds_cu_mgmt *cu_mgmt, u32 policy, int cu_idx,
+	    struct kds_cu_load *load)
+{
+	struct xrt_cu *xcu = cu_mgmt->xcus[cu_idx];
+
+	/* Reading the percpu usage counter is not free, only read what
+	 * the policy needs.
+	 */
+	if (policy == KDS_CU_POLICY_LEAST_USED) {
+		load->usage = cu_stat_read(cu_mgmt, usage[cu_idx]);
+		return;
+	}
+
+	load->outstanding = atomic_read(&xcu->outstanding);
+	load->latency_ns = READ_ONCE(xcu->latency_ns);
+}
+
+/**
+ * select_cu_idx - Pick one of several valid CUs for a command
+ *
+ * The policy of the command's hw context is used if it has one,
+ * otherwise the policy of the device. The context policy is copied to
+ * the command when it is created, the context list cannot be walked
+ * here without the client lock. The latency policy uses the average
+ * execution time of the commands it placed on each CU.
+ *
+ * Outstanding commands and execution time are tracked by the KDS CU
+ * thread. Commands scheduled by ERT do not pass through it, so on the
+ * ERT path the least outstanding and latency policies fall back to
+ * least used.
+ *
+ * Returns: The selected CU index
+ */
+static int
+select_cu_idx(struct kds_cu_mgmt *cu_mgmt, struct kds_command *xcmd,
+	      uint8_t *valid_cus, int num_valid, bool ert)
+{
+	struct kds_cu_load best = {0};
+	struct kds_cu_load load = {0};
+	u32 policy = cu_mgmt->cu_policy;
+	int index;
+	int i;
+
+	if (xcmd->cu_policy != KDS_CU_POLICY_DEFAULT)
+		policy = xcmd->cu_policy;
+	if (policy == KDS_CU_POLICY_DEFAULT)
+		policy = KDS_CU_POLICY_LEAST_USED;
+	if (ert && kds_cu_policy_needs_cu_thread(policy))
+		policy = KDS_CU_POLICY_LEAST_USED;
+
+	/* Concurrent submitters may race on the cursor, which only makes
+	 * the rotation less even.
+	 */
+	if (policy == KDS_CU_POLICY_ROUND_ROBIN)
+		return valid_cus[cu_mgmt->cu_rr++ % num_valid];
+
+	xcmd->cu_latency = (policy == KDS_CU_POLICY_LATENCY);
+
+	index = valid_cus[0];
+	get_cu_load(cu_mgmt, policy, index, &best);
+	for (i = 1; i < num_valid; ++i) {
+		get_cu_load(cu_mgmt, policy, valid_cus[i], &load);
+		if (kds_cu_load_less(policy, &load, &best)) {
+			best = load;
+			index = valid_cus[i];
+		}
+	}
+
+	return index;
+}
+
 /**
  * acquire_cu_idx - Get ready CU index
  *
  * @xcmd: Command
+ * @ert: Command is scheduled by ERT
  *
  * Returns: Negative value for error. 0 or positive value for index
  */
 static int
-acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd)
+acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd,
+	       bool ert)
 {
 	struct kds_client *client = xcmd->client;
 	/* User marked CUs */
@@ -421,8 +495,6 @@ acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd
 	uint8_t valid_cus[MAX_CUS];
 	int num_valid = 0;
 	int8_t index;
-	u64 usage;
-	u64 min_usage;
 	int cu_set;
 	int i;
 
@@ -451,13 +523,7 @@ acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd
 		return -EINVAL;
 	}
 
-	/* Find out the CU with minimum usage */
-	for (i = 1, index = valid_cus[0]; i < num_valid; ++i) {
-		usage = cu_stat_read(cu_mgmt, usage[valid_cus[i]]);
-		min_usage = cu_stat_read(cu_mgmt, usage[index]);
-		if (usage < min_usage)
-			index = valid_cus[i];
-	}
+	index = select_cu_idx(cu_mgmt, xcmd, valid_cus, num_valid, ert);
 
 out:
 	if (xrt_cu_get_protocol(cu_mgmt->xcus[index]) == CTRL_NONE) {
@@ -500,7 +566,7 @@ kds_cu_dispatch(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcm
 	int cu_idx = 0;
 
 	do {
-		cu_idx = acquire_cu_idx(cu_mgmt, domain, xcmd);
+		cu_idx = acquire_cu_idx(cu_mgmt, domain, xcmd, false);
 	} while (cu_idx == -EAGAIN);
 	if (cu_idx < 0)
 		return cu_idx;
@@ -594,7 +660,7 @@ kds_submit_ert(struct kds_sched *kds, struct kds_command *xcmd)
 	case OP_START:
 		/* KDS should select a CU and set it in cu_mask */
 		do {
-			cu_idx = acquire_cu_idx(&kds->cu_mgmt, DOMAIN_PL, xcmd);
+			cu_idx = acquire_cu_idx(&kds->cu_mgmt, DOMAIN_PL, xcmd, true);
 		} while(cu_idx == -EAGAIN);
 		if (cu_idx < 0)
 			return cu_idx;
@@ -362,6 +362,50 @@ kds_get_hw_ctx_by_id(struct kds_client *client, uint32_t hw_ctx_id)
         return NULL;
 }
 
+/**
+ * kds_set_hw_ctx_cu_policy - Select how KDS picks a CU for commands of a
+ *                            hw context that may run on several CUs
+ *
+ * @hw_ctx: Hardware context
+ * @policy: One of enum kds_cu_policy
+ *
+ * Returns: 0 on success, -EINVAL for an unknown policy
+ */
+int kds_set_hw_ctx_cu_policy(struct kds_client_hw_ctx *hw_ctx, u32 policy)
+{
+	if (policy >= KDS_CU_POLICY_MAX)
+		return -EINVAL;
+
+	hw_ctx->cu_policy = policy;
+	return 0;
+}
+
+/**
+ * kds_get_hw_ctx_cu_policy - Get the CU selection policy of a hw context
+ *
+ * @client: KDS client
+ * @hw_ctx_id: Hardware context id
+ *
+ * The hw context list is only stable under the client lock, which the
+ * submission path does not hold. Commands therefore carry a copy of
+ * the policy resolved when they are created.
+ *
+ * Returns: The policy, KDS_CU_POLICY_DEFAULT if the context is not found
+ */
+u32 kds_get_hw_ctx_cu_policy(struct kds_client *client, uint32_t hw_ctx_id)
+{
+	struct kds_client_hw_ctx *hw_ctx = NULL;
+	u32 policy = KDS_CU_POLICY_DEFAULT;
+
+	mutex_lock(&client->lock);
+	hw_ctx = kds_get_hw_ctx_by_id(client, hw_ctx_id);
+	if (hw_ctx)
+		policy = hw_ctx->cu_policy;
+	mutex_unlock(&client->lock);
+
+	return policy;
+}
+
 struct kds_client_hw_ctx *
 kds_alloc_hw_ctx(struct kds_client *client, uuid_t *xclbin_id, uint32_t slot_id)
 {
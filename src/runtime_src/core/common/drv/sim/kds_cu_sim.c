@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-2.0 OR Apache-2.0
+/*
+ * Xilinx Kernel Driver Scheduler - CU selection simulator
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * This file is dual-licensed; you may select either the GNU General Public
+ * License version 2 or Apache License, Version 2.0.
+ */
+
+/* User space model of the KDS CU selection with mock CUs.
+ *
+ * Commands arrive at random times and may run on any of the CUs. KDS
+ * picks a CU with the same code as the driver (kds_cu_policy.h), the
+ * command is queued on the CU, and the CU runs its queue in order. The
+ * reported latency of a command is the time from submission to
+ * completion. The CU latency used by the latency policy is the time
+ * from start to completion, as tracked in xrt_cu.c.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "kds_cu_policy.h"
+
+#define MAX_SIM_CUS	128
+
+struct mock_cu {
+	double		 speed;		/* work units per ns */
+	double		 busy_until;	/* ns */
+	/* Completion times of the commands queued on the CU, in order */
+	double		*done;
+	double		*started;
+	u32		 head;
+	u32		 tail;
+	u64		 usage;
+	u64		 latency_ns;
+	double		 busy_ns;
+};
+
+struct sim_config {
+	int		 num_cus;
+	int		 num_cmds;
+	double		 load;		/* offered load, 0 to 1 */
+	double		 short_ns;
+	double		 long_ns;
+	double		 long_ratio;
+	double		 slow_speed;	/* speed of the last CU */
+	u64		 seed;
+};
+
+static u64 rng_state;
+
+static double rng_uniform(void)
+{
+	/* xorshift64* */
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return (double)((rng_state * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Complete the commands that finished by time now */
+static void retire(struct mock_cu *cu, double now)
+{
+	while (cu->head != cu->tail && cu->done[cu->head] <= now) {
+		u64 latency = (u64)(cu->done[cu->head] - cu->started[cu->head]);
+
+		cu->latency_ns = kds_cu_ewma_update(cu->latency_ns, latency);
+		++cu->head;
+	}
+}
+
+static void get_load(struct mock_cu *cu, struct kds_cu_load *load)
+{
+	load->usage = cu->usage;
+	load->outstanding = cu->tail - cu->head;
+	load->latency_ns = cu->latency_ns;
+}
+
+/* Same selection as select_cu_idx() in kds_core.c */
+static int select_cu(struct mock_cu *cus, int num_cus, u32 policy, u32 *rr)
+{
+	struct kds_cu_load best;
+	struct kds_cu_load load;
+	int index = 0;
+	int i;
+
+	if (policy == KDS_CU_POLICY_ROUND_ROBIN)
+		return (*rr)++ % num_cus;
+
+	get_load(&cus[0], &best);
+	for (i = 1; i < num_cus; ++i) {
+		get_load(&cus[i], &load);
+		if (kds_cu_load_less(policy, &load, &best)) {
+			best = load;
+			index = i;
+		}
+	}
+	return index;
+}
+
+static void run(const struct sim_config *cfg, u32 policy)
+{
+	struct mock_cu cus[MAX_SIM_CUS];
+	double *latency;
+	double capacity = 0;
+	double mean_work;
+	double interval;
+	double now = 0;
+	double total = 0;
+	double busiest = 0;
+	double idlest = -1;
+	u32 rr = 0;
+	int i, n;
+
+	memset(cus, 0, sizeof(cus));
+	for (i = 0; i < cfg->num_cus; ++i) {
+		cus[i].speed = (i == cfg->num_cus - 1) ? cfg->slow_speed : 1.0;
+		cus[i].done = calloc(cfg->num_cmds, sizeof(double));
+		cus[i].started = calloc(cfg->num_cmds, sizeof(double));
+		capacity += cus[i].speed;
+	}
+	latency = calloc(cfg->num_cmds, sizeof(double));
+
+	/* Arrival rate that makes the CUs busy for load of the time */
+	mean_work = cfg->long_ratio * cfg->long_ns +
+		    (1 - cfg->long_ratio) * cfg->short_ns;
+	interval = mean_work / (capacity * cfg->load);
+
+	rng_state = cfg->seed;
+	for (n = 0; n < cfg->num_cmds; ++n) {
+		double work = (rng_uniform() < cfg->long_ratio) ?
+			      cfg->long_ns : cfg->short_ns;
+		struct mock_cu *cu;
+		double start;
+
+		now += -log(1.0 - rng_uniform()) * interval;
+		for (i = 0; i < cfg->num_cus; ++i)
+			retire(&cus[i], now);
+
+		cu = &cus[select_cu(cus, cfg->num_cus, policy, &rr)];
+		start = (cu->busy_until > now) ? cu->busy_until : now;
+		cu->busy_until = start + work / cu->speed;
+		cu->busy_ns += work / cu->speed;
+		cu->started[cu->tail] = start;
+		cu->done[cu->tail] = cu->busy_until;
+		++cu->tail;
+		++cu->usage;
+
+		latency[n] = cu->busy_until - now;
+		total += latency[n];
+	}
+
+	for (i = 0; i < cfg->num_cus; ++i) {
+		double util = cus[i].busy_ns / cus[i].busy_until;
+
+		if (cus[i].busy_until == 0)
+			util = 0;
+		if (util > busiest)
+			busiest = util;
+		if (idlest < 0 || util < idlest)
+			idlest = util;
+	}
+
+	qsort(latency, cfg->num_cmds, sizeof(double), cmp_double);
+	printf("%-18s %10.1f %10.1f %10.1f %10.1f %9.0f%% %9.0f%%\n",
+	       kds_cu_policy2str(policy),
+	       total / cfg->num_cmds / 1000,
+	       latency[cfg->num_cmds / 2] / 1000,
+	       latency[(int)(cfg->num_cmds * 0.99)] / 1000,
+	       latency[cfg->num_cmds - 1] / 1000,
+	       busiest * 100, idlest * 100);
+
+	for (i = 0; i < cfg->num_cus; ++i) {
+		free(cus[i].done);
+		free(cus[i].started);
+	}
+	free(latency);
+}
+
+static void usage(const char *prog)
+{
+	printf("Usage: %s [options]\n", prog);
+	printf("  -c <num>   number of CUs (default 4)\n");
+	printf("  -n <num>   number of commands (default 200000)\n");
+	printf("  -l <load>  offered load between 0 and 1 (default 0.8)\n");
+	printf("  -s <ns>    duration of short commands (default 10000)\n");
+	printf("  -L <ns>    duration of long commands (default 200000)\n");
+	printf("  -r <ratio> ratio of long commands (default 0.1)\n");
+	printf("  -S <speed> relative speed of the last CU (default 1.0)\n");
+	printf("  -x <seed>  random seed\n");
+	printf("  -h         this help\n");
+}
+
+int main(int argc, char *argv[])
+{
+	struct sim_config cfg = {
+		.num_cus = 4,
+		.num_cmds = 200000,
+		.load = 0.8,
+		.short_ns = 10000,
+		.long_ns = 200000,
+		.long_ratio = 0.1,
+		.slow_speed = 1.0,
+		.seed = 0x2545F4914F6CDD1DULL,
+	};
+	u32 policy;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "c:n:l:s:L:r:S:x:h")) != -1) {
+		switch (opt) {
+		case 'c': cfg.num_cus = atoi(optarg); break;
+		case 'n': cfg.num_cmds = atoi(optarg); break;
+		case 'l': cfg.load = atof(optarg); break;
+		case 's': cfg.short_ns = atof(optarg); break;
+		case 'L': cfg.long_ns = atof(optarg); break;
+		case 'r': cfg.long_ratio = atof(optarg); break;
+		case 'S': cfg.slow_speed = atof(optarg); break;
+		case 'x': cfg.seed = strtoull(optarg, NULL, 0); break;
+		case 'h': usage(argv[0]); return 0;
+		default: usage(argv[0]); return 1;
+		}
+	}
+
+	if (cfg.num_cus < 1 || cfg.num_cus > MAX_SIM_CUS || cfg.num_cmds < 1 ||
+	    cfg.load <= 0 || cfg.load >= 1 || cfg.slow_speed <= 0 || !cfg.seed) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	printf("%d CUs, %d commands, load %.2f, %.0f%% of commands %.0fus, "
+	       "others %.0fus, last CU speed %.2f\n\n",
+	       cfg.num_cus, cfg.num_cmds, cfg.load, cfg.long_ratio * 100,
+	       cfg.long_ns / 1000, cfg.short_ns / 1000, cfg.slow_speed);
+	printf("%-18s %10s %10s %10s %10s %10s %10s\n", "policy",
+	       "mean(us)", "p50(us)", "p99(us)", "max(us)", "max util", "min util");
+
+	for (policy = KDS_CU_POLICY_LEAST_USED; policy < KDS_CU_POLICY_MAX; ++policy)
+		run(&cfg, policy);
+
+	return 0;
+}
@@ -245,6 +245,18 @@ static inline void xrt_cu_idle_end(struct xrt_cu *xcu)
 	}
 	spin_unlock_irqrestore(&xcu->stats.xcs_lock, flags);
 }
+static inline void xrt_cu_update_load(struct xrt_cu *xcu, struct kds_command *xcmd)
+{
+	u64 latency;
+
+	atomic_dec(&xcu->outstanding);
+	if (!xcmd->cu_latency || !xcmd->start)
+		return;
+
+	latency = ktime_to_ns(ktime_get()) - xcmd->start;
+	WRITE_ONCE(xcu->latency_ns, kds_cu_ewma_update(xcu->latency_ns, latency));
+}
+
 /**
  * process_cq() - Process completed queue
  * @xcu: Target XRT CU
@@ -265,6 +277,7 @@ static inline void process_cq(struct xrt_cu *xcu)
 	while (xcu->num_cq) {
 		xcmd = list_first_entry(&xcu->cq, struct kds_command, list);
 		set_xcmd_timestamp(xcmd, xcmd->status);
+		xrt_cu_update_load(xcu, xcmd);
 		xrt_cu_circ_produce(xcu, CU_LOG_STAGE_CQ, (uintptr_t)xcmd);
 		xcu->bad_state = (xcmd->status == KDS_SKCRASHED);
 		xcmd->cb.notify_host(xcmd, xcmd->status);
@@ -414,6 +427,9 @@ static inline int process_rq(struct xrt_cu *xcu)
 	 * specific thread if needed.
 	 */
 	//xcmd->start = ktime_get_raw_fast_ns();
+	/* Only pay for it if the CU was selected by its latency */
+	if (xcmd->cu_latency)
+		xcmd->start = ktime_to_ns(ktime_get());
 	move_to_queue(xcmd, dst_q, dst_len);
 	--xcu->num_rq;
 	if (xcu->stats.max_sq_length < xcu->num_sq)
@@ -649,6 +665,8 @@ void xrt_cu_submit(struct xrt_cu *xcu, struct kds_command *xcmd)
 	unsigned long flags;
 	bool first_command = false;
 
+	atomic_inc(&xcu->outstanding);
+
 	/* Add command to pending queue
 	 * wakeup CU thread if it is the first command
 	 */
@@ -930,6 +948,8 @@ int xrt_cu_init(struct xrt_cu *xcu)
 	sema_init(&xcu->sem, 0);
 	sema_init(&xcu->sem_cu, 0);
 	spin_lock_init(&xcu->stats.xcs_lock);
+	atomic_set(&xcu->outstanding, 0);
+	xcu->latency_ns = 0;
 
 	INIT_LIST_HEAD(&xcu->hpq);
 	spin_lock_init(&xcu->hpq_lock);
@@ -11,6 +11,7 @@
 #include "xrt/xrt_hw_context.h"
 
 #include <memory>
+#include <vector>
 
 namespace xrt_core {
 
@@ -91,6 +92,22 @@ public:
   // hardware queues
   virtual void
   exec_buf(buffer_handle* cmd) = 0;
+
+  // Execution of a list of command objects as one unit when the shim
+  // does not support hardware queues.  Shims that support chained
+  // execution should override this function to submit the list with
+  // a single call to the driver.  Default implementation executes the
+  // commands one by one.
+  //
+  // The pcie shim submits the list with one ioctl when the driver
+  // supports it.  The edge shim uses the default, one ioctl per
+  // command.
+  virtual void
+  exec_buf(const std::vector<buffer_handle*>& cmds)
+  {
+    for (auto cmd : cmds)
+      exec_buf(cmd);
+  }
 };
 
 } // xrt_core
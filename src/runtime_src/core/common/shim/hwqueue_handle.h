@@ -28,6 +28,19 @@ public:
   virtual void
   submit_command(buffer_handle* cmd) = 0;
 
+  // Submit list of commands for execution as one unit.  The commands
+  // are executed in list order.  Shims that support chained execution
+  // should override this function to submit the list with a single
+  // call to the driver.  Default implementation submits commands one
+  // by one, so a list costs one driver call per command unless the
+  // shim overrides this function.
+  virtual void
+  submit_command(const std::vector<buffer_handle*>& cmds)
+  {
+    for (auto cmd : cmds)
+      submit_command(cmd);
+  }
+
   // Wait for command completion.
   //
   // @cmd        Handle to command to wait for
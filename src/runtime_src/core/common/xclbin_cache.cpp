@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "xclbin_cache.h"
+
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+#include "core/common/utils.h"
+#include "core/common/detail/mapped_file.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+namespace sfs = std::filesystem;
+using metadata = xrt_core::xclbin::metadata;
+using kernel_argument = xrt_core::xclbin::kernel_argument;
+using kernel_properties = xrt_core::xclbin::kernel_properties;
+
+// Cache file header.  The version must be incremented when the layout
+// of the serialized meta data changes, including changes to the meta
+// data structs in xclbin_parser.h.
+struct header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t xml_size;
+  uint64_t xml_hash;
+};
+
+constexpr char cache_magic[8] = {'X','R','T','X','C','L','M','D'};
+constexpr uint32_t cache_version = 1;
+
+// FNV-1a hash of XML, used to validate cache files
+static uint64_t
+hash(const char* data, size_t size)
+{
+  uint64_t h = 0xcbf29ce484222325ULL; // NOLINT
+  for (size_t i = 0; i < size; ++i) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 0x100000001b3ULL; // NOLINT
+  }
+  return h;
+}
+
+static sfs::path
+cache_dir()
+{
+  auto dir = xrt_core::config::get_xclbin_metadata_cache_dir();
+  if (!dir.empty())
+    return dir;
+
+#ifdef _WIN32
+  if (auto local = std::getenv("LOCALAPPDATA"))
+    return sfs::path(local) / "xrt" / "xclbin";
+#else
+  if (auto xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+    return sfs::path(xdg) / "xrt" / "xclbin";
+  if (auto home = std::getenv("HOME"))
+    return sfs::path(home) / ".cache" / "xrt" / "xclbin";
+#endif
+
+  return {};
+}
+
+// class writer - serialize meta data into a byte buffer
+class writer
+{
+  std::string m_buf;
+
+public:
+  explicit
+  writer(const header& hdr)
+  {
+    m_buf.append(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  }
+
+  void
+  put(uint64_t value)
+  {
+    m_buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void
+  put(const std::string& str)
+  {
+    put(str.size());
+    m_buf.append(str);
+  }
+
+  void
+  put(const kernel_properties& props)
+  {
+    put(props.name);
+    put(static_cast<uint64_t>(props.type));
+    put(props.counted_auto_restart);
+    put(static_cast<uint64_t>(props.mailbox));
+    put(props.address_range);
+    put(props.sw_reset);
+    put(props.functional);
+    put(props.kernel_id);
+    put(props.workgroupsize);
+    for (auto value : props.compileworkgroupsize)
+      put(value);
+    for (auto value : props.maxworkgroupsize)
+      put(value);
+    put(props.stringtable.size());
+    for (const auto& [id, str] : props.stringtable) {
+      put(id);
+      put(str);
+    }
+  }
+
+  void
+  put(const kernel_argument& arg)
+  {
+    put(arg.name);
+    put(arg.hosttype);
+    put(arg.port);
+    put(arg.port_width);
+    put(arg.index);
+    put(arg.offset);
+    put(arg.size);
+    put(arg.hostsize);
+    put(arg.fa_desc_offset);
+    put(static_cast<uint64_t>(arg.type));
+    put(static_cast<uint64_t>(arg.dir));
+  }
+
+  void
+  put(const metadata& md)
+  {
+    put(md.project_name);
+    put(md.fpga_device_name);
+    put(md.kernels.size());
+    for (const auto& kernel : md.kernels) {
+      put(kernel.properties);
+      put(kernel.args.size());
+      for (const auto& arg : kernel.args)
+        put(arg);
+    }
+  }
+
+  const std::string&
+  data() const
+  {
+    return m_buf;
+  }
+};
+
+// class reader - deserialize meta data from a mapped cache file
+//
+// Throws if the data is truncated
+class reader
+{
+  const char* m_data;
+  size_t m_size;
+  size_t m_pos = 0;
+
+  const char*
+  advance(size_t bytes)
+  {
+    if (bytes > m_size - m_pos)
+      throw std::runtime_error("truncated xclbin cache file");
+    auto data = m_data + m_pos;
+    m_pos += bytes;
+    return data;
+  }
+
+public:
+  reader(const char* data, size_t size)
+    : m_data(data), m_size(size)
+  {}
+
+  template <typename T>
+  T
+  get()
+  {
+    uint64_t value = 0;
+    std::memcpy(&value, advance(sizeof(value)), sizeof(value));
+    return static_cast<T>(value);
+  }
+
+  std::string
+  get_string()
+  {
+    auto size = get<size_t>();
+    auto data = advance(size);
+    return {data, size};
+  }
+
+  kernel_properties
+  get_properties()
+  {
+    kernel_properties props;
+    props.name = get_string();
+    props.type = get<kernel_properties::kernel_type>();
+    props.counted_auto_restart = get<kernel_properties::restart_type>();
+    props.mailbox = get<kernel_properties::mailbox_type>();
+    props.address_range = get<size_t>();
+    props.sw_reset = get<bool>();
+    props.functional = get<size_t>();
+    props.kernel_id = get<size_t>();
+    props.workgroupsize = get<size_t>();
+    for (auto& value : props.compileworkgroupsize)
+      value = get<size_t>();
+    for (auto& value : props.maxworkgroupsize)
+      value = get<size_t>();
+    auto count = get<size_t>();
+    for (size_t idx = 0; idx < count; ++idx) {
+      auto id = get<uint32_t>();
+      props.stringtable.emplace(id, get_string());
+    }
+    return props;
+  }
+
+  kernel_argument
+  get_argument()
+  {
+    kernel_argument arg;
+    arg.name = get_string();
+    arg.hosttype = get_string();
+    arg.port = get_string();
+    arg.port_width = get<size_t>();
+    arg.index = get<size_t>();
+    arg.offset = get<size_t>();
+    arg.size = get<size_t>();
+    arg.hostsize = get<size_t>();
+    arg.fa_desc_offset = get<size_t>();
+    arg.type = get<kernel_argument::argtype>();
+    arg.dir = get<kernel_argument::direction>();
+    return arg;
+  }
+
+  metadata
+  get_metadata()
+  {
+    metadata md;
+    md.project_name = get_string();
+    md.fpga_device_name = get_string();
+    auto kcount = get<size_t>();
+    md.kernels.reserve(kcount);
+    for (size_t kidx = 0; kidx < kcount; ++kidx) {
+      metadata::kernel kernel;
+      kernel.properties = get_properties();
+      auto acount = get<size_t>();
+      kernel.args.reserve(acount);
+      for (size_t aidx = 0; aidx < acount; ++aidx)
+        kernel.args.push_back(get_argument());
+      md.kernels.push_back(std::move(kernel));
+    }
+    return md;
+  }
+};
+
+static header
+make_header(const char* xml_data, size_t xml_size)
+{
+  header hdr {};
+  std::memcpy(hdr.magic, cache_magic, sizeof(hdr.magic));
+  hdr.version = cache_version;
+  hdr.xml_size = xml_size;
+  hdr.xml_hash = hash(xml_data, xml_size);
+  return hdr;
+}
+
+// Load meta data from cache file, returns false if the file
+// does not exist or does not match the xclbin XML
+static bool
+load(const sfs::path& path, const header& expected, metadata& md)
+{
+  std::error_code ec;
+  if (!sfs::exists(path, ec))
+    return false;
+
+  xrt_core::detail::mapped_file file(path.string());
+  if (file.size() < sizeof(header))
+    return false;
+
+  header hdr;
+  std::memcpy(&hdr, file.data(), sizeof(hdr));
+  if (std::memcmp(hdr.magic, expected.magic, sizeof(hdr.magic)) != 0
+      || hdr.version != expected.version
+      || hdr.xml_size != expected.xml_size
+      || hdr.xml_hash != expected.xml_hash)
+    return false;
+
+  reader rd(file.data() + sizeof(header), file.size() - sizeof(header));
+  md = rd.get_metadata();
+  return true;
+}
+
+// Store meta data in cache file.  The file is written under a
+// temporary name and renamed so that concurrent processes never
+// see a partially written file.
+static void
+store(const sfs::path& path, const header& hdr, const metadata& md)
+{
+  writer wr(hdr);
+  wr.put(md);
+
+  sfs::create_directories(path.parent_path());
+  auto tmp = path;
+  tmp += "." + std::to_string(xrt_core::utils::get_pid()) + ".tmp";
+  {
+    std::ofstream ostr(tmp, std::ios::binary | std::ios::trunc);
+    ostr.write(wr.data().data(), wr.data().size());
+    if (!ostr)
+      throw std::runtime_error("failed to write '" + tmp.string() + "'");
+  }
+  sfs::rename(tmp, path);
+}
+
+static void
+debug(const std::string& msg)
+{
+  xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT", "xclbin cache: " + msg);
+}
+
+} // namespace
+
+namespace xrt_core::xclbin_cache {
+
+xrt_core::xclbin::metadata
+get_metadata(const xrt_core::uuid& uuid, const char* xml_data, size_t xml_size)
+{
+  auto apply_ini = [](metadata&& md) {
+    for (auto& kernel : md.kernels)
+      xrt_core::xclbin::apply_ini_properties(kernel.properties);
+    return std::move(md);
+  };
+
+  if (!xrt_core::config::get_xclbin_metadata_cache())
+    return apply_ini(xrt_core::xclbin::get_metadata(xml_data, xml_size));
+
+  auto dir = cache_dir();
+  if (dir.empty())
+    return apply_ini(xrt_core::xclbin::get_metadata(xml_data, xml_size));
+
+  auto path = dir / (uuid.to_string() + ".bin");
+  auto hdr = make_header(xml_data, xml_size);
+
+  metadata md;
+  try {
+    if (load(path, hdr, md)) {
+      debug("loaded '" + path.string() + "'");
+      return apply_ini(std::move(md));
+    }
+  }
+  catch (const std::exception& ex) {
+    debug("ignoring '" + path.string() + "': " + ex.what());
+  }
+
+  md = xrt_core::xclbin::get_metadata(xml_data, xml_size);
+
+  try {
+    store(path, hdr, md);
+    debug("stored '" + path.string() + "'");
+  }
+  catch (const std::exception& ex) {
+    debug("failed to store '" + path.string() + "': " + ex.what());
+  }
+
+  return apply_ini(std::move(md));
+}
+
+} // xrt_core::xclbin_cache
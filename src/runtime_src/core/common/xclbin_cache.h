@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrt_core_common_xclbin_cache_h_
+#define xrt_core_common_xclbin_cache_h_
+
+#include "core/common/config.h"
+#include "core/common/uuid.h"
+#include "core/common/xclbin_parser.h"
+
+// Cross process cache of xclbin meta data
+//
+// Parsing the EMBEDDED_METADATA XML of an xclbin is expensive and is
+// repeated by every process that uses the xclbin.  When enabled in
+// xrt.ini (Runtime.xclbin_metadata_cache=true), the parsed kernel
+// meta data is stored in a compact binary file keyed by the xclbin
+// uuid.  Subsequent processes map the file and skip XML parsing.
+//
+// The cache directory is Runtime.xclbin_metadata_cache_dir if set,
+// otherwise $XDG_CACHE_HOME/xrt/xclbin or $HOME/.cache/xrt/xclbin on
+// Linux and %LOCALAPPDATA%\xrt\xclbin on Windows.
+//
+// Cache files are validated against the size and hash of the XML, a
+// stale or corrupt file is ignored and replaced.  Failure to read or
+// write the cache is never an error, the meta data is then parsed
+// from the XML.
+namespace xrt_core::xclbin_cache {
+
+// get_metadata() - Get kernel meta data of an xclbin
+//
+// @uuid:     uuid of the xclbin
+// @xml_data: EMBEDDED_METADATA section of the xclbin
+// @xml_size: size of EMBEDDED_METADATA section
+// Return:    meta data with xrt.ini overrides applied
+//
+// Looks up the meta data in the cache if enabled, otherwise parses
+// the XML and adds the result to the cache.
+XRT_CORE_COMMON_EXPORT
+xrt_core::xclbin::metadata
+get_metadata(const xrt_core::uuid& uuid, const char* xml_data, size_t xml_size);
+
+} // xrt_core::xclbin_cache
+
+#endif
@@ -387,6 +387,71 @@ merge_args(std::vector<xrt_core::xclbin::kernel_argument>& args)
       throw std::runtime_error("xclbin parser internal error: mismatched argument index");
 }
 
+// Kernel argument meta data from kernel xml entry
+static std::vector<xrt_core::xclbin::kernel_argument>
+parse_kernel_arguments(const pt::ptree& xml_kernel)
+{
+  using kernel_argument = xrt_core::xclbin::kernel_argument;
+  std::vector<kernel_argument> args;
+
+  auto pwmap = get_portname_width_map(xml_kernel);
+
+  for (auto& xml_arg : xml_kernel) {
+    if (xml_arg.first != "arg")
+      continue;
+
+    std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
+    size_t index = id.empty() ? kernel_argument::no_index : convert(id);
+
+    std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
+    auto itr = pwmap.find(port);
+    size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
+
+    args.emplace_back(kernel_argument{
+        xml_arg.second.get<std::string>("<xmlattr>.name")
+       ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
+       ,port
+       ,pwidth
+       ,index
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
+       ,0  // fa_desc_offset post computed if necessary
+       ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
+       ,kernel_argument::direction(kernel_argument::direction::input)
+    });
+  }
+
+  // stable sort to preserve order of multi-component arguments
+  // for example global_size, local_size, etc.
+  std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+
+  // merge args with same index
+  merge_args(args);
+
+  return args;
+}
+
+// Kernel properties from kernel xml entry.  The properties do not
+// include xrt.ini overrides, see apply_ini_properties()
+static xrt_core::xclbin::kernel_properties
+parse_kernel_properties(const pt::ptree& xml_kernel, const std::string& kname)
+{
+  return xrt_core::xclbin::kernel_properties
+    { kname
+    , to_kernel_type(xml_kernel.get<std::string>("<xmlattr>.type", "pl"))
+    , convert(xml_kernel.get<std::string>("<xmlattr>.countedAutoRestart", "0"))
+    , convert_to_mailbox_type(xml_kernel.get<std::string>("<xmlattr>.mailbox", "none"))
+    , get_address_range(xml_kernel)
+    , to_bool(xml_kernel.get<std::string>("<xmlattr>.swReset", "false"))
+    , get_functional(xml_kernel, "extended-data")
+    , get_kernel_id(xml_kernel, "extended-data")
+
+    , convert(xml_kernel.get<std::string>("<xmlattr>.workGroupSize", "0"))
+    , get_xyz(xml_kernel, "compileWorkGroupSize")
+    , get_xyz(xml_kernel, "maxWorkGroupSize")
+    , get_stringtable(xml_kernel) };
+}
 
 } // namespace
 
@@ -928,8 +993,6 @@ get_kernel_freq(const axlf* top)
 std::vector<kernel_argument>
 get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  std::vector<kernel_argument> args;
-
   pt::ptree xml_project;
   std::stringstream xml_stream;
   xml_stream.write(xml_data,xml_size);
@@ -941,44 +1004,9 @@ get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& k
     if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
       continue;
 
-    auto pwmap = get_portname_width_map(xml_kernel.second);
-
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
-      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
-
-      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
-      auto itr = pwmap.find(port);
-      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
-
-      args.emplace_back(kernel_argument{
-          xml_arg.second.get<std::string>("<xmlattr>.name")
-         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
-         ,port
-         ,pwidth
-         ,index
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
-         ,0  // fa_desc_offset post computed if necessary
-         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
-         ,kernel_argument::direction(kernel_argument::direction::input)
-      });
-    }
-
-    // stable sort to preserve order of multi-component arguments
-    // for example global_size, local_size, etc.
-    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
-
-    // merge args with same index
-    merge_args(args);
-
-    break;
+    return parse_kernel_arguments(xml_kernel.second);
   }
-  return args;
+  return {};
 }
 
 std::vector<kernel_argument>
@@ -1002,35 +1030,9 @@ get_kernel_properties(const char* xml_data, size_t xml_size, const std::string&
     if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
       continue;
 
-    // Determine features
-    auto mailbox = convert_to_mailbox_type(xml_kernel.second.get<std::string>("<xmlattr>.mailbox", "none"));
-    if (mailbox == kernel_properties::mailbox_type::none)
-      mailbox = get_mailbox_from_ini(kname);
-    auto restart = convert(xml_kernel.second.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
-    if (restart == 0)
-      restart = get_restart_from_ini(kname);
-    auto sw_reset = to_bool(xml_kernel.second.get<std::string>("<xmlattr>.swReset", "false"));
-    if (!sw_reset)
-      sw_reset = get_sw_reset_from_ini(kname);
-
-    auto functional = get_functional(xml_kernel.second, "extended-data");
-    auto kernel_id = get_kernel_id(xml_kernel.second, "extended-data");
-
-    return kernel_properties
-      { kname
-      , to_kernel_type(xml_kernel.second.get<std::string>("<xmlattr>.type", "pl"))
-      , restart
-      , mailbox
-      , get_address_range(xml_kernel.second)
-      , sw_reset
-      , functional
-      , kernel_id
-
-      , convert(xml_kernel.second.get<std::string>("<xmlattr>.workGroupSize", "0"))
-      , get_xyz(xml_kernel.second, "compileWorkGroupSize")
-      , get_xyz(xml_kernel.second, "maxWorkGroupSize")
-      , get_stringtable(xml_kernel.second) };
-
+    auto props = parse_kernel_properties(xml_kernel.second, kname);
+    apply_ini_properties(props);
+    return props;
   }
 
   return kernel_properties{};
@@ -1043,6 +1045,48 @@ get_kernel_properties(const axlf* top, const std::string& kname)
   return get_kernel_properties(xml.first, xml.second, kname);
 }
 
+void
+apply_ini_properties(kernel_properties& props)
+{
+  // Determine features
+  if (props.mailbox == kernel_properties::mailbox_type::none)
+    props.mailbox = get_mailbox_from_ini(props.name);
+  if (props.counted_auto_restart == 0)
+    props.counted_auto_restart = get_restart_from_ini(props.name);
+  if (!props.sw_reset)
+    props.sw_reset = get_sw_reset_from_ini(props.name);
+}
+
+metadata
+get_metadata(const char* xml_data, size_t xml_size)
+{
+  pt::ptree xml_project;
+  std::stringstream xml_stream;
+  xml_stream.write(xml_data,xml_size);
+  pt::read_xml(xml_stream,xml_project);
+
+  metadata md;
+  md.project_name = xml_project.get<std::string>("project.<xmlattr>.name","");
+  md.fpga_device_name = xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
+
+  auto xml_core = xml_project.get_child_optional("project.platform.device.core");
+  if (!xml_core)
+    return md;
+
+  for (auto& xml_kernel : *xml_core) {
+    if (xml_kernel.first != "kernel")
+      continue;
+
+    auto kname = xml_kernel.second.get<std::string>("<xmlattr>.name");
+    md.kernels.emplace_back(metadata::kernel{
+        parse_kernel_properties(xml_kernel.second, kname)
+       ,parse_kernel_arguments(xml_kernel.second)
+    });
+  }
+
+  return md;
+}
+
 std::vector<std::string>
 get_kernel_names(const char *xml_data, size_t xml_size)
 {
@@ -73,6 +73,24 @@ struct kernel_properties
   std::map<uint32_t, std::string> stringtable;
 };
 
+// struct metadata - kernel meta data extracted from xclbin XML
+//
+// Result of a single pass over the EMBEDDED_METADATA section.  The
+// kernel properties reflect the XML only, xrt.ini overrides are
+// applied separately with apply_ini_properties().
+struct metadata
+{
+  struct kernel
+  {
+    kernel_properties properties;
+    std::vector<kernel_argument> args;
+  };
+
+  std::string project_name;
+  std::string fpga_device_name;
+  std::vector<kernel> kernels;
+};
+
 struct kernel_object
 {
   std::string name;
@@ -372,6 +390,26 @@ XRT_CORE_COMMON_EXPORT
 kernel_properties
 get_kernel_properties(const axlf* top, const std::string& kname);
 
+/**
+ * get_metadata() - Get meta data for all kernels in one pass
+ *
+ * @xml_data: XML metadata from xclbin
+ * @xml_size: Size of XML metadata from xclbin
+ * Return: Kernel properties and arguments without xrt.ini overrides
+ */
+XRT_CORE_COMMON_EXPORT
+metadata
+get_metadata(const char* xml_data, size_t xml_size);
+
+/**
+ * apply_ini_properties() - Apply xrt.ini overrides to kernel properties
+ *
+ * @props: Kernel properties extracted from XML meta data
+ */
+XRT_CORE_COMMON_EXPORT
+void
+apply_ini_properties(kernel_properties& props);
+
 /**
  * get_kernels() - Get meta data for all kernels
  *
@@ -5,11 +5,15 @@
 #define XRT_QUEUE_H_
 
 #include "xrt/detail/config.h"
+#include "experimental/xrt_fence.h"
 
 #ifdef __cplusplus
 # include <algorithm>
+# include <chrono>
 # include <future>
 # include <memory>
+# include <mutex>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -21,8 +25,11 @@ namespace xrt {
  *
  * Used for sequencing operations in order of enqueuing.
  *
- * A queue has exactly one consumer which is a separate thread created
- * when the queue is constructed.
+ * By default a queue has exactly one consumer which is a separate
+ * thread created when the queue is constructed.  A queue can be
+ * constructed with a pool of consumers, in which case tasks enqueued
+ * with explicit dependencies can execute concurrently with other
+ * tasks.
  *
  * When an opeation is enqueued on the queue an event is returned to
  * the caller.  This event can be enqueued in a different queue, which
@@ -114,6 +121,7 @@ public:
     {
       virtual ~event_iholder() {};
       virtual void wait() const = 0;
+      virtual bool ready() const = 0;
     };
 
     // Wrap typed future
@@ -130,6 +138,43 @@ public:
       {
         m_held.wait();
       }
+
+      bool ready() const
+      {
+        return m_held.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      }
+    };
+
+    // Wrap fence.  A fence cannot be polled without consuming the
+    // signal, so it is never ready until waited on.  Waiting on the
+    // fence consumes its signal, the signalled state is latched so
+    // that the event can be waited on any number of times, e.g. when
+    // it is a dependency of several tasks.
+    struct fence_holder : public event_iholder
+    {
+      mutable xrt::fence m_held;
+      mutable std::mutex m_mutex;
+      mutable bool m_signalled = false;
+
+      fence_holder(const xrt::fence& f)
+        : m_held(f)
+      {}
+
+      void wait() const
+      {
+        std::lock_guard lk(m_mutex);
+        if (!m_signalled) {
+          m_held.wait(std::chrono::milliseconds(0));
+          m_signalled = true;
+        }
+      }
+
+      bool ready() const
+      {
+        // Don't block if another thread is waiting for the fence
+        std::unique_lock lk(m_mutex, std::try_to_lock);
+        return lk.owns_lock() && m_signalled;
+      }
     };
 
     std::shared_ptr<event_iholder> m_content;
@@ -147,6 +192,13 @@ public:
       : m_content(std::make_shared<event_holder<ValueType>>(std::move(e)))
     {}
 
+    // event() - event constructor for xrt::fence
+    //
+    // @f : fence to wait for, the fence is copied
+    event(const xrt::fence& f)
+      : m_content(std::make_shared<fence_holder>(f))
+    {}
+
     event&
     operator=(event&& rhs) = default;
 
@@ -161,6 +213,16 @@ public:
       if (m_content)
         m_content->wait();
     }
+
+    // ready() - check without blocking if event is complete
+    //
+    // Returns false if completion cannot be determined without
+    // waiting.
+    bool
+    ready() const
+    {
+      return !m_content || m_content->ready();
+    }
   };
 
 private:
@@ -169,6 +231,11 @@ private:
   void
   add_task(task&& ev);
 
+  // Add task that executes when dependencies are ready
+  XRT_API_EXPORT
+  void
+  add_task(task&& ev, std::vector<event>&& deps);
+
 public:
   /**
    * queue() - Constructor for queue object
@@ -178,6 +245,20 @@ public:
   XRT_API_EXPORT
   queue();
 
+  /**
+   * queue() - Constructor for queue object with pool of consumers
+   *
+   * @param workers
+   *   Number of consumer threads, at least one
+   *
+   * Tasks enqueued without dependencies still execute one at a time
+   * in order of enqueuing.  Tasks enqueued with dependencies execute
+   * on any available consumer once their dependencies are ready.
+   */
+  XRT_API_EXPORT
+  explicit
+  queue(unsigned int workers);
+
   /**
    * enqueue() - Enqueue a callable
    *
@@ -204,6 +285,38 @@ public:
     return f;
   }
 
+  /**
+   * enqueue() - Enqueue a callable with dependencies
+   *
+   * @param c
+   *   Callable function, typically a lambda
+   * @param deps
+   *   Events that must complete before the callable is executed
+   * @return
+   *   Future result of the function (std::future)
+   *
+   * Unlike enqueue(c), the callable is not ordered with respect to
+   * other enqueued operations, it executes as soon as all events in
+   * @deps are ready and a consumer is available.  A chain of
+   * operations where each depends on the event of the former
+   * executes in order, while independent chains overlap when the
+   * queue has more than one consumer.
+   *
+   * An event can be constructed from the future returned when
+   * enqueuing an operation in this or another queue, or from an
+   * xrt::fence.
+   */
+  template <typename Callable>
+  auto
+  enqueue(Callable&& c, std::vector<xrt::queue::event> deps)
+  {
+    using return_type = decltype(c());
+    std::packaged_task<return_type()> task{[cc = std::move(c)] { return cc(); }};
+    std::shared_future f{task.get_future()};
+    add_task(std::move(task), std::move(deps));
+    return f;
+  }
+
   /**
    * enqueue() - Enqueue the future of an enqueued operation
    *
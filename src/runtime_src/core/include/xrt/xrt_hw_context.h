@@ -47,8 +47,11 @@ public:
    *  - priority               // ??
    *  - enable_isp_channel     // toggle isp communication
    *  - enable_acp_channel     // toggle acp communication
+   *  - exec_wait_spin_us      // microseconds a thread waiting for a command
+   *                           // polls before blocking, overrides xrt.ini
+   *                           // Runtime.exec_wait_spin_us
    *
-   * Currently ignored for legacy platforms
+   * Currently ignored for legacy platforms, except exec_wait_spin_us
    */
   using cfg_param_type = std::map<std::string, uint32_t>;
   using qos_type = cfg_param_type; //alias to old type
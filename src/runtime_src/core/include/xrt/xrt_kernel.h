@@ -488,6 +488,70 @@ public:
     set_arg(index, std::forward<ArgType>(argvalue));
   }
 
+  /**
+   * class arg_handle - Kernel argument resolved by name
+   *
+   * A handle is obtained from ``get_arg_handle()`` once and can be
+   * used to set the argument of any run of the same kernel without
+   * looking up the argument name again.
+   */
+  class arg_handle
+  {
+    friend class run;
+    int m_index = -1;
+
+    explicit
+    arg_handle(int index)
+      : m_index(index)
+    {}
+
+  public:
+    arg_handle() = default;
+
+    /**
+     * get_index() - Index of the kernel argument
+     */
+    int
+    get_index() const
+    {
+      return m_index;
+    }
+  };
+
+  /**
+   * get_arg_handle() - Resolve named argument
+   *
+   * @param argnm
+   *   Name of kernel argument
+   * @return
+   *   Handle to use with ``set_arg()`` in place of the name
+   *
+   * Throws if specified argument name doesn't match kernel
+   * specification.
+   */
+  arg_handle
+  get_arg_handle(const std::string& argnm) const
+  {
+    return arg_handle{get_arg_index(argnm)};
+  }
+
+  /**
+   * set_arg - set argument by handle
+   *
+   * @param arg
+   *   Handle from ``get_arg_handle()``
+   * @param argvalue
+   *   Argument value
+   *
+   * Throws if argument value is incompatible with specified argument
+   */
+  template <typename ArgType>
+  void
+  set_arg(const arg_handle& arg, ArgType&& argvalue)
+  {
+    set_arg(arg.get_index(), std::forward<ArgType>(argvalue));
+  }
+
   /**
    * udpdate_arg() - Asynchronous update of scalar kernel global argument
    *
@@ -804,6 +868,125 @@ private:
   std::shared_ptr<kernel_impl> handle;
 };
 
+/*!
+ * @class runlist
+ *
+ * @brief
+ * xrt::runlist is a list of xrt::run objects that are executed as
+ * one unit.
+ *
+ * @details
+ * A runlist is constructed from a hardware context and populated
+ * with run objects whose kernels are associated with the same
+ * hardware context.  The run objects must have their arguments set
+ * prior to executing the runlist.
+ *
+ * Executing the runlist submits all run objects in list order with
+ * one submission to the hardware queue of the hardware context.
+ * The runlist completes when all run objects have completed.
+ *
+ * A run object in a runlist should not be started individually while
+ * the runlist is executing.  Run objects with callbacks cannot be
+ * added to a runlist.
+ */
+class runlist_impl;
+class runlist : public detail::pimpl<runlist_impl>
+{
+public:
+  /**
+   * runlist() - Construct empty runlist object
+   *
+   * Can be used as lvalue in assignment.
+   */
+  runlist() = default;
+
+  /**
+   * runlist() - Construct runlist for a hardware context
+   *
+   * @param hwctx
+   *  Hardware context with which run objects in the list are associated
+   */
+  XCL_DRIVER_DLLESPEC
+  explicit
+  runlist(const xrt::hw_context& hwctx);
+
+  /**
+   * add() - Add a run object to the runlist
+   *
+   * @param run
+   *  Run object to add to the end of the runlist
+   *
+   * The run object must be associated with the same hardware context
+   * as the runlist.  It is an error to add a run object while the
+   * runlist is executing.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  add(const xrt::run& run);
+
+  /**
+   * execute() - Execute the runlist
+   *
+   * Submit all run objects in the runlist for execution as one unit.
+   * It is an error to execute a runlist that is already executing.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  execute();
+
+  /**
+   * wait() - Wait for all run objects in the runlist to complete
+   *
+   * @param timeout
+   *  Timeout for wait (default block till run completes)
+   * @return
+   *  std::cv_status::no_timeout when all run objects completed,
+   *  std::cv_status::timeout otherwise
+   *
+   * The function throws xrt::run::command_error if a run object
+   * completes unsuccessfully.
+   */
+  XCL_DRIVER_DLLESPEC
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout) const;
+
+  /**
+   * wait() - Wait for all run objects in the runlist to complete
+   */
+  void
+  wait() const
+  {
+    wait(std::chrono::milliseconds{0});
+  }
+
+  /**
+   * state() - Check the current state of the runlist
+   *
+   * @return
+   *  State of first run object that has not completed, or
+   *  ERT_CMD_STATE_COMPLETED if all run objects have completed
+   */
+  XCL_DRIVER_DLLESPEC
+  ert_cmd_state
+  state() const;
+
+  /**
+   * size() - Number of run objects in the runlist
+   */
+  XCL_DRIVER_DLLESPEC
+  size_t
+  size() const;
+
+  /**
+   * reset() - Remove all run objects from the runlist
+   *
+   * It is an error to reset a runlist that is executing.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  reset();
+};
+
 /// @cond
 // Undocumented experimental API subject to be replaced
 XCL_DRIVER_DLLESPEC
@@ -97,6 +97,8 @@
  * 23   Allocate buffer on host memory         DRM_IOCTL_XOCL_ALLOC_CMA       drm_xocl_alloc_cma_info
  * 24   Free host memory buffer                DRM_IOCTL_XOCL_FREE_CMA        N/A
  * 25   Copy bo buffers                        DRM_IOCTL_XOCL_COPY_BO         drm_xocl_copy_bo
+ * 26   Send a list of execute jobs under a    DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST
+ *      specific hw context                                                   drm_xocl_hw_ctx_execbuf_list
  * ==== ====================================== ============================== ==================================
  */
 
@@ -187,6 +189,8 @@ enum drm_xocl_ops {
 	DRM_XOCL_COPY_BO,
 	/* Set CU read-only range */
 	DRM_XOCL_SET_CU_READONLY_RANGE,
+	/* List of commands to run under hw context */
+	DRM_XOCL_HW_CTX_EXECBUF_LIST,
 
 	/* The following IOCTLs can only be called from linux kernel space
 	 * WARNING: INTERNAL USE ONLY. NOT FOR PUBLIC CONSUMPTION.
@@ -558,7 +562,15 @@ struct drm_xocl_ctx {
  * @axlf_ptr:      axlf pointer which need to download
  * @qos:           QOS information
  * @hw_context:    Returns Context handle
+ *
+ * The low bits of @qos select how the scheduler picks a CU for
+ * commands that may run on several CUs (enum kds_cu_policy):
+ * 0 default, 1 least used, 2 least outstanding commands,
+ * 3 shortest expected latency, 4 round robin.
  */
+#define XOCL_HW_CTX_QOS_CU_POLICY_MASK	0xF
+#define XOCL_HW_CTX_QOS_CU_POLICY_MAX	5
+
 struct drm_xocl_create_hw_ctx {
 	struct drm_xocl_axlf	*axlf_ptr;
 	uint32_t		qos;
@@ -723,6 +735,27 @@ struct drm_xocl_hw_ctx_execbuf {
 	uint32_t deps[MAX_DEPENT_CMD_BO];
 };
 
+#define XOCL_EXECBUF_LIST_MAX	4096
+
+/**
+ * struct drm_xocl_hw_ctx_execbuf_list - Submit a list of command buffers for
+ * execution with one DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST ioctl
+ *
+ * @hw_ctx_id:	     Pass the HW Context id
+ * @count:	     Number of command buffers, at most XOCL_EXECBUF_LIST_MAX
+ * @exec_bo_handles: User pointer to array of @count BO handles of command
+ *                   buffers formatted as ERT commands.  Commands are
+ *                   submitted in array order, submission stops at the
+ *                   first command that fails.  A list with @count 0
+ *                   submits nothing and can be used to check that the
+ *                   ioctl is supported.
+ */
+struct drm_xocl_hw_ctx_execbuf_list {
+	uint32_t hw_ctx_id;
+	uint32_t count;
+	uint64_t exec_bo_handles;
+};
+
 /**
  * struct drm_xocl_execbuf_cb - Submit a command buffer for execution on a compute unit
  * used with DRM_IOCTL_XOCL_EXECBUF_CB ioctl with a callback (linux kernel only)
@@ -816,6 +849,7 @@ struct drm_xocl_alloc_cma_info {
 #define	DRM_IOCTL_XOCL_FREE_CMA		XOCL_IOC(FREE_CMA)
 #define	DRM_IOCTL_XOCL_COPY_BO		XOCL_IOC_ARG(COPY_BO, copy_bo)
 #define	DRM_IOCTL_XOCL_SET_CU_READONLY_RANGE	XOCL_IOC_ARG(SET_CU_READONLY_RANGE, set_cu_range)
+#define	DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST	XOCL_IOC_ARG(HW_CTX_EXECBUF_LIST, hw_ctx_execbuf_list)
 
 #define	DRM_IOCTL_XOCL_KINFO_BO		XOCL_IOC_ARG(KINFO_BO, kinfo_bo)
 #define	DRM_IOCTL_XOCL_MAP_KERN_MEM	XOCL_IOC_ARG(MAP_KERN_MEM, map_kern_mem)
@@ -56,6 +56,13 @@ int xocl_create_hw_context(struct xocl_dev *xdev, struct drm_file *filp,
 		goto error_out;
 	}
 
+	ret = kds_set_hw_ctx_cu_policy(hw_ctx,
+			hw_ctx_args->qos & XOCL_HW_CTX_QOS_CU_POLICY_MASK);
+	if (ret) {
+		kds_free_hw_ctx(client, hw_ctx);
+		goto error_out;
+	}
+
 	/* Lock the bitstream. Unlock the same in destroy context */
 	ret = xocl_icap_lock_bitstream(xdev, xclbin_id, slot_id);
 	if (ret) {
@@ -264,3 +271,35 @@ int xocl_hw_ctx_command(struct xocl_dev *xdev, void *data,
 
 	return xocl_command_ioctl(xdev, &legacy_args, filp, false);
 }
+
+/*
+ * Submit a list of commands with one ioctl. Each command is submitted
+ * exactly as with DRM_IOCTL_XOCL_HW_CTX_EXECBUF, in list order.
+ */
+int xocl_hw_ctx_command_list(struct xocl_dev *xdev, void *data,
+			      struct drm_file *filp)
+{
+	struct drm_xocl_hw_ctx_execbuf_list *args = data;
+	uint32_t __user *handles = (uint32_t __user *)(uintptr_t)args->exec_bo_handles;
+	struct drm_xocl_execbuf legacy_args = {};
+	uint32_t handle;
+	uint32_t i;
+	int ret = 0;
+
+	if (args->count > XOCL_EXECBUF_LIST_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < args->count; ++i) {
+		if (get_user(handle, handles + i))
+			return -EFAULT;
+
+		memset(&legacy_args, 0, sizeof(legacy_args));
+		legacy_args.ctx_id = args->hw_ctx_id;
+		legacy_args.exec_bo_handle = handle;
+		ret = xocl_command_ioctl(xdev, &legacy_args, filp, false);
+		if (ret)
+			break;
+	}
+
+	return ret;
+}
@@ -800,6 +800,7 @@ int xocl_command_ioctl(struct xocl_dev *xdev, void *data,
 	xcmd->gem_obj = obj;
 	xcmd->exec_bo_handle = args->exec_bo_handle;
 	xcmd->hw_ctx_id = args->ctx_id;
+	xcmd->cu_policy = kds_get_hw_ctx_cu_policy(client, xcmd->hw_ctx_id);
 
 	print_ecmd_info(ecmd);
 
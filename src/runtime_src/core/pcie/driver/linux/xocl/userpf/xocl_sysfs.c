@@ -500,6 +500,35 @@ kds_interval_show(struct device *dev, struct device_attribute *attr, char *buf)
 }
 static DEVICE_ATTR(kds_interval, 0644, kds_interval_show, kds_interval_store);
 
+static ssize_t
+kds_cu_policy_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 policy;
+
+	if (kstrtou32(buf, 10, &policy) == -EINVAL)
+		return -EINVAL;
+
+	if (policy >= KDS_CU_POLICY_MAX)
+		return -EINVAL;
+
+	XDEV(xdev)->kds.cu_mgmt.cu_policy = policy;
+	XDEV(xdev)->kds.scu_mgmt.cu_policy = policy;
+
+	return count;
+}
+
+static ssize_t
+kds_cu_policy_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 policy = XDEV(xdev)->kds.cu_mgmt.cu_policy;
+
+	return sprintf(buf, "%d (%s)\n", policy, kds_cu_policy2str(policy));
+}
+static DEVICE_ATTR(kds_cu_policy, 0644, kds_cu_policy_show, kds_cu_policy_store);
+
 static ssize_t
 ert_disable_show(struct device *dev, struct device_attribute *attr, char *buf)
 {
@@ -945,6 +974,7 @@ static struct attribute *xocl_attrs[] = {
 	&dev_attr_kds_stat.attr,
 	&dev_attr_kds_interrupt.attr,
 	&dev_attr_kds_interval.attr,
+	&dev_attr_kds_cu_policy.attr,
 	&dev_attr_ert_disable.attr,
 	&dev_attr_dev_offline.attr,
 	&dev_attr_mig_calibration.attr,
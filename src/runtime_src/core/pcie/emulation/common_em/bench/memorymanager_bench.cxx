@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Allocation churn benchmark for the emulation MemoryManager.
+//
+// A bank is filled with a number of live buffers of random size, then
+// a random live buffer is freed and a new one allocated for the given
+// number of iterations, the way an application creating and releasing
+// many BOs exercises the shim.  Finally all buffers are freed.
+//
+// The run checks that live buffers never overlap and that the bank is
+// a single free range again at the end, and reports the time per
+// operation of each phase.
+
+#include "memorymanager.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct options
+{
+  size_t live = 20000;           // number of live buffers
+  size_t iterations = 200000;    // free/alloc pairs
+  size_t max_pages = 64;         // max buffer size in pages
+  unsigned int padding = 0;      // alloc padding factor
+  uint64_t seed = 1;
+  bool verify = true;
+};
+
+double
+ns_per_op(clock_type::time_point start, size_t ops)
+{
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+  return ops ? static_cast<double>(ns) / ops : 0.0;
+}
+
+// Live buffers by address, used to check for overlap
+bool
+overlaps(const std::map<uint64_t, uint64_t>& live, uint64_t addr, uint64_t size)
+{
+  auto next = live.lower_bound(addr);
+  if (next != live.end() && next->first < addr + size)
+    return true;
+  if (next != live.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second > addr)
+      return true;
+  }
+  return false;
+}
+
+int
+run(const options& opt)
+{
+  const uint64_t page = 4096;
+  const uint64_t start = 0x4000000000ull;
+
+  // Room for the live buffers at their largest padded size plus some
+  // slack for fragmentation
+  uint64_t bank_size = opt.live * opt.max_pages * page * (1 + 2 * opt.padding) * 2;
+  xclemulation::MemoryManager mm(bank_size, start, page);
+
+  std::mt19937_64 rng(opt.seed);
+  std::uniform_int_distribution<size_t> pages(1, opt.max_pages);
+  std::vector<uint64_t> bufs;
+  std::map<uint64_t, uint64_t> live;
+  bufs.reserve(opt.live);
+
+  auto alloc = [&] {
+    size_t size = pages(rng) * page - (rng() % page);
+    uint64_t addr = mm.alloc(size, opt.padding);
+    if (addr == xclemulation::MemoryManager::mNull) {
+      std::fprintf(stderr, "allocation of %zu bytes failed, %llu bytes free\n",
+                   size, static_cast<unsigned long long>(mm.freeSize()));
+      return false;
+    }
+    if (opt.verify) {
+      auto range = mm.lookup(addr);
+      if (addr % page || overlaps(live, range.first, range.second)) {
+        std::fprintf(stderr, "bad allocation at 0x%llx\n", static_cast<unsigned long long>(addr));
+        return false;
+      }
+      live.emplace(range.first, range.second);
+    }
+    bufs.push_back(addr);
+    return true;
+  };
+
+  auto release = [&](size_t idx) {
+    uint64_t addr = bufs[idx];
+    bufs[idx] = bufs.back();
+    bufs.pop_back();
+    mm.free(addr);
+    if (opt.verify)
+      live.erase(addr);
+  };
+
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < opt.live; ++i)
+    if (!alloc())
+      return 1;
+  double fill_ns = ns_per_op(t0, opt.live);
+
+  t0 = clock_type::now();
+  for (size_t i = 0; i < opt.iterations; ++i) {
+    release(rng() % bufs.size());
+    if (!alloc())
+      return 1;
+  }
+  double churn_ns = ns_per_op(t0, opt.iterations);
+
+  t0 = clock_type::now();
+  while (!bufs.empty())
+    release(rng() % bufs.size());
+  double drain_ns = ns_per_op(t0, opt.live);
+
+  size_t whole = bank_size;
+  uint64_t addr = mm.alloc(whole);
+  if (mm.freeSize() != 0 || addr != start) {
+    std::fprintf(stderr, "bank did not coalesce back to a single free range\n");
+    return 1;
+  }
+
+  std::printf("%zu live buffers, %zu iterations, 1-%zu pages, padding %u%s\n",
+              opt.live, opt.iterations, opt.max_pages, opt.padding,
+              opt.verify ? ", verified" : "");
+  std::printf("%-8s %12s\n", "phase", "ns/op");
+  std::printf("%-8s %12.1f\n", "fill", fill_ns);
+  std::printf("%-8s %12.1f\n", "churn", churn_ns);
+  std::printf("%-8s %12.1f\n", "drain", drain_ns);
+  return 0;
+}
+
+void
+usage(const char* prog)
+{
+  std::printf("Usage: %s [options]\n", prog);
+  std::printf("  -n <num>   number of live buffers (default 20000)\n");
+  std::printf("  -i <num>   number of free/alloc iterations (default 200000)\n");
+  std::printf("  -s <num>   max buffer size in pages (default 64)\n");
+  std::printf("  -p <num>   alloc padding factor (default 0)\n");
+  std::printf("  -x <seed>  random seed\n");
+  std::printf("  -q         skip the overlap checks to time the allocator only\n");
+  std::printf("  -h         this help\n");
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  options opt;
+  int c;
+
+  while ((c = getopt(argc, argv, "n:i:s:p:x:qh")) != -1) {
+    switch (c) {
+    case 'n': opt.live = std::strtoull(optarg, nullptr, 0); break;
+    case 'i': opt.iterations = std::strtoull(optarg, nullptr, 0); break;
+    case 's': opt.max_pages = std::strtoull(optarg, nullptr, 0); break;
+    case 'p': opt.padding = std::strtoul(optarg, nullptr, 0); break;
+    case 'x': opt.seed = std::strtoull(optarg, nullptr, 0); break;
+    case 'q': opt.verify = false; break;
+    case 'h': usage(argv[0]); return 0;
+    default: usage(argv[0]); return 1;
+    }
+  }
+
+  if (!opt.live || !opt.max_pages) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  return run(opt);
+}
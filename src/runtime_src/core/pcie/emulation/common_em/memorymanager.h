@@ -20,6 +20,7 @@
 #include <mutex>
 #include <list>
 #include <map>
+#include <set>
 #include <cassert>
 #include <algorithm>
 
@@ -33,17 +34,19 @@ static std::string DEFAULT_TAG("");
     class MemoryManager 
     {
         std::mutex mMemManagerMutex;
-        std::list<std::pair<uint64_t, uint64_t> > mFreeBufferList;
-        std::list<std::pair<uint64_t, uint64_t> > mBusyBufferList;
+        // Free ranges are indexed twice: by start address to merge a
+        // freed range with its neighbours, and by (size, start) to find
+        // the smallest range that fits a request. Busy ranges are
+        // indexed by start address. All operations are O(log n).
+        std::map<uint64_t, uint64_t> mFreeByAddr;
+        std::set<std::pair<uint64_t, uint64_t> > mFreeBySize;
+        std::map<uint64_t, uint64_t> mBusyBuffers;
         uint64_t mSize;
         uint64_t mStart;
         uint64_t mAlignment;
 	std::string mTag;
-        const unsigned mCoalesceThreshold;
         uint64_t mFreeSize;
 
-        typedef std::list<std::pair<uint64_t, uint64_t> > PairList;
-
     public:
 	static const uint64_t mNull = 0xffffffffffffffffull;
 	std::list<MemoryManager*> mChildMemories;
@@ -64,8 +67,8 @@ static std::string DEFAULT_TAG("");
         std::pair<uint64_t, uint64_t>lookup(uint64_t buf);
 
     private:
-        void coalesce();
-        PairList::iterator find(uint64_t buf);
+        void insertFree(uint64_t start, uint64_t size);
+        void eraseFree(std::map<uint64_t, uint64_t>::iterator it);
     };
 }
 
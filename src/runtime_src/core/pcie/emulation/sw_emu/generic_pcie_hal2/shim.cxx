@@ -881,10 +881,13 @@ namespace xclswemuhal2
     }
 
     bool ack = false;
+    // Allocate as P2P in shared memory mode so the device process
+    // returns the name of its memory file
+    bool sharedMem = useSharedMemory();
     // Memory Manager Has allocated aligned address,
     // size contains alignement + original size requested.
     // We are passing original size to device process for exact stats.
-    xclAllocDeviceBuffer_RPC_CALL(xclAllocDeviceBuffer, result, size, zeroCopy);
+    xclAllocDeviceBuffer_RPC_CALL(xclAllocDeviceBuffer, result, size, (zeroCopy || sharedMem));
 
     if (!ack)
     {
@@ -892,6 +895,9 @@ namespace xclswemuhal2
       return 0;
     }
 
+    if (sharedMem)
+      mapSharedMemory(sFileName);
+
     DEBUG_MSGS("%s, %d(ENDED)\n", __func__, __LINE__);
     PRINTENDFUNC;
     return result;
@@ -1099,6 +1105,103 @@ namespace xclswemuhal2
     return size;
   }
 
+  bool SwEmuShim::useSharedMemory() const
+  {
+    // Without the single mmap the device process uses one file per P2P
+    // buffer and the file offset is not the device address
+    return xclemulation::config::getInstance()->isSharedMemoryDataPath()
+      && !mSharedMemDisabled
+      && !std::getenv("VITIS_SW_EMU_DISABLE_SINGLE_MMAP");
+  }
+
+  void SwEmuShim::mapSharedMemory(const std::string &fileName)
+  {
+    if (fileName.empty())
+    {
+      disableSharedMemory("device process did not return a memory file");
+      return;
+    }
+
+    if (mSharedMem)
+    {
+      if (fileName != mSharedMemFileName)
+        disableSharedMemory("device process returned a second memory file " + fileName);
+      return;
+    }
+
+    int fd = open(fileName.c_str(), O_RDWR);
+    if (fd == -1)
+    {
+      disableSharedMemory("failed to open " + fileName);
+      return;
+    }
+
+    // Same mapping as xclMapBO for P2P buffers, the file offset is the
+    // device address
+    void *data = mmap(0, MEMSIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      close(fd);
+      disableSharedMemory("failed to mmap " + fileName);
+      return;
+    }
+
+    mSharedMem = static_cast<char *>(data);
+    mSharedMemFd = fd;
+    mSharedMemFileName = fileName;
+    mSharedMemFileSize = 0;
+
+    if (mLogStream.is_open())
+      mLogStream << __func__ << ", " << std::this_thread::get_id() << ", " << fileName << std::endl;
+  }
+
+  void SwEmuShim::unmapSharedMemory()
+  {
+    if (!mSharedMem)
+      return;
+
+    munmap(mSharedMem, MEMSIZE);
+    close(mSharedMemFd);
+    mSharedMem = nullptr;
+    mSharedMemFd = -1;
+    mSharedMemFileSize = 0;
+    mSharedMemFileName.clear();
+  }
+
+  void SwEmuShim::disableSharedMemory(const std::string &reason)
+  {
+    // Buffers are in device memory either way, so copies can switch to
+    // the RPC path at any time
+    if (mLogStream.is_open())
+      mLogStream << __func__ << ", " << std::this_thread::get_id() << ", " << reason << std::endl;
+
+    if (!mSharedMemDisabled && !xclemulation::config::getInstance()->isWarningsuppressed())
+      std::cout << "WARNING: [SW_EMU 24] Shared memory data path disabled, " << reason << std::endl;
+
+    mSharedMemDisabled = true;
+    unmapSharedMemory();
+  }
+
+  char *SwEmuShim::getSharedMemory(uint64_t addr, size_t size)
+  {
+    if (!mSharedMem || addr + size > MEMSIZE)
+      return nullptr;
+
+    // Accessing the mapping beyond the end of the file raises SIGBUS,
+    // the file is grown by the device process
+    if (addr + size > mSharedMemFileSize)
+    {
+      struct stat st;
+      if (fstat(mSharedMemFd, &st) == -1)
+        return nullptr;
+      mSharedMemFileSize = st.st_size;
+      if (addr + size > mSharedMemFileSize)
+        return nullptr;
+    }
+
+    return mSharedMem + addr;
+  }
+
   size_t SwEmuShim::xclCopyBufferHost2Device(uint64_t dest, const void *src, size_t size, size_t seek)
   {
     if (mLogStream.is_open())
@@ -1115,6 +1218,13 @@ namespace xclswemuhal2
     src = (unsigned char *)src + seek;
     dest += seek;
 
+    if (auto shared = getSharedMemory(dest, size))
+    {
+      std::memcpy(shared, src, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1160,6 +1270,14 @@ namespace xclswemuhal2
       launchTempProcess();
 
     src += skip;
+
+    if (auto shared = getSharedMemory(src, size))
+    {
+      std::memcpy(dest, shared, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1268,6 +1386,9 @@ namespace xclswemuhal2
       mFdToFileNameMap.clear();
     }
 
+    // The device process is restarted with the next program
+    unmapSharedMemory();
+
     if (mLogStream.is_open())
       mLogStream << __func__ << ", " << std::this_thread::get_id() << std::endl;
 
@@ -2075,16 +2196,11 @@ namespace xclswemuhal2
 */
   int SwEmuShim::xclExecWait(int timeoutMilliSec)
   {
-    //unsigned int tSec = 0;
-    //static bool bConfig = true;
-    //tSec = timeoutMilliSec / 1000;
-    //if (bConfig)
-    //{
-    //  tSec = timeoutMilliSec / 1000;
-    //  bConfig = false;
-    //}
-    //sleep(tSec);
-    //PRINTENDFUNC;
+    // Block until the scheduler completes a command instead of
+    // returning right away, which made callers spin on command state
+    if (mSWSch)
+      return mSWSch->wait_for_completion(timeoutMilliSec);
+
     return 1;
   }
 
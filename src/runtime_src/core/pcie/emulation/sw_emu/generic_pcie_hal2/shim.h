@@ -688,6 +688,23 @@ namespace xclswemuhal2
     bool launchDeviceProcess(bool debuggable, std::string &binDir);
     void launchTempProcess();
     void initMemoryManager(std::list<xclemulation::DDRBank> &DDRBankList);
+
+    // Shared memory data path.  The device process keeps the device
+    // memory in a single file, which it names when a P2P buffer is
+    // allocated.  With shared_memory_data_path=true every buffer is
+    // allocated as P2P and the host maps the file once, so buffer
+    // copies are memcpy's and the RPC messages only carry addresses
+    // and sizes.
+    bool useSharedMemory() const;
+    void mapSharedMemory(const std::string &fileName);
+    void unmapSharedMemory();
+    void disableSharedMemory(const std::string &reason);
+    char *getSharedMemory(uint64_t addr, size_t size);
+    char *mSharedMem = nullptr;
+    int mSharedMemFd = -1;
+    uint64_t mSharedMemFileSize = 0;
+    std::string mSharedMemFileName;
+    bool mSharedMemDisabled = false;
     std::vector<xclemulation::MemoryManager *> mDDRMemoryManager;
 
     void *ci_buf;
@@ -311,6 +311,8 @@ namespace xclswemuhal2 {
     mParent = _parent;
     mScheduler = new xocl_sched(this);
     num_pending = 0;
+    num_completed = 0;
+    num_reported = 0;
   }
 
   SWScheduler::~SWScheduler()
@@ -742,6 +744,28 @@ namespace xclswemuhal2 {
       client_ctx* entry = it;
       entry->trigger++;
     }
+
+    {
+      std::lock_guard<std::mutex> lk(completion_mutex);
+      num_completed++;
+    }
+    completion_cond.notify_all();
+  }
+
+  int SWScheduler::wait_for_completion(int timeoutMilliSec)
+  {
+    PRINTSTARTFUNC
+    std::unique_lock<std::mutex> lk(completion_mutex);
+    auto completed = [this] { return num_completed != num_reported; };
+
+    // Same convention as poll(), a negative timeout waits forever
+    if (timeoutMilliSec < 0)
+      completion_cond.wait(lk, completed);
+    else if (!completion_cond.wait_for(lk, std::chrono::milliseconds(timeoutMilliSec), completed))
+      return 0;
+
+    num_reported = num_completed;
+    return 1;
   }
 
   void SWScheduler::mark_cmd_complete(xocl_cmd *xcmd)
@@ -992,9 +1016,10 @@ namespace xclswemuhal2 {
     pending_cmds.clear();
   }
 
-  void SWScheduler::scheduler_iterate_cmds()
+  bool SWScheduler::scheduler_iterate_cmds()
   {
     //PRINTSTARTFUNC
+     bool progress = false;
      auto end = mScheduler->command_queue.end();
 #ifdef EM_DEBUG_KDS
      //if(mScheduler->command_queue.size() > 0)
@@ -1008,7 +1033,8 @@ namespace xclswemuhal2 {
 #ifdef EM_DEBUG_KDS
          std::cout<<xcmd << " is in QUEUED state  "<< std::endl;
 #endif
-         queued_to_running(xcmd);
+         if (queued_to_running(xcmd))
+           progress = true;
        }
        if (xcmd->state == ERT_CMD_STATE_RUNNING)
        {
@@ -1023,37 +1049,67 @@ namespace xclswemuhal2 {
          complete_to_free(xcmd);
          itr = mScheduler->command_queue.erase(itr);
          end = mScheduler->command_queue.end();
+         progress = true;
        }
        else {
          ++itr;
        }
      }
 
+     return progress;
+  }
+
+  bool SWScheduler::scheduler_idle()
+  {
+    return pending_cmds.empty() && mScheduler->command_queue.empty();
   }
 
-  void scheduler_loop(xocl_sched *xs)
+  /* Called with pending_cmds_mutex held. Returns true if any command
+   * was started or completed. */
+  bool scheduler_loop(xocl_sched *xs)
   {
     //PRINTSTARTFUNC
     SWScheduler* pSch = xs->pSch;
-    std::lock_guard<std::mutex> lk(pSch->pending_cmds_mutex);
 
-    if (xs->error) { return; }
+    if (xs->error) { return false; }
 
     /* queue new pending commands */
     pSch->scheduler_queue_cmds();
 
     /* iterate all commands */
-    pSch->scheduler_iterate_cmds();
+    return pSch->scheduler_iterate_cmds();
   }
 
   void* scheduler(void* data)
   {
     PRINTSTARTFUNC
     xocl_sched *xs = (xocl_sched *)data;
+    SWScheduler* pSch = xs->pSch;
+
+    /* CU completion is only visible by reading the CU registers in the
+     * device process, so running commands are still polled, but the
+     * interval grows while nothing completes. New commands and stop
+     * wake the thread immediately, and an idle scheduler just sleeps. */
+    const auto min_backoff = std::chrono::microseconds(10);
+    const auto max_backoff = std::chrono::microseconds(1000);
+    auto backoff = min_backoff;
+    auto woken = [xs, pSch] { return xs->stop || xs->error || pSch->num_pending > 0; };
+
+    std::unique_lock<std::mutex> lk(pSch->pending_cmds_mutex);
     while (!xs->stop && !xs->error)
     {
-      scheduler_loop(xs);
-      usleep(10);
+      if (scheduler_loop(xs))
+        backoff = min_backoff;
+      else
+        backoff = std::min(backoff * 2, max_backoff);
+
+      if (pSch->scheduler_idle()) {
+        xs->state_cond.wait(lk, woken);
+        backoff = min_backoff;
+      }
+      else if (xs->state_cond.wait_for(lk, backoff, woken)) {
+        backoff = min_backoff;
+      }
     }
     return NULL;
   }
@@ -1092,8 +1148,11 @@ namespace xclswemuhal2 {
     std::cout<<"SWScheduler Thread ended "<< std::endl;
 #endif
 
-    mScheduler->stop= true;
-    scheduler_wait_condition();
+    {
+      std::lock_guard<std::mutex> lk(pending_cmds_mutex);
+      mScheduler->stop= true;
+      scheduler_wait_condition();
+    }
     mScheduler->bThreadCreated = false;
     
     //int retval = pthread_join(mScheduler->scheduler_thread,NULL);
@@ -1106,6 +1165,14 @@ namespace xclswemuhal2 {
     mScheduler->command_queue.clear();
     free_cmds.clear();
 
+    // Release any thread blocked in wait_for_completion so it can
+    // see the commands that will never complete
+    {
+      std::lock_guard<std::mutex> lk(completion_mutex);
+      num_completed++;
+    }
+    completion_cond.notify_all();
+
     return retval;
   }
 
@@ -6,6 +6,7 @@
 #ifndef _SW_SCHEDULER_H_
 #define _SW_SCHEDULER_H_
 
+#include <chrono>
 #include <list>
 #include <mutex>
 #include <cmath>
@@ -172,7 +173,9 @@ namespace xclswemuhal2 {
     int add_cmd(exec_core *exec, xclemulation::drm_xocl_bo* bo) ;
     int scheduler_wait_condition() ;
     void scheduler_queue_cmds();
-    void scheduler_iterate_cmds();
+    bool scheduler_iterate_cmds();
+    bool scheduler_idle();
+    int wait_for_completion(int timeoutMilliSec);
     int get_free_cu(struct xocl_cmd *xcmd);
     void configure_cu(struct xocl_cmd *xcmd, int cu_idx);
     bool cu_done(struct exec_core *exec, unsigned int cu_idx);
@@ -188,7 +191,7 @@ namespace xclswemuhal2 {
     bool cu_ready(xocl_cu *xcu);
     bool cu_start(xocl_cu *xcu, xocl_cmd *xcmd);
 
-    friend void scheduler_loop(xocl_sched *xs);
+    friend bool scheduler_loop(xocl_sched *xs);
     friend void* scheduler(void* data) ;
 
     int init_scheduler_thread(void) ;
@@ -209,6 +212,13 @@ namespace xclswemuhal2 {
 
     std::mutex m_add_cmd_mutex;
     int num_pending;
+
+    // Completions not yet reported by wait_for_completion, the
+    // emulation counterpart of the trigger count polled by exec_wait
+    std::mutex completion_mutex;
+    std::condition_variable completion_cond;
+    uint64_t num_completed;
+    uint64_t num_reported;
   };
 }
 
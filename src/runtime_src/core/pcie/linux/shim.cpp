@@ -34,6 +34,7 @@
 
 #include "core/pcie/driver/linux/include/mgmt-reg.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <chrono>
@@ -326,6 +327,16 @@ public:
     m_shim->exec_buf(cmd_bo->get_handle(), this);
   }
 
+  void
+  exec_buf(const std::vector<xrt_core::buffer_handle*>& cmds) override
+  {
+    std::vector<xclBufferHandle> handles;
+    handles.reserve(cmds.size());
+    for (auto cmd : cmds)
+      handles.push_back(static_cast<const buffer_object*>(cmd)->get_handle());
+    m_shim->exec_buf(handles, this);
+  }
+
   bool
   is_null() const
   {
@@ -2562,7 +2573,14 @@ create_hw_context(const xrt::uuid& xclbin_uuid,
                   const xrt::hw_context::cfg_param_type& cfg_param,
                   xrt::hw_context::access_mode mode)
 {
-  const static int qos_val = 0; // TBD qos;
+  // The only QoS setting passed to the driver for now is the CU
+  // selection policy of the context, see drm_xocl_create_hw_ctx
+  uint32_t qos_val = 0;
+  if (auto itr = cfg_param.find("cu_policy"); itr != cfg_param.end()) {
+    if (itr->second >= XOCL_HW_CTX_QOS_CU_POLICY_MAX)
+      throw xrt_core::error(EINVAL, "Invalid cu_policy (" + std::to_string(itr->second) + ")");
+    qos_val = itr->second;
+  }
 
   if (!hw_context_enable) {
     // Nothing to be done here for legacy flow
@@ -2666,6 +2684,38 @@ exec_buf(xclBufferHandle boh, xrt_core::hwctx_handle* hwctx_hdl)
   }
 }
 
+// Exec Buf of a list of commands.  Drivers without the list ioctl
+// reject an empty list, in which case commands are submitted one by
+// one.
+void
+shim::
+exec_buf(const std::vector<xclBufferHandle>& bohs, xrt_core::hwctx_handle* hwctx_hdl)
+{
+  static_assert(sizeof(xclBufferHandle) == sizeof(uint32_t), "list ioctl takes 32 bit BO handles");
+  auto hwctx = static_cast<const xrt_shim::hwcontext*>(hwctx_hdl);
+  uint32_t hw_ctx_id = hwctx->is_null() ? 0 : hwctx_hdl->get_slotidx();
+
+  std::call_once(mExecBufListChecked, [this, hw_ctx_id] {
+    drm_xocl_hw_ctx_execbuf_list probe = {hw_ctx_id, 0, 0};
+    mExecBufList = (mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST, &probe) == 0);
+  });
+
+  if (!mExecBufList) {
+    for (auto boh : bohs)
+      exec_buf(boh, hwctx_hdl);
+    return;
+  }
+
+  for (size_t idx = 0; idx < bohs.size(); idx += XOCL_EXECBUF_LIST_MAX) {
+    auto count = std::min<size_t>(XOCL_EXECBUF_LIST_MAX, bohs.size() - idx);
+    drm_xocl_hw_ctx_execbuf_list exec = {
+      hw_ctx_id, static_cast<uint32_t>(count), reinterpret_cast<uint64_t>(bohs.data() + idx)
+    };
+    if (mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST, &exec))
+      throw xrt_core::system_error(errno, "failed to launch list of execution buffers");
+  }
+}
+
 } // namespace xocl
 
 ////////////////////////////////////////////////////////////////
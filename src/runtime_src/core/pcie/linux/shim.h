@@ -168,6 +168,11 @@ public:
   // Exec Buf with hw ctx handle.
   void
   exec_buf(xclBufferHandle boh, xrt_core::hwctx_handle* ctxhdl);
+
+  // Exec Buf of a list of commands with one ioctl if supported by
+  // the driver, otherwise one by one.
+  void
+  exec_buf(const std::vector<xclBufferHandle>& bohs, xrt_core::hwctx_handle* ctxhdl);
 private:
   std::shared_ptr<xrt_core::device> mCoreDevice;
   std::shared_ptr<xrt_core::pci::dev> mDev;
@@ -197,6 +202,9 @@ private:
   };
   std::vector<CuData> mCuMaps;
   std::mutex mCuMapLock;
+  // Driver supports DRM_IOCTL_XOCL_HW_CTX_EXECBUF_LIST
+  std::once_flag mExecBufListChecked;
+  bool mExecBufList = false;
 
   bool zeroOutDDR();
   bool isXPR() const {
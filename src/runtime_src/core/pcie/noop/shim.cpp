@@ -28,6 +28,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace { // private implementation details
 
@@ -291,6 +292,8 @@ static std::vector<std::shared_ptr<pl::device>> s_devices;
 namespace cmd {
 
 static unsigned int completion_delay_us = 0;
+static unsigned int exec_buf_fail_interval = 0;
+static std::atomic<uint64_t> exec_buf_count {0};
 static xrt_core::task::queue running_queue;
 static std::thread completer;
 static std::atomic<uint64_t> completion_count {0};
@@ -307,10 +310,19 @@ struct cmd_type
 static void
 init()
 {
+  exec_buf_fail_interval = xrt_core::config::get_noop_exec_buf_fail_interval();
   if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) )
     completer = std::move(xrt_core::thread(xrt_core::task::worker, std::ref(running_queue)));
 }
 
+// Inject submission failure of every Nth command if configured
+static void
+check_exec_buf()
+{
+  if (exec_buf_fail_interval && (++exec_buf_count % exec_buf_fail_interval) == 0)
+    throw xrt_core::system_error(EIO, "noop: injected exec_buf failure");
+}
+
 static void
 stop()
 {
@@ -353,6 +365,43 @@ add(xclBufferHandle handle)
     mark_cmd_handle_complete(handle);
 }
 
+// A list of commands is treated as one chained command.  All commands
+// complete together and count as one completion for exec_wait.
+struct cmd_list_type
+{
+  std::vector<xclBufferHandle> handles;
+  unsigned long queue_time;
+  cmd_list_type(std::vector<xclBufferHandle> h)
+    : handles(std::move(h)), queue_time(xrt_core::time_ns())
+  {}
+};
+
+static void
+mark_cmd_list_handles_complete(const std::vector<xclBufferHandle>& handles)
+{
+  for (auto handle : handles) {
+    auto cmd = reinterpret_cast<ert_packet*>(buffer::map(handle));
+    cmd->state = ERT_CMD_STATE_COMPLETED;
+  }
+  ++completion_count;
+}
+
+static void
+mark_cmd_list_complete(cmd_list_type ct)
+{
+  while (xrt_core::time_ns() - ct.queue_time < completion_delay_us * 1000);
+  mark_cmd_list_handles_complete(ct.handles);
+}
+
+static void
+add(std::vector<xclBufferHandle> handles)
+{
+  if (completion_delay_us)
+    xrt_core::task::createF(running_queue, mark_cmd_list_complete, cmd_list_type(std::move(handles)));
+  else
+    mark_cmd_list_handles_complete(handles);
+}
+
 struct X
 {
   X() { init(); }
@@ -528,6 +577,16 @@ public:
       m_shim->exec_buf(cmd->get_xcl_handle());
     }
 
+    void
+    exec_buf(const std::vector<xrt_core::buffer_handle*>& cmds) override
+    {
+      std::vector<buffer_handle_type> handles;
+      handles.reserve(cmds.size());
+      for (auto cmd : cmds)
+        handles.push_back(cmd->get_xcl_handle());
+      m_shim->exec_buf(std::move(handles));
+    }
+
     bool
     is_null() const
     {
@@ -609,10 +668,19 @@ public:
   int
   exec_buf(buffer_handle_type handle)
   {
+    cmd::check_exec_buf();
     cmd::add(handle);
     return 0;
   }
 
+  int
+  exec_buf(std::vector<buffer_handle_type> handles)
+  {
+    cmd::check_exec_buf();
+    cmd::add(std::move(handles));
+    return 0;
+  }
+
   int
   exec_wait(int msec)
   {
@@ -0,0 +1,622 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Register level mock of the AXI Quad SPI controller and its flash.
+//
+// XSPI_Flasher is run against a device whose register reads and writes
+// go to a model of the XSPI controller (control, status, slave select
+// and the TX/RX FIFOs) with a Micron style SPI NOR flash behind it.  The
+// flash decodes the commands used by the flasher (id, status, write
+// enable, extended address, 4KB/32KB/64KB erase, page program, reads)
+// and programming can only clear bits, as on a real part, so a missing
+// erase shows up as corrupted data.
+//
+// The run programs a random image and an update of it, with a fraction
+// of the 4KB subsectors modified, with the full flow and then with the
+// incremental flow (FLASH_INCREMENTAL), and checks after each pass that
+// the flash holds exactly the image.  Each pass
+// reports the number of erases, programmed and read bytes, register
+// accesses, and an estimate of the time the same operations take on a
+// card from typical flash timings.
+//
+// With -d the driver flow (flash device file) is run instead, with a
+// file standing in for the flash.
+
+#include "core/common/device.h"
+#include "core/common/ishim.h"
+#include "core/common/query_requests.h"
+#include "xbmgmt2/flash/xspi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+// Typical timings used for the estimate
+constexpr double reg_access_us = 1.0;       // PCIe register read or write
+constexpr double subsector_erase_ms = 50.0; // 4KB subsector erase
+constexpr double page_program_us = 200.0;   // page program
+
+constexpr uint32_t subsector_size = 0x1000;
+constexpr uint32_t bitstream_guard_size = 0x1000;
+
+struct stats
+{
+  uint64_t reg_accesses = 0;
+  uint64_t erases = 0;
+  uint64_t programs = 0;
+  uint64_t programmed_bytes = 0;
+  uint64_t read_bytes = 0;
+  uint64_t errors = 0;
+};
+
+// SPI NOR flash with 3 byte addresses and an extended address register
+// selecting the 16MB segment, like the Micron parts on the cards
+class spi_flash
+{
+  std::vector<uint8_t> m_mem;
+  std::vector<uint8_t> m_cmd;  // bytes of the current transaction
+  uint8_t m_ext_addr = 0;
+  bool m_wel = false;
+  stats& m_stats;
+
+  uint32_t
+  address() const
+  {
+    uint32_t addr = (m_ext_addr << 24) | (m_cmd[1] << 16) | (m_cmd[2] << 8) | m_cmd[3];
+    return addr % m_mem.size();
+  }
+
+  uint8_t
+  read_data(size_t header)
+  {
+    if (m_cmd.size() <= header)
+      return 0xff;
+    ++m_stats.read_bytes;
+    return m_mem[(address() + m_cmd.size() - header - 1) % m_mem.size()];
+  }
+
+  void
+  erase(uint32_t size)
+  {
+    uint32_t base = address() & ~(size - 1);
+    std::fill(m_mem.begin() + base, m_mem.begin() + base + size, 0xff);
+    ++m_stats.erases;
+  }
+
+  void
+  program()
+  {
+    // Data wraps around within the 256 byte page
+    uint32_t addr = address();
+    uint32_t page = addr & ~0xffu;
+    for (size_t i = 4; i < m_cmd.size(); ++i)
+      m_mem[page + ((addr + i - 4) & 0xff)] &= m_cmd[i];
+    ++m_stats.programs;
+    m_stats.programmed_bytes += m_cmd.size() - 4;
+  }
+
+public:
+  spi_flash(size_t size, stats& st)
+    : m_mem(size, 0xff), m_stats(st)
+  {}
+
+  std::vector<uint8_t>&
+  memory()
+  {
+    return m_mem;
+  }
+
+  // Shift one byte in, return the byte shifted out
+  uint8_t
+  transfer(uint8_t in)
+  {
+    static const uint8_t id[] = {0x20, 0xba, 0x19, 0x10}; // Micron, 256Mb
+    m_cmd.push_back(in);
+    size_t n = m_cmd.size() - 1;
+    if (n == 0)
+      return 0xff;
+
+    switch (m_cmd[0]) {
+    case 0x9f: // read id
+      return (n <= sizeof(id)) ? id[n - 1] : 0;
+    case 0x05: // status, never busy
+      return m_wel ? 0x02 : 0x00;
+    case 0x70: // flag status, ready
+      return 0x80;
+    case 0xc8: // extended address
+      return m_ext_addr;
+    case 0x03: // read
+      return read_data(4);
+    case 0x0b: // fast read
+      return read_data(5);
+    case 0x3b: // dual output fast read
+    case 0x6b: // quad output fast read
+      // The flasher counts the dummy cycles of the dual/quad reads
+      // as whole bytes of the transfer
+      return read_data(8);
+    default:
+      return 0xff;
+    }
+  }
+
+  // Chip select released, commit erase and program commands
+  void
+  deselect()
+  {
+    if (m_cmd.empty())
+      return;
+
+    uint8_t cmd = m_cmd[0];
+    bool needs_wel = (cmd == 0x20 || cmd == 0x52 || cmd == 0xd8 || cmd == 0xc7 ||
+                      cmd == 0x02 || cmd == 0x32 || cmd == 0xc5 || cmd == 0x01);
+    if (needs_wel && !m_wel) {
+      std::fprintf(stderr, "flash command 0x%02x without write enable\n", cmd);
+      ++m_stats.errors;
+    }
+    else if ((cmd == 0x20 || cmd == 0x52 || cmd == 0xd8 || cmd == 0x02 || cmd == 0x32) && m_cmd.size() < 4) {
+      std::fprintf(stderr, "flash command 0x%02x without address\n", cmd);
+      ++m_stats.errors;
+    }
+    else {
+      switch (cmd) {
+      case 0x06: m_wel = true; break;
+      case 0x04: m_wel = false; break;
+      case 0xc5: if (m_cmd.size() > 1) m_ext_addr = m_cmd[1]; break;
+      case 0x20: erase(0x1000); break;
+      case 0x52: erase(0x8000); break;
+      case 0xd8: erase(0x10000); break;
+      case 0xc7: std::fill(m_mem.begin(), m_mem.end(), 0xff); ++m_stats.erases; break;
+      case 0x02:
+      case 0x32: program(); break;
+      default: break;
+      }
+      if (needs_wel)
+        m_wel = false;
+    }
+    m_cmd.clear();
+  }
+};
+
+// AXI Quad SPI controller in standard master mode with FIFOs
+class xspi_controller
+{
+  static constexpr uint32_t SRR = 0x40, CR = 0x60, SR = 0x64, DTR = 0x68;
+  static constexpr uint32_t DRR = 0x6c, SSR = 0x70, TFO = 0x74, RFO = 0x78;
+  static constexpr uint32_t CR_ENABLE = 0x2, CR_TXFIFO_RESET = 0x20;
+  static constexpr uint32_t CR_RXFIFO_RESET = 0x40, CR_INHIBIT = 0x100;
+  static constexpr size_t fifo_depth = 256;
+
+  spi_flash& m_flash;
+  stats& m_stats;
+  uint32_t m_cr = 0x180;
+  uint32_t m_ssr = 0xffffffff;
+  std::deque<uint8_t> m_tx;
+  std::deque<uint8_t> m_rx;
+
+  bool
+  selected() const
+  {
+    return (m_ssr & 0x1) == 0;
+  }
+
+  void
+  shift()
+  {
+    if ((m_cr & CR_INHIBIT) || !(m_cr & CR_ENABLE) || !selected())
+      return;
+    while (!m_tx.empty()) {
+      uint8_t out = m_flash.transfer(m_tx.front());
+      m_tx.pop_front();
+      if (m_rx.size() < fifo_depth)
+        m_rx.push_back(out);
+      else
+        ++m_stats.errors;
+    }
+  }
+
+public:
+  xspi_controller(spi_flash& flash, stats& st)
+    : m_flash(flash), m_stats(st)
+  {}
+
+  uint32_t
+  read(uint32_t offset)
+  {
+    ++m_stats.reg_accesses;
+    switch (offset) {
+    case CR:
+      return m_cr;
+    case SR: {
+      uint32_t sr = 0;
+      if (m_rx.empty()) sr |= 0x1;
+      if (m_rx.size() >= fifo_depth) sr |= 0x2;
+      if (m_tx.empty()) sr |= 0x4;
+      if (m_tx.size() >= fifo_depth) sr |= 0x8;
+      return sr;
+    }
+    case DRR: {
+      if (m_rx.empty())
+        return 0;
+      uint8_t v = m_rx.front();
+      m_rx.pop_front();
+      return v;
+    }
+    case SSR:
+      return m_ssr;
+    case TFO:
+      return m_tx.empty() ? 0 : static_cast<uint32_t>(m_tx.size() - 1);
+    case RFO:
+      return m_rx.empty() ? 0 : static_cast<uint32_t>(m_rx.size() - 1);
+    default:
+      return 0;
+    }
+  }
+
+  void
+  write(uint32_t offset, uint32_t value)
+  {
+    ++m_stats.reg_accesses;
+    switch (offset) {
+    case SRR:
+      if (value == 0xa) {
+        m_cr = 0x180;
+        m_ssr = 0xffffffff;
+        m_tx.clear();
+        m_rx.clear();
+      }
+      break;
+    case CR:
+      if (value & CR_TXFIFO_RESET)
+        m_tx.clear();
+      if (value & CR_RXFIFO_RESET)
+        m_rx.clear();
+      m_cr = value & ~(CR_TXFIFO_RESET | CR_RXFIFO_RESET);
+      shift();
+      break;
+    case DTR:
+      if (m_tx.size() < fifo_depth)
+        m_tx.push_back(static_cast<uint8_t>(value));
+      else
+        ++m_stats.errors;
+      shift();
+      break;
+    case SSR: {
+      bool was_selected = selected();
+      m_ssr = value;
+      if (was_selected && !selected())
+        m_flash.deselect();
+      shift();
+      break;
+    }
+    default:
+      break;
+    }
+  }
+};
+
+// Device with the XSPI controller at the flash BAR offset.  The driver
+// flow opens a file standing in for the flash device node instead.
+class mock_device : public xrt_core::noshim<xrt_core::device>
+{
+  struct pcie_device : xrt_core::query::pcie_device
+  {
+    std::any
+    get(const xrt_core::device*) const override
+    {
+      return static_cast<result_type>(0x5000); // single flash card
+    }
+  };
+
+  mutable xspi_controller m_xspi;
+  std::FILE* m_file;
+
+public:
+  static constexpr uint64_t flash_base = 0x040000;
+
+  mock_device(spi_flash& flash, stats& st, std::FILE* file)
+    : xrt_core::noshim<xrt_core::device>(0), m_xspi(flash, st), m_file(file)
+  {}
+
+  handle_type
+  get_device_handle() const override
+  {
+    return nullptr;
+  }
+
+  void
+  read(uint64_t offset, void* buf, uint64_t len) const override
+  {
+    uint32_t value = m_xspi.read(static_cast<uint32_t>(offset - flash_base));
+    std::memcpy(buf, &value, std::min<uint64_t>(len, sizeof(value)));
+  }
+
+  void
+  write(uint64_t offset, const void* buf, uint64_t len) const override
+  {
+    uint32_t value = 0;
+    std::memcpy(&value, buf, std::min<uint64_t>(len, sizeof(value)));
+    m_xspi.write(static_cast<uint32_t>(offset - flash_base), value);
+  }
+
+  int
+  open(const std::string&, int) const override
+  {
+    return m_file ? dup(fileno(m_file)) : -1;
+  }
+
+  std::unique_ptr<xrt_core::buffer_handle>
+  alloc_bo(size_t, uint64_t) override
+  {
+    throw xrt_core::ishim::not_supported_error{__func__};
+  }
+
+  std::unique_ptr<xrt_core::buffer_handle>
+  alloc_bo(void*, size_t, uint64_t) override
+  {
+    throw xrt_core::ishim::not_supported_error{__func__};
+  }
+
+  std::unique_ptr<xrt_core::hwctx_handle>
+  create_hw_context(const xrt::uuid&, const xrt::hw_context::cfg_param_type&,
+                    xrt::hw_context::access_mode) const override
+  {
+    throw xrt_core::ishim::not_supported_error{__func__};
+  }
+
+private:
+  const xrt_core::query::request&
+  lookup_query(xrt_core::query::key_type key) const override
+  {
+    static const pcie_device device_query;
+    if (key == xrt_core::query::key_type::pcie_device)
+      return device_query;
+    throw xrt_core::query::no_such_key(key);
+  }
+};
+
+struct options
+{
+  size_t image_kb = 4096;
+  uint32_t address = 0x01002000;
+  double changed = 0.02;
+  uint64_t seed = 1;
+  bool driver = false;
+  bool verbose = false;
+};
+
+std::string
+to_mcs(const std::vector<uint8_t>& image, uint32_t address)
+{
+  std::ostringstream mcs;
+  char line[64];
+  uint32_t ela = UINT32_MAX;
+
+  auto record = [&](uint8_t len, uint16_t addr, uint8_t type, const uint8_t* data) {
+    uint8_t sum = len + (addr >> 8) + (addr & 0xff) + type;
+    int n = std::snprintf(line, sizeof(line), ":%02X%04X%02X", len, addr, type);
+    for (uint8_t i = 0; i < len; ++i) {
+      n += std::snprintf(line + n, sizeof(line) - n, "%02X", data[i]);
+      sum += data[i];
+    }
+    std::snprintf(line + n, sizeof(line) - n, "%02X", static_cast<uint8_t>(-sum));
+    mcs << line << "\n";
+  };
+
+  for (size_t i = 0; i < image.size(); i += 16) {
+    uint32_t addr = address + static_cast<uint32_t>(i);
+    if ((addr >> 16) != ela) {
+      ela = addr >> 16;
+      uint8_t ext[2] = {static_cast<uint8_t>(ela >> 8), static_cast<uint8_t>(ela)};
+      record(2, 0, 4, ext);
+    }
+    record(static_cast<uint8_t>(std::min<size_t>(16, image.size() - i)), addr & 0xffff, 0, image.data() + i);
+  }
+  record(0, 0, 1, nullptr);
+  return mcs.str();
+}
+
+struct pass_result
+{
+  stats st;
+  double wall_ms = 0;
+  bool ok = false;
+};
+
+pass_result
+run_pass(const options& opt, spi_flash& flash, stats& st, std::FILE* file,
+         const std::vector<uint8_t>& image, bool incremental)
+{
+  pass_result res;
+  st = stats();
+
+  if (incremental)
+    setenv("FLASH_INCREMENTAL", "1", 1);
+  else
+    unsetenv("FLASH_INCREMENTAL");
+  if (opt.driver)
+    unsetenv("FLASH_VIA_USER");
+  else
+    setenv("FLASH_VIA_USER", "1", 1);
+
+  std::stringstream mcs(to_mcs(image, opt.address));
+  std::istringstream stripped;
+  stripped.setstate(std::ios::failbit);
+
+  std::ostringstream quiet;
+  auto cout_buf = std::cout.rdbuf();
+  if (!opt.verbose)
+    std::cout.rdbuf(quiet.rdbuf());
+
+  auto start = std::chrono::steady_clock::now();
+  int ret = -1;
+  try {
+    auto dev = std::make_shared<mock_device>(flash, st, file);
+    XSPI_Flasher flasher(dev);
+    ret = flasher.xclUpgradeFirmware1(mcs, stripped);
+  }
+  catch (const std::exception& ex) {
+    std::fprintf(stderr, "flasher failed: %s\n", ex.what());
+  }
+  res.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout.rdbuf(cout_buf);
+
+  // Image below the bitstream guard, everything else erased
+  std::vector<uint8_t> expected(flash.memory().size(), 0xff);
+  std::copy(image.begin(), image.end(), expected.begin() + opt.address + bitstream_guard_size);
+  std::vector<uint8_t> actual = flash.memory();
+  if (opt.driver) {
+    actual.resize(expected.size());
+    if (std::fseek(file, 0, SEEK_SET) || std::fread(actual.data(), 1, actual.size(), file) != actual.size())
+      std::fprintf(stderr, "could not read back flash file\n");
+  }
+
+  res.st = st;
+  res.ok = (ret == 0 && st.errors == 0 && actual == expected);
+  if (ret)
+    std::fprintf(stderr, "flasher returned %d\n", ret);
+  if (actual != expected) {
+    auto diff = std::mismatch(actual.begin(), actual.end(), expected.begin());
+    std::fprintf(stderr, "flash differs from image at 0x%zx\n",
+                 static_cast<size_t>(diff.first - actual.begin()));
+  }
+  return res;
+}
+
+void
+report(const char* name, const pass_result& res, bool driver)
+{
+  double est_ms = res.st.reg_accesses * reg_access_us / 1000
+    + res.st.erases * subsector_erase_ms
+    + res.st.programs * page_program_us / 1000;
+
+  if (driver) {
+    std::printf("%-24s %8s %10.1f\n", name, res.ok ? "ok" : "FAILED", res.wall_ms);
+    return;
+  }
+  std::printf("%-24s %8s %8llu %12llu %12llu %12llu %10.1f %10.1f\n", name, res.ok ? "ok" : "FAILED",
+              static_cast<unsigned long long>(res.st.erases),
+              static_cast<unsigned long long>(res.st.programmed_bytes),
+              static_cast<unsigned long long>(res.st.read_bytes),
+              static_cast<unsigned long long>(res.st.reg_accesses),
+              est_ms / 1000, res.wall_ms);
+}
+
+void
+usage(const char* prog)
+{
+  std::printf("Usage: %s [options]\n", prog);
+  std::printf("  -s <KB>    image size (default 4096)\n");
+  std::printf("  -a <addr>  image address (default 0x01002000)\n");
+  std::printf("  -c <frac>  fraction of 4KB subsectors changed by the update (default 0.02)\n");
+  std::printf("  -d         run the driver flow on a flash file instead of the registers\n");
+  std::printf("  -v         show the flasher output\n");
+  std::printf("  -x <seed>  random seed\n");
+  std::printf("  -h         this help\n");
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  options opt;
+  int c;
+
+  while ((c = getopt(argc, argv, "s:a:c:dvx:h")) != -1) {
+    switch (c) {
+    case 's': opt.image_kb = std::strtoull(optarg, nullptr, 0); break;
+    case 'a': opt.address = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 0)); break;
+    case 'c': opt.changed = std::atof(optarg); break;
+    case 'd': opt.driver = true; break;
+    case 'v': opt.verbose = true; break;
+    case 'x': opt.seed = std::strtoull(optarg, nullptr, 0); break;
+    case 'h': usage(argv[0]); return 0;
+    default: usage(argv[0]); return 1;
+    }
+  }
+
+  const size_t flash_size = 32 << 20;
+  const size_t image_size = opt.image_kb * 1024;
+  if (!image_size || opt.address % subsector_size || opt.address == 0
+      || opt.address + bitstream_guard_size + image_size > flash_size
+      || opt.changed < 0 || opt.changed > 1) {
+    usage(argv[0]);
+    return 1;
+  }
+  if (opt.driver && opt.address != 0x01002000) {
+    std::fprintf(stderr, "the driver flow uses the fixed bitstream guard at 0x01002000\n");
+    return 1;
+  }
+
+  stats st;
+  spi_flash flash(flash_size, st);
+
+  std::FILE* file = nullptr;
+  if (opt.driver) {
+    file = std::tmpfile();
+    std::vector<uint8_t> erased(flash_size, 0xff);
+    if (!file || std::fwrite(erased.data(), 1, erased.size(), file) != erased.size()) {
+      std::fprintf(stderr, "could not create flash file\n");
+      return 1;
+    }
+    std::fflush(file);
+  }
+
+  std::mt19937_64 rng(opt.seed);
+  std::vector<uint8_t> image(image_size);
+  for (auto& b : image)
+    b = static_cast<uint8_t>(rng());
+
+  // The update changes a few bytes in some of the subsectors
+  std::vector<uint8_t> update = image;
+  std::bernoulli_distribution change(opt.changed);
+  size_t changed = 0;
+  for (size_t i = 0; i < update.size(); i += subsector_size) {
+    if (!change(rng))
+      continue;
+    size_t n = std::min<size_t>(subsector_size, update.size() - i);
+    for (int k = 0; k < 8; ++k)
+      update[i + rng() % n] ^= static_cast<uint8_t>(1 + rng() % 255);
+    ++changed;
+  }
+
+  std::printf("%s flow, %zu KB image @0x%x, update changes %zu of %zu subsectors\n\n",
+              opt.driver ? "driver" : "register", opt.image_kb, opt.address,
+              changed, (image_size + subsector_size - 1) / subsector_size);
+  if (opt.driver)
+    std::printf("%-24s %8s %10s\n", "pass", "result", "wall(ms)");
+  else
+    std::printf("%-24s %8s %8s %12s %12s %12s %10s %10s\n", "pass", "result", "erases",
+                "programmed", "read", "reg access", "est(s)", "wall(ms)");
+
+  bool ok = true;
+  auto pass = [&](const char* name, const std::vector<uint8_t>& img, bool incremental) {
+    auto res = run_pass(opt, flash, st, file, img, incremental);
+    report(name, res, opt.driver);
+    ok = ok && res.ok;
+  };
+
+  pass("full, image", image, false);
+  pass("full, update", update, false);
+  pass("full, image again", image, false);
+  pass("incremental, update", update, true);
+  pass("incremental, no change", update, true);
+
+  if (file)
+    std::fclose(file);
+  return ok ? 0 : 1;
+}
@@ -27,6 +27,7 @@
 #include <vector>
 #include <limits>
 #include <array>
+#include <algorithm>
 #include <fcntl.h>
 
 
@@ -66,6 +67,9 @@ uint32_t selected_sector = std::numeric_limits<uint32_t>::max();
 #define WRITE_DATA_SIZE 128
 #define READ_DATA_SIZE 128
 
+//Smallest erasable unit, COMMAND_4KB_SUBSECTOR_ERASE
+#define SUBSECTOR_SIZE 0x1000
+
 
 #define COMMAND_PAGE_PROGRAM            0x02 /* Page Program command */
 #define COMMAND_QUAD_WRITE              0x32 /* Quad Input Fast Program */
@@ -331,6 +335,10 @@ XSPI_Flasher::XSPI_Flasher(std::shared_ptr<xrt_core::device> dev)
             std::cout << "Failed to open flash device on card" << std::endl;
     }
 #endif
+
+    mIncremental = (std::getenv("FLASH_INCREMENTAL") != NULL);
+    if (mIncremental)
+        std::cout << boost::format("%-8s : %s\n") % "INFO" % "Incremental flashing, unchanged flash contents are skipped";
 }
 
 static bool isDualQSPI(xrt_core::device *dev) {
@@ -1418,7 +1426,7 @@ bool XSPI_Flasher::writePage(unsigned int Addr, uint8_t writeCmd)
 
 }
 
-bool XSPI_Flasher::readPage(unsigned int Addr, uint8_t readCmd)
+bool XSPI_Flasher::readPage(unsigned int Addr, uint8_t readCmd, uint8_t *data)
 {
     if(!isFlashReady())
         return false;
@@ -1480,6 +1488,10 @@ bool XSPI_Flasher::readPage(unsigned int Addr, uint8_t readCmd)
     if(!waitTxEmpty())
         return false;
 
+    //The page follows the command, address and dummy bytes.
+    if(data != NULL)
+        std::memcpy(data, &ReadBuffer[READ_WRITE_EXTRA_BYTES + ByteCount - READ_DATA_SIZE], READ_DATA_SIZE);
+
     //reset the RXFIFO bit so.
     ControlReg = XSpi_GetControlReg();
     ControlReg |= XSP_CR_RXFIFO_RESET_MASK ;
@@ -1681,6 +1693,20 @@ int XSPI_Flasher::programRecord(std::istream& mcsStream, const ELARecord& record
 
 int XSPI_Flasher::programXSpi(std::istream& mcsStream, uint32_t bitstream_shift_addr)
 {
+    if(mIncremental) {
+        //Subsectors shared by two records are only merged when the
+        //records are in address order, which is how MCS files are written.
+        bool ordered = true;
+        unsigned int prevEnd = 0;
+        for (const auto& record : recordList) {
+            if (record.mStartAddress < prevEnd)
+                ordered = false;
+            prevEnd = record.mEndAddress;
+        }
+        if (ordered)
+            return programXSpiIncremental(mcsStream, bitstream_shift_addr);
+        std::cout << boost::format("%-8s : %s\n") % "WARNING" % "MCS records are not in address order, programming the whole image";
+    }
 
     //Now we can safely erase all subsectors
     int beatCount = 0;
@@ -1743,6 +1769,126 @@ int XSPI_Flasher::programXSpi(std::istream& mcsStream, uint32_t bitstream_shift_
     return 0;
 }
 
+bool XSPI_Flasher::readFlash(unsigned int addr, uint8_t *buf, size_t len)
+{
+    assert(len % READ_DATA_SIZE == 0);
+    for (size_t i = 0; i < len; i += READ_DATA_SIZE) {
+        clearBuffers();
+        if(!readPage(addr + static_cast<unsigned int>(i), 0xff, buf + i))
+            return false;
+    }
+    clearBuffers();
+    return true;
+}
+
+//Read the data of an ELA record from the MCS stream
+int XSPI_Flasher::readRecord(std::istream& mcsStream, const ELARecord& record, std::vector<unsigned char>& data)
+{
+    data.clear();
+    data.reserve(record.mDataCount);
+    mcsStream.clear();
+    mcsStream.seekg(record.mDataPos, std::ios_base::beg);
+    while (data.size() < record.mDataCount) {
+        std::string line;
+        if (!std::getline(mcsStream, line))
+            return -EINVAL;
+        if (line.size() == 0)
+            continue;
+        const unsigned int dataLen = std::stoi(line.substr(1, 2), 0 , 16);
+        const unsigned int recordType = std::stoi(line.substr(7, 2), 0 , 16);
+        if (recordType != 0x00)
+            continue;
+        for (unsigned int i = 0; i < dataLen; ++i)
+            data.push_back(static_cast<unsigned char>(std::stoi(line.substr(9 + 2 * i, 2), 0, 16)));
+    }
+    return (data.size() == record.mDataCount) ? 0 : -EINVAL;
+}
+
+//Erase and program a subsector unless it already holds the data
+int XSPI_Flasher::updateSubsector(unsigned int addr, const std::vector<unsigned char>& data, uint64_t& skipped)
+{
+    std::vector<unsigned char> current(data.size());
+    if(!readFlash(addr, current.data(), current.size()))
+        return -ENXIO;
+    if (current == data) {
+        skipped += data.size();
+        return 0;
+    }
+
+    if(!sectorErase(addr, COMMAND_4KB_SUBSECTOR_ERASE))
+        return -EINVAL;
+    delay(std::chrono::microseconds(20));
+
+    unsigned char* buffer = &WriteBuffer[READ_WRITE_EXTRA_BYTES];
+    for (size_t page = 0; page < data.size(); page += WRITE_DATA_SIZE) {
+        //Erased pages already read back as 0xff
+        auto first = data.begin() + page;
+        if (std::all_of(first, first + WRITE_DATA_SIZE, [](unsigned char c) { return c == 0xff; }))
+            continue;
+
+        clearBuffers();
+        std::copy(first, first + WRITE_DATA_SIZE, buffer);
+        if(!writePage(addr + static_cast<unsigned int>(page)))
+            return -ENXIO;
+        delay(std::chrono::microseconds(20));
+    }
+    clearBuffers();
+    return 0;
+}
+
+//Same result as erasing and programming every record, but each 4KB
+//subsector covered by the image is read back first and only erased and
+//programmed when it differs. Bytes of a subsector outside of the image
+//are expected to be erased, as the full flow leaves them.
+int XSPI_Flasher::programXSpiIncremental(std::istream& mcsStream, uint32_t bitstream_shift_addr)
+{
+    std::vector<unsigned char> data;
+    std::vector<unsigned char> subsector(SUBSECTOR_SIZE, 0xff);
+    unsigned int subsectorAddr = UINT_MAX;
+    uint64_t total = 0;
+    uint64_t skipped = 0;
+
+    int beatCount = 0;
+    XBU::ProgressBar program_flash("Updating flash", static_cast<unsigned int>(recordList.size()), XBU::is_escape_codes_disabled(), std::cout);
+    for (auto& record : recordList) {
+        program_flash.update(++beatCount);
+
+        //Shift all write addresses below bitstream guard
+        record.mStartAddress += bitstream_shift_addr;
+        record.mEndAddress += bitstream_shift_addr;
+
+        if (readRecord(mcsStream, record, data)) {
+            program_flash.finish(false, "Could not read the block");
+            return -EINVAL;
+        }
+
+        for (size_t offset = 0; offset < data.size();) {
+            const unsigned int addr = record.mStartAddress + static_cast<unsigned int>(offset);
+            const unsigned int base = addr & ~(SUBSECTOR_SIZE - 1);
+            if (base != subsectorAddr) {
+                if (subsectorAddr != UINT_MAX && updateSubsector(subsectorAddr, subsector, skipped)) {
+                    program_flash.finish(false, "Could not update subsector");
+                    return -EINVAL;
+                }
+                subsectorAddr = base;
+                total += SUBSECTOR_SIZE;
+                std::fill(subsector.begin(), subsector.end(), 0xff);
+            }
+            const size_t len = std::min<size_t>(data.size() - offset, base + SUBSECTOR_SIZE - addr);
+            std::copy(data.begin() + offset, data.begin() + offset + len, subsector.begin() + (addr - base));
+            offset += len;
+        }
+    }
+    if (subsectorAddr != UINT_MAX && updateSubsector(subsectorAddr, subsector, skipped)) {
+        program_flash.finish(false, "Could not update subsector");
+        return -EINVAL;
+    }
+    program_flash.finish(true, "Flash programmed");
+
+    std::cout << boost::format("%-8s : Skipped %d of %d bytes already on flash\n") % "INFO" % skipped % total;
+    return 0;
+}
+
 bool XSPI_Flasher::readRegister(uint8_t commandCode, unsigned int bytes) {
 
     if(!isFlashReady())
@@ -2139,8 +2285,47 @@ static int mcsStreamToBin(std::istream& mcsStream, unsigned int& currentAddr,
     return 0;
 }
 
+// Write the parts of a flash page that differ from what is on flash,
+// compared and written per 4KB subsector with differing subsectors
+// merged into one write.
+static int writeChangedToFlash(std::FILE *flashDev, int index, unsigned int addr,
+    const unsigned char *buf, size_t len, uint64_t& skipped)
+{
+    std::vector<unsigned char> current(len);
+    int ret = readFromFlash(flashDev, index, addr, current.data(), len);
+    if (ret)
+        return ret;
+
+    size_t runStart = 0;
+    size_t runLen = 0;
+    auto flushRun = [&]() {
+        int err = 0;
+        if (runLen)
+            err = writeToFlash(flashDev, index, addr + static_cast<unsigned int>(runStart), buf + runStart, runLen);
+        runLen = 0;
+        return err;
+    };
+
+    for (size_t i = 0; i < len;) {
+        size_t n = SUBSECTOR_SIZE - ((addr + i) % SUBSECTOR_SIZE);
+        n = std::min(n, len - i);
+        if (std::memcmp(current.data() + i, buf + i, n) != 0) {
+            if (!runLen)
+                runStart = i;
+            runLen += n;
+        } else {
+            skipped += n;
+            ret = flushRun();
+            if (ret)
+                return ret;
+        }
+        i += n;
+    }
+    return flushRun();
+}
+
 static int writeBitstream(std::FILE *flashDev, int index, unsigned int addr,
-    std::vector<unsigned char>& buf)
+    std::vector<unsigned char>& buf, bool incremental, uint64_t& skipped)
 {
     int ret = 0;
     size_t len = 0;
@@ -2152,14 +2337,17 @@ static int writeBitstream(std::FILE *flashDev, int index, unsigned int addr,
         len = std::min(len, buf.size() - i);
 
         std::cout << "." << std::flush;
-        ret = writeToFlash(flashDev, index, addr + static_cast<unsigned int>(i), buf.data() + static_cast<unsigned int>(i), len);
+        if (incremental)
+            ret = writeChangedToFlash(flashDev, index, addr + static_cast<unsigned int>(i), buf.data() + i, len, skipped);
+        else
+            ret = writeToFlash(flashDev, index, addr + static_cast<unsigned int>(i), buf.data() + static_cast<unsigned int>(i), len);
     }
     std::cout << std::endl;
     return ret;
 }
 
 static int programXSpiDrv(xrt_core::device *dev, std::FILE *mFlashDev, std::istream& mcsStream,
-    int index, uint32_t addressShift)
+    int index, uint32_t addressShift, bool incremental)
 {
     // Parse MCS data and write each contiguous chunk to flash.
     std::vector<unsigned char> buf;
@@ -2168,6 +2356,8 @@ static int programXSpiDrv(xrt_core::device *dev, std::FILE *mFlashDev, std::istr
     unsigned int startAddr = 0;
     int ret;
     bool store = true;
+    uint64_t total = 0;
+    uint64_t skipped = 0;
 
     while (nextAddr != UINT_MAX) {
         std::cout << "Extracting bitstream from MCS data:" << std::endl;
@@ -2184,12 +2374,17 @@ static int programXSpiDrv(xrt_core::device *dev, std::FILE *mFlashDev, std::istr
         }
 
         std::cout << "Writing bitstream to flash " << index << ":" << std::endl;
-        ret = writeBitstream(mFlashDev, index, curAddr + addressShift, buf);
+        ret = writeBitstream(mFlashDev, index, curAddr + addressShift, buf, incremental, skipped);
         if (ret)
             return ret;
+        total += buf.size();
         curAddr = nextAddr;
     }
 
+    if (incremental)
+        std::cout << "Skipped " << skipped << " of " << total
+            << " bytes already on flash " << index << std::endl;
+
     // provide flash controller information to icap controller for webstar flow. Required only for U.2
     try {
         xrt_core::device_update<xrt_core::query::ic_load_flash_address>(dev, startAddr);
@@ -2205,7 +2400,7 @@ int XSPI_Flasher::upgradeFirmware1Drv(std::istream& mcsStream, std::istream& str
     uint32_t bsGuardAddr;
 
     if (mcsStreamIsGolden(mcsStream))
-        return programXSpiDrv(mDev.get(), mFlashDev, mcsStream, 0, 0);
+        return programXSpiDrv(mDev.get(), mFlashDev, mcsStream, 0, 0, mIncremental);
 
     ret = bitstreamGuardAddress(mDev.get(), bsGuardAddr);
     if (ret)
@@ -2228,7 +2423,7 @@ int XSPI_Flasher::upgradeFirmware1Drv(std::istream& mcsStream, std::istream& str
     }
 
     // Write MCS
-    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream, 0, bitstreamGuardSize);
+    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream, 0, bitstreamGuardSize, mIncremental);
     if (ret)
         return ret;
 
@@ -2243,10 +2438,10 @@ int XSPI_Flasher::upgradeFirmware2Drv(std::istream& mcsStream0,
     uint32_t bsGuardAddr = 0;
 
     if (mcsStreamIsGolden(mcsStream0)) {
-        ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream0, 0, 0);
+        ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream0, 0, 0, mIncremental);
         if (ret)
             return ret;
-        return programXSpiDrv(mDev.get(), mFlashDev, mcsStream1, 1, 0);
+        return programXSpiDrv(mDev.get(), mFlashDev, mcsStream1, 1, 0, mIncremental);
     }
 
     ret = bitstreamGuardAddress(mDev.get(), bsGuardAddr);
@@ -2270,10 +2465,10 @@ int XSPI_Flasher::upgradeFirmware2Drv(std::istream& mcsStream0,
     }
 
     // Write MCS
-    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream0, 0, bitstreamGuardSize);
+    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream0, 0, bitstreamGuardSize, mIncremental);
     if (ret)
         return ret;
-    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream1, 1, bitstreamGuardSize);
+    ret = programXSpiDrv(mDev.get(), mFlashDev, mcsStream1, 1, bitstreamGuardSize, mIncremental);
     if (ret)
         return ret;
 
@@ -19,6 +19,7 @@
 
 #include <list>
 #include <iostream>
+#include <vector>
 #include "core/common/system.h"
 #include "core/common/device.h"
 
@@ -47,6 +48,9 @@ class XSPI_Flasher
  private:
   std::shared_ptr<xrt_core::device> mDev;
   std::FILE *mFlashDev = nullptr;
+  // Only erase and program the parts of the image that differ from
+  // what is on flash, enabled with FLASH_INCREMENTAL
+  bool mIncremental = false;
 
   int parseMCS(std::istream& mcsStream);
 
@@ -65,10 +69,14 @@ class XSPI_Flasher
   bool getFlashId();
   bool finalTransfer(uint8_t *sendBufPtr, uint8_t *recvBufPtr, int byteCount);
   bool writePage(unsigned int addr, uint8_t writeCmd = 0xff);
-  bool readPage(unsigned int addr, uint8_t readCmd = 0xff);
+  bool readPage(unsigned int addr, uint8_t readCmd = 0xff, uint8_t *data = nullptr);
+  bool readFlash(unsigned int addr, uint8_t *buf, size_t len);
   bool prepareXSpi(uint8_t slave_sel);
   int programRecord(std::istream& mcsStream, const ELARecord& record);
   int programXSpi(std::istream& mcsStream, uint32_t bitstream_shift_addr);
+  int readRecord(std::istream& mcsStream, const ELARecord& record, std::vector<unsigned char>& data);
+  int updateSubsector(unsigned int addr, const std::vector<unsigned char>& data, uint64_t& skipped);
+  int programXSpiIncremental(std::istream& mcsStream, uint32_t bitstream_shift_addr);
   bool readRegister(uint8_t commandCode, unsigned int bytes);
   bool writeRegister(uint8_t commandCode, unsigned int value, unsigned int bytes);
   bool setSector(unsigned int address);
@@ -0,0 +1,604 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Host simulation of the ERT scheduler loop.
+//
+// The scheduler (scheduler.cpp built with ERT_HW_EMU) is linked
+// against a simulated register file instead of the MicroBlaze AXI-lite
+// peripherals.  The simulation provides the command queue, the ERT
+// CSRs, the interrupt controller, and mock CUs that complete a fixed
+// time (with optional jitter) after they are started.
+//
+// Time is simulated: every register access made by the scheduler costs
+// a configurable number of ns, and so does every slot visited by the
+// scheduler loop.  A mock host keeps a configurable number of commands
+// in flight, submitting a new command a configurable time after the
+// scheduler notified completion of the previous one.
+//
+// The run ends after the requested number of commands have completed,
+// and reports
+//  - commands/s in simulated time, i.e. the throughput of the firmware
+//    for the given register access cost and CU latency
+//  - slot-to-start latency, the time from the host writing a command
+//    to the command queue until the scheduler starts the CU
+//  - submit-to-complete latency, the time until the scheduler writes
+//    the command completion to the status register
+//  - register accesses per command and the wall clock rate of the
+//    simulation, which tracks the cost of the scheduler loop itself
+
+#include "core/include/ert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+using addr_type = uint32_t;
+using value_type = uint32_t;
+
+// Exported by scheduler.cpp when built with ERT_HW_EMU
+extern "C" void scheduler_loop();
+extern "C" void cu_interrupt_handler();
+
+namespace {
+
+// AXI-lite control register bits of HLS CUs
+constexpr value_type AP_START = 0x1;
+constexpr value_type AP_DONE  = 0x2;
+constexpr value_type AP_IDLE  = 0x4;
+
+// Mock CUs are placed outside of the ERT address ranges
+constexpr addr_type cu_region_base = 0x01000000;
+constexpr uint32_t cu_shift = 16;
+
+// First argument of the CU register map.  The host stores the slot
+// index in this argument, so a started CU can be traced back to the
+// command that started it regardless of the order in which the
+// scheduler visits the slots.
+constexpr addr_type cu_arg0_offset = 0x10;
+
+// Thrown from reg_access_wait() to leave the scheduler loop
+struct sim_done {};
+
+struct config
+{
+  uint32_t num_cus = 4;
+  uint32_t slot_size = 0x1000;
+  uint32_t num_args = 8;            // CU arguments in words
+  uint32_t depth = 0;               // commands in flight, 0 is all slots
+  uint64_t num_cmds = 100000;
+  uint64_t cu_latency_ns = 2000;
+  uint32_t cu_jitter_pct = 0;
+  uint64_t reg_ns = 100;            // cost of one register access
+  uint64_t loop_ns = 20;            // cost of visiting one slot
+  uint64_t host_ns = 1000;          // completion to next submission
+  bool cu_isr = false;
+  bool cq_int = false;
+  uint32_t seed = 1;
+};
+
+struct mock_cu
+{
+  addr_type addr = 0;
+  bool busy = false;
+  bool done = false;
+  uint64_t done_at = 0;
+  uint64_t busy_ns = 0;
+  uint32_t slot = 0;
+  uint32_t arg0 = 0;
+};
+
+struct command
+{
+  uint64_t submitted = 0;
+  uint64_t started = 0;
+};
+
+struct host_event
+{
+  uint64_t time;
+  uint32_t slot;
+};
+
+struct simulation
+{
+  config cfg;
+  std::mt19937 rng;
+
+  uint64_t now = 0;
+  uint64_t reg_accesses = 0;
+
+  // Command queue BRAM
+  std::vector<value_type> cq = std::vector<value_type>(ERT_CQ_SIZE / 4, 0);
+
+  // Everything else that is not modeled explicitly
+  std::unordered_map<addr_type, value_type> regs;
+
+  std::vector<mock_cu> cus;
+
+  // Interrupt controller and status registers
+  value_type intc_ipr = 0;
+  value_type intc_mer = 0;
+  bool mb_interrupts = false;
+  value_type cu_status[4] = {0};
+  value_type cq_status[4] = {0};
+
+  // Host side
+  bool configure_written = false;
+  bool configured = false;
+  uint32_t num_slots = 0;
+  uint32_t next_cu = 0;
+  uint64_t submitted = 0;
+  uint64_t completed = 0;
+  std::vector<command> commands;
+  std::deque<host_event> host_events;
+  std::vector<uint64_t> start_latency;
+  std::vector<uint64_t> complete_latency;
+
+  explicit
+  simulation(const config& c)
+    : cfg(c), rng(c.seed), cus(c.num_cus)
+  {
+    for (uint32_t i = 0; i < cfg.num_cus; ++i)
+      cus[i].addr = cu_region_base + (i << cu_shift);
+    start_latency.reserve(cfg.num_cmds);
+    complete_latency.reserve(cfg.num_cmds);
+  }
+
+  bool
+  in_cq(addr_type addr) const
+  {
+    return addr >= ERT_CQ_BASE_ADDR && addr < ERT_CQ_BASE_ADDR + ERT_CQ_SIZE;
+  }
+
+  value_type&
+  cq_word(addr_type addr)
+  {
+    return cq[(addr - ERT_CQ_BASE_ADDR) >> 2];
+  }
+
+  mock_cu*
+  find_cu(addr_type addr)
+  {
+    if (addr < cu_region_base)
+      return nullptr;
+    auto idx = (addr - cu_region_base) >> cu_shift;
+    return idx < cus.size() ? &cus[idx] : nullptr;
+  }
+
+  uint64_t
+  cu_duration()
+  {
+    if (!cfg.cu_jitter_pct)
+      return cfg.cu_latency_ns;
+    auto range = cfg.cu_latency_ns * cfg.cu_jitter_pct / 100;
+    std::uniform_int_distribution<uint64_t> dist(0, 2 * range);
+    return cfg.cu_latency_ns - range + dist(rng);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Host
+  ////////////////////////////////////////////////////////////////
+  void
+  write_configure()
+  {
+    // The configure command is picked up from slot 0 with the default
+    // slot size before the scheduler knows the real one
+    configure_written = true;
+    auto slot = ERT_CQ_BASE_ADDR;
+    auto pkt_words = 6 + cfg.num_cus;
+    std::vector<value_type> pkt(pkt_words, 0);
+    auto ecmd = reinterpret_cast<ert_configure_cmd*>(pkt.data());
+    ecmd->state = ERT_CMD_STATE_NEW;
+    ecmd->count = pkt_words - 1;
+    ecmd->opcode = ERT_CONFIGURE;
+    ecmd->type = ERT_CTRL;
+    ecmd->slot_size = cfg.slot_size;
+    ecmd->num_cus = cfg.num_cus;
+    ecmd->cu_shift = cu_shift;
+    ecmd->cu_base_addr = cu_region_base;
+    ecmd->ert = 1;
+    ecmd->cu_isr = cfg.cu_isr;
+    ecmd->cq_int = cfg.cq_int;
+    for (uint32_t i = 0; i < cfg.num_cus; ++i)
+      ecmd->data[i] = cus[i].addr;   // AP_CTRL_HS handshake
+
+    for (uint32_t i = pkt_words; i-- > 0;)
+      cq_word(slot + i * 4) = pkt[i];
+  }
+
+  void
+  submit(uint32_t slot_idx)
+  {
+    auto slot = ERT_CQ_BASE_ADDR + slot_idx * cfg.slot_size;
+    auto regmap_words = 4 + cfg.num_args;
+    auto cu_idx = next_cu++ % cfg.num_cus;
+
+    // Payload first, the header makes the command visible
+    cq_word(slot + 4) = cu_idx;
+    for (uint32_t i = 0; i < regmap_words; ++i)
+      cq_word(slot + 8 + i * 4) = (i == cu_arg0_offset / 4) ? slot_idx : i;
+
+    ert_start_kernel_cmd ecmd = {};
+    ecmd.state = ERT_CMD_STATE_NEW;
+    ecmd.count = 1 + regmap_words;
+    ecmd.opcode = ERT_START_CU;
+    ecmd.type = ERT_CU;
+    cq_word(slot) = ecmd.header;
+
+    if (cfg.cq_int) {
+      cq_status[slot_idx >> 5] |= 1u << (slot_idx & 31);
+      intc_ipr |= 0x1;
+    }
+
+    commands[slot_idx].submitted = now;
+    ++submitted;
+  }
+
+  void
+  on_configured()
+  {
+    configured = true;
+    num_slots = ERT_CQ_SIZE / cfg.slot_size;
+    commands.resize(num_slots);
+
+    // Slot 0 is reserved for control commands as in KDS
+    uint32_t depth = cfg.depth ? std::min(cfg.depth, num_slots - 1) : num_slots - 1;
+    for (uint32_t slot_idx = 1; slot_idx <= depth && submitted < cfg.num_cmds; ++slot_idx)
+      submit(slot_idx);
+  }
+
+  void
+  on_notify(uint32_t slot_idx)
+  {
+    if (!configured) {
+      on_configured();
+      return;
+    }
+
+    auto& cmd = commands[slot_idx];
+    complete_latency.push_back(now - cmd.submitted);
+    ++completed;
+
+    if (submitted < cfg.num_cmds)
+      host_events.push_back({now + cfg.host_ns, slot_idx});
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Time
+  ////////////////////////////////////////////////////////////////
+  void
+  advance(uint64_t ns)
+  {
+    now += ns;
+
+    // Completion notifications arrive in time order and the host delay
+    // is constant, so host events are ordered too
+    while (!host_events.empty() && host_events.front().time <= now) {
+      submit(host_events.front().slot);
+      host_events.pop_front();
+    }
+
+    for (uint32_t i = 0; i < cus.size(); ++i) {
+      auto& cu = cus[i];
+      if (!cu.busy || cu.done_at > now)
+        continue;
+      cu.busy = false;
+      cu.done = true;
+      if (cfg.cu_isr) {
+        cu_status[i >> 5] |= 1u << (i & 31);
+        intc_ipr |= 0x2;
+      }
+    }
+  }
+
+  void
+  start_cu(mock_cu& cu)
+  {
+    auto slot_idx = cu.arg0;
+    auto duration = cu_duration();
+    cu.busy = true;
+    cu.done = false;
+    cu.done_at = now + duration;
+    cu.busy_ns += duration;
+    cu.slot = slot_idx;
+
+    auto& cmd = commands[slot_idx];
+    cmd.started = now;
+    start_latency.push_back(now - cmd.submitted);
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // Register file seen by the scheduler
+  ////////////////////////////////////////////////////////////////
+  value_type
+  read(addr_type addr)
+  {
+    ++reg_accesses;
+    advance(cfg.reg_ns);
+
+    if (in_cq(addr))
+      return cq_word(addr);
+
+    if (auto cu = find_cu(addr)) {
+      if ((addr & ((1 << cu_shift) - 1)) != 0)
+        return regs[addr];
+      if (cu->busy)
+        return AP_START;
+      if (cu->done && !cfg.cu_isr) {
+        cu->done = false;       // ap_done is clear on read
+        return AP_DONE | AP_IDLE;
+      }
+      return AP_IDLE;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      if (addr == ERT_CU_STATUS_REGISTER_ADDR0 + i * 4) {
+        auto val = cu_status[i];   // clear on read
+        cu_status[i] = 0;
+        return val;
+      }
+      if (addr == ERT_CQ_STATUS_REGISTER_ADDR0 + i * 4) {
+        auto val = cq_status[i];   // clear on read
+        cq_status[i] = 0;
+        return val;
+      }
+      if (addr == ERT_STATUS_REGISTER_ADDR0 + i * 4)
+        return 0;
+    }
+
+    if (addr == ERT_INTC_IPR_ADDR)
+      return intc_ipr;
+    if (addr == ERT_INTC_MER_ADDR)
+      return intc_mer;
+    if (addr == ERT_CUDMA_STATE || addr == ERT_CUISR_STATE)
+      return ERT_HLS_MODULE_IDLE;
+
+    return regs[addr];
+  }
+
+  void
+  write(addr_type addr, value_type val)
+  {
+    ++reg_accesses;
+    advance(cfg.reg_ns);
+
+    if (in_cq(addr)) {
+      cq_word(addr) = val;
+      return;
+    }
+
+    if (auto cu = find_cu(addr)) {
+      auto offset = addr & ((1 << cu_shift) - 1);
+      if (offset == 0 && (val & AP_START))
+        start_cu(*cu);
+      else if (offset == cu_arg0_offset)
+        cu->arg0 = val;
+      regs[addr] = val;
+      return;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      if (addr == ERT_STATUS_REGISTER_ADDR0 + i * 4) {
+        // notify_host() writes 1<<slot_idx which wraps at 32
+        for (uint32_t bit = 0; bit < 32; ++bit)
+          if (val & (1u << bit))
+            on_notify(i * 32 + bit);
+        return;
+      }
+    }
+
+    if (addr == ERT_INTC_IAR_ADDR) {
+      intc_ipr &= ~val;
+      return;
+    }
+    if (addr == ERT_INTC_MER_ADDR) {
+      intc_mer = val;
+      return;
+    }
+
+    regs[addr] = val;
+  }
+
+  // Called by the scheduler loop before visiting each slot.  This is
+  // where interrupts are delivered and where the simulation ends.
+  void
+  loop_tick()
+  {
+    advance(cfg.loop_ns);
+
+    // The initial setup() clears the command queue, so the host
+    // configures the scheduler once the loop is running
+    if (!configure_written)
+      write_configure();
+
+    if (mb_interrupts && (intc_mer & 0x3) == 0x3) {
+      // Completions may arrive while the handler runs
+      while (intc_ipr & (cfg.cu_isr ? 0x3 : 0x1)) {
+        auto ipr = intc_ipr;
+        cu_interrupt_handler();
+        if (intc_ipr == ipr)
+          break;
+      }
+    }
+
+    if (completed >= cfg.num_cmds)
+      throw sim_done();
+  }
+};
+
+simulation* sim = nullptr;
+
+uint64_t
+percentile(std::vector<uint64_t>& v, double p)
+{
+  if (v.empty())
+    return 0;
+  auto idx = std::min(v.size() - 1, static_cast<size_t>(p * v.size()));
+  std::nth_element(v.begin(), v.begin() + idx, v.end());
+  return v[idx];
+}
+
+double
+mean(const std::vector<uint64_t>& v)
+{
+  if (v.empty())
+    return 0;
+  double sum = 0;
+  for (auto val : v)
+    sum += val;
+  return sum / v.size();
+}
+
+void
+print_latency(const char* name, std::vector<uint64_t>& v)
+{
+  auto avg = mean(v);
+  auto p50 = percentile(v, 0.50);
+  auto p99 = percentile(v, 0.99);
+  auto max = v.empty() ? 0 : *std::max_element(v.begin(), v.end());
+  std::printf("%-26s mean %8.0f  p50 %8lu  p99 %8lu  max %8lu (ns)\n", name,
+              avg,
+              static_cast<unsigned long>(p50),
+              static_cast<unsigned long>(p99),
+              static_cast<unsigned long>(max));
+}
+
+void
+usage(const char* prog)
+{
+  std::printf("Usage: %s [options]\n", prog);
+  std::printf("  -c <num>   number of CUs (default 4)\n");
+  std::printf("  -n <num>   number of commands (default 100000)\n");
+  std::printf("  -s <size>  command queue slot size in bytes (default 4096)\n");
+  std::printf("  -a <num>   CU arguments in words (default 8)\n");
+  std::printf("  -d <num>   commands in flight, 0 for all slots (default 0)\n");
+  std::printf("  -l <ns>    CU latency (default 2000)\n");
+  std::printf("  -j <pct>   CU latency jitter in percent (default 0)\n");
+  std::printf("  -r <ns>    cost of a register access (default 100)\n");
+  std::printf("  -o <ns>    cost of visiting a slot in the loop (default 20)\n");
+  std::printf("  -t <ns>    host time from completion to next submission (default 1000)\n");
+  std::printf("  -i         use CU interrupts instead of polling\n");
+  std::printf("  -q         use command queue interrupts instead of polling\n");
+  std::printf("  -x <seed>  random seed\n");
+  std::printf("  -h         this help\n");
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////
+// Platform hooks used by scheduler.cpp in ERT_HW_EMU builds
+////////////////////////////////////////////////////////////////
+value_type
+read_reg(addr_type addr)
+{
+  return sim->read(addr);
+}
+
+void
+write_reg(addr_type addr, value_type val)
+{
+  sim->write(addr, val);
+}
+
+void
+microblaze_enable_interrupts()
+{
+  sim->mb_interrupts = true;
+}
+
+void
+microblaze_disable_interrupts()
+{
+  sim->mb_interrupts = false;
+}
+
+void
+reg_access_wait()
+{
+  sim->loop_tick();
+}
+
+int
+main(int argc, char* argv[])
+{
+  config cfg;
+  int opt;
+  while ((opt = getopt(argc, argv, "c:n:s:a:d:l:j:r:o:t:iqx:h")) != -1) {
+    switch (opt) {
+    case 'c': cfg.num_cus = std::strtoul(optarg, nullptr, 0); break;
+    case 'n': cfg.num_cmds = std::strtoull(optarg, nullptr, 0); break;
+    case 's': cfg.slot_size = std::strtoul(optarg, nullptr, 0); break;
+    case 'a': cfg.num_args = std::strtoul(optarg, nullptr, 0); break;
+    case 'd': cfg.depth = std::strtoul(optarg, nullptr, 0); break;
+    case 'l': cfg.cu_latency_ns = std::strtoull(optarg, nullptr, 0); break;
+    case 'j': cfg.cu_jitter_pct = std::strtoul(optarg, nullptr, 0); break;
+    case 'r': cfg.reg_ns = std::strtoull(optarg, nullptr, 0); break;
+    case 'o': cfg.loop_ns = std::strtoull(optarg, nullptr, 0); break;
+    case 't': cfg.host_ns = std::strtoull(optarg, nullptr, 0); break;
+    case 'i': cfg.cu_isr = true; break;
+    case 'q': cfg.cq_int = true; break;
+    case 'x': cfg.seed = std::strtoul(optarg, nullptr, 0); break;
+    case 'h': usage(argv[0]); return 0;
+    default: usage(argv[0]); return 1;
+    }
+  }
+
+  // The slot must hold the header, the CU index, and the register map
+  auto slot_words = cfg.slot_size / 4;
+  if (cfg.num_cus < 1 || cfg.num_cus > 128 || cfg.num_cmds < 1
+      || cfg.slot_size < 0x100 || (cfg.slot_size & (cfg.slot_size - 1))
+      || ERT_CQ_SIZE / cfg.slot_size > 128 || ERT_CQ_SIZE / cfg.slot_size < 2
+      || cfg.num_args < 1 || 6 + cfg.num_args > slot_words
+      || cfg.cu_jitter_pct > 100) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  simulation s(cfg);
+  sim = &s;
+
+  auto wall_start = std::chrono::steady_clock::now();
+  try {
+    scheduler_loop();
+  }
+  catch (const sim_done&) {
+  }
+  std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+
+  double sim_sec = s.now / 1e9;
+  uint64_t cu_busy_ns = 0;
+  for (auto& cu : s.cus)
+    cu_busy_ns += cu.busy_ns;
+
+  std::printf("%u CUs, %u slots, CU latency %luns (+/-%u%%), register access %luns, "
+              "slot visit %luns, host turnaround %luns, %s, %s\n\n",
+              cfg.num_cus, s.num_slots,
+              static_cast<unsigned long>(cfg.cu_latency_ns), cfg.cu_jitter_pct,
+              static_cast<unsigned long>(cfg.reg_ns),
+              static_cast<unsigned long>(cfg.loop_ns),
+              static_cast<unsigned long>(cfg.host_ns),
+              cfg.cu_isr ? "CU interrupts" : "CU polling",
+              cfg.cq_int ? "CQ interrupts" : "CQ polling");
+  std::printf("%-26s %lu\n", "commands", static_cast<unsigned long>(s.completed));
+  std::printf("%-26s %.3f ms\n", "simulated time", sim_sec * 1e3);
+  std::printf("%-26s %.0f\n", "commands/s", s.completed / sim_sec);
+  std::printf("%-26s %.1f%%\n", "CU utilization",
+              100.0 * cu_busy_ns / (static_cast<double>(s.now) * cfg.num_cus));
+  std::printf("%-26s %.1f\n", "register accesses/command",
+              static_cast<double>(s.reg_accesses) / s.completed);
+  print_latency("slot-to-start latency", s.start_latency);
+  print_latency("submit-to-complete latency", s.complete_latency);
+  std::printf("%-26s %.0f commands/s (wall clock)\n", "simulation rate",
+              s.completed / wall.count());
+  return 0;
+}
@@ -11,11 +11,14 @@
 
 namespace xrt::core::hip {
 
-static command_handle hip_event_create()
+static command_handle hip_event_create(unsigned int flags)
 {
+  constexpr unsigned int supported_flags = hipEventDefault | hipEventBlockingSync | hipEventDisableTiming;
+  throw_invalid_value_if(flags & ~supported_flags, "Invalid flags passed for event creation");
+
   // Event when created doesn't have any stream associated with it
   // It is pushed into stream when recorded
-  return insert_in_map(command_cache, std::make_shared<event>());
+  return insert_in_map(command_cache, std::make_shared<event>(flags));
 }
 
 static void hip_event_destroy(hipEvent_t eve)
@@ -27,12 +30,14 @@ static void hip_event_destroy(hipEvent_t eve)
 static void hip_event_record(hipEvent_t eve, hipStream_t stream)
 {
   throw_invalid_value_if(!eve, "event passed is nullptr");
-  throw_invalid_value_if(!stream, "stream passed is nullptr");
-  /* TODO
+  // null stream is the legacy default stream
   auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  throw_if(hip_stream->get_capture_graph() != nullptr, hipErrorStreamCaptureUnsupported,
+           "stream is capturing");
   auto hip_ev = std::dynamic_pointer_cast<event>(command_cache.get(eve));
-  hip_ev->record(hip_stream);
-  */
+  throw_invalid_handle_if(!hip_ev, "event passed is invalid");
+  hip_stream->enqueue_event(hip_ev->record(hip_stream));
 }
 
 static void hip_event_synchronize(hipEvent_t eve)
@@ -51,6 +56,11 @@ static float hip_event_elapsed_time(hipEvent_t start, hipEvent_t stop)
   throw_invalid_value_if(!hip_ev_start, "dynamic_pointer_cast failed");
   auto hip_ev_stop = std::dynamic_pointer_cast<event>(command_cache.get(stop));
   throw_invalid_value_if(!hip_ev_stop, "dynamic_pointer_cast failed");
+  throw_invalid_handle_if(!hip_ev_start->is_recorded() || !hip_ev_stop->is_recorded(),
+                          "event passed is not recorded");
+  throw_invalid_handle_if((hip_ev_start->get_flags() | hip_ev_stop->get_flags()) & hipEventDisableTiming,
+                          "event created with hipEventDisableTiming");
+  throw_if(!hip_ev_start->query() || !hip_ev_stop->query(), hipErrorNotReady, "event not completed");
   return hip_ev_start->elapsed_time(hip_ev_stop);
 }
 
@@ -71,7 +81,26 @@ hipError_t hipEventCreate(hipEvent_t* event)
   try {
     throw_invalid_value_if(!event, "event passed is nullptr");
 
-    auto handle = xrt::core::hip::hip_event_create();
+    auto handle = xrt::core::hip::hip_event_create(hipEventDefault);
+    *event = reinterpret_cast<hipEvent_t>(handle);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t hipEventCreateWithFlags(hipEvent_t* event, unsigned int flags)
+{
+  try {
+    throw_invalid_value_if(!event, "event passed is nullptr");
+
+    auto handle = xrt::core::hip::hip_event_create(flags);
     *event = reinterpret_cast<hipEvent_t>(handle);
     return hipSuccess;
   }
@@ -125,7 +154,6 @@ hipError_t hipEventRecord(hipEvent_t event, hipStream_t stream)
 {
   try {
     throw_invalid_value_if(!event, "event passed is nullptr");
-    throw_invalid_value_if(!stream, "stream passed is nullptr");
 
     xrt::core::hip::hip_event_record(event, stream);
     return hipSuccess;
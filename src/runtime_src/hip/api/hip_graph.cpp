@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Device, Inc. All rights reserved.
+
+#include "core/common/error.h"
+
+#include "hip/config.h"
+#include "hip/hip_runtime_api.h"
+
+#include "hip/core/common.h"
+#include "hip/core/event.h"
+#include "hip/core/graph.h"
+#include "hip/core/stream.h"
+
+namespace xrt::core::hip {
+
+// Capture only supports streams created by the application, the
+// null stream implicitly synchronizes with other streams
+static std::shared_ptr<stream>
+get_capture_stream(hipStream_t stream)
+{
+  throw_if(!stream, hipErrorStreamCaptureUnsupported, "capture is not supported on null stream");
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  return hip_stream;
+}
+
+static void
+hip_stream_begin_capture(hipStream_t stream, hipStreamCaptureMode mode)
+{
+  throw_invalid_value_if(mode != hipStreamCaptureModeGlobal &&
+                         mode != hipStreamCaptureModeThreadLocal &&
+                         mode != hipStreamCaptureModeRelaxed,
+                         "invalid capture mode");
+  auto hip_stream = get_capture_stream(stream);
+  auto hip_graph = std::make_shared<graph>();
+  hip_stream->begin_capture(hip_graph);
+  insert_in_map(graph_cache, std::move(hip_graph));
+}
+
+static graph_handle
+hip_stream_end_capture(hipStream_t stream)
+{
+  auto hip_stream = get_capture_stream(stream);
+  return hip_stream->end_capture().get();
+}
+
+static hipStreamCaptureStatus
+hip_stream_is_capturing(hipStream_t stream)
+{
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  return hip_stream->get_capture_graph()
+    ? hipStreamCaptureStatusActive
+    : hipStreamCaptureStatusNone;
+}
+
+static graph_exec_handle
+hip_graph_instantiate(hipGraph_t g)
+{
+  throw_invalid_value_if(!g, "graph is nullptr");
+  auto hip_graph = graph_cache.get(g);
+  throw_invalid_value_if(!hip_graph, "graph is invalid");
+  return insert_in_map(graph_exec_cache, std::make_shared<graph_exec>(hip_graph->get_nodes()));
+}
+
+static bool
+hip_graph_exec_update(hipGraphExec_t exec, hipGraph_t g)
+{
+  throw_invalid_value_if(!exec, "graph exec is nullptr");
+  throw_invalid_value_if(!g, "graph is nullptr");
+  auto hip_exec = graph_exec_cache.get(exec);
+  throw_invalid_value_if(!hip_exec, "graph exec is invalid");
+  auto hip_graph = graph_cache.get(g);
+  throw_invalid_value_if(!hip_graph, "graph is invalid");
+  return hip_exec->update(hip_graph->get_nodes());
+}
+
+static void
+hip_graph_launch(hipGraphExec_t exec, hipStream_t stream)
+{
+  throw_invalid_value_if(!exec, "graph exec is nullptr");
+  auto hip_exec = graph_exec_cache.get(exec);
+  throw_invalid_value_if(!hip_exec, "graph exec is invalid");
+
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  throw_if(hip_stream->get_capture_graph() != nullptr, hipErrorStreamCaptureUnsupported,
+           "graph launch in capturing stream is not supported");
+
+  // The graph executes in stream order like a copy, holding on to
+  // the executable graph in case it is destroyed before completion
+  auto s_hdl = hip_stream.get();
+  auto cmd_hdl = insert_in_map(command_cache,
+                               std::make_shared<copy_buffer>(hip_stream, [hip_exec] {
+                                 hip_exec->execute();
+                               }));
+  s_hdl->enqueue(command_cache.get(cmd_hdl));
+}
+
+static void
+hip_graph_destroy(hipGraph_t g)
+{
+  throw_invalid_value_if(!g, "graph is nullptr");
+  graph_cache.remove(g);
+}
+
+static void
+hip_graph_exec_destroy(hipGraphExec_t exec)
+{
+  throw_invalid_value_if(!exec, "graph exec is nullptr");
+  graph_exec_cache.remove(exec);
+}
+} // xrt::core::hip
+
+// =========================================================================
+// Graph related apis implementation
+hipError_t
+hipStreamBeginCapture(hipStream_t stream, hipStreamCaptureMode mode)
+{
+  try {
+    xrt::core::hip::hip_stream_begin_capture(stream, mode);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipStreamEndCapture(hipStream_t stream, hipGraph_t* pGraph)
+{
+  try {
+    throw_invalid_value_if(!pGraph, "graph passed is nullptr");
+
+    auto handle = xrt::core::hip::hip_stream_end_capture(stream);
+    *pGraph = reinterpret_cast<hipGraph_t>(handle);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipStreamIsCapturing(hipStream_t stream, hipStreamCaptureStatus* pCaptureStatus)
+{
+  try {
+    throw_invalid_value_if(!pCaptureStatus, "capture status passed is nullptr");
+
+    *pCaptureStatus = xrt::core::hip::hip_stream_is_capturing(stream);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphInstantiate(hipGraphExec_t* pGraphExec, hipGraph_t graph,
+                    hipGraphNode_t* /*pErrorNode*/, char* /*pLogBuffer*/, size_t /*bufferSize*/)
+{
+  try {
+    throw_invalid_value_if(!pGraphExec, "graph exec passed is nullptr");
+
+    auto handle = xrt::core::hip::hip_graph_instantiate(graph);
+    *pGraphExec = reinterpret_cast<hipGraphExec_t>(handle);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
+                   hipGraphNode_t* hErrorNode_out, hipGraphExecUpdateResult* updateResult_out)
+{
+  try {
+    throw_invalid_value_if(!updateResult_out, "update result passed is nullptr");
+    if (hErrorNode_out)
+      *hErrorNode_out = nullptr;
+
+    if (!xrt::core::hip::hip_graph_exec_update(hGraphExec, hGraph)) {
+      *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
+      return hipErrorGraphExecUpdateFailure;
+    }
+    *updateResult_out = hipGraphExecUpdateSuccess;
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphLaunch(hipGraphExec_t graphExec, hipStream_t stream)
+{
+  try {
+    xrt::core::hip::hip_graph_launch(graphExec, stream);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphDestroy(hipGraph_t graph)
+{
+  try {
+    xrt::core::hip::hip_graph_destroy(graph);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphExecDestroy(hipGraphExec_t graphExec)
+{
+  try {
+    xrt::core::hip::hip_graph_exec_destroy(graphExec);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
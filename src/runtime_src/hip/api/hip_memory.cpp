@@ -3,11 +3,14 @@
 
 #include <string>
 #include "core/common/error.h"
-#include "core/common/unistd.h"
 #include "hip/config.h"
+#include "hip/core/common.h"
 #include "hip/core/device.h"
 #include "hip/core/context.h"
+#include "hip/core/event.h"
+#include "hip/core/graph.h"
 #include "hip/core/memory.h"
+#include "hip/core/stream.h"
 #include "hip/hip_runtime_api.h"
 
 namespace xrt::core::hip
@@ -200,19 +203,115 @@ namespace xrt::core::hip
     };
   }
 
+  // Offset of addr in hip memory, addr is either the host or the
+  // device address of the memory
+  static size_t
+  get_offset(const std::shared_ptr<const memory>& hip_mem, const void* addr)
+  {
+    auto ptr = reinterpret_cast<uint64_t>(addr);
+    auto host = reinterpret_cast<uint64_t>(hip_mem->get_address());
+    if (ptr >= host && ptr < host + hip_mem->get_size())
+      return ptr - host;
+
+    return ptr - reinterpret_cast<uint64_t>(hip_mem->get_device_address());
+  }
+
+  static std::shared_ptr<memory>
+  get_fill_memory(void* dst, size_t size, size_t& offset)
+  {
+    auto hip_mem = memory_database::instance().get_hip_mem_from_addr(dst);
+    throw_invalid_value_if(!hip_mem, "Invalid destination handle in hipMemset");
+    offset = get_offset(hip_mem, dst);
+    throw_invalid_value_if(offset + size > static_cast<size_t>(hip_mem->get_size()),
+                           "hipMemset range exceeds memory size");
+    return hip_mem;
+  }
+
   // fill data to dst.
   static void
   hip_memset(void* dst, int value, size_t size)
   {
-    auto hip_mem = memory_database::instance().get_hip_mem_from_addr(dst);
-    assert(hip_mem->get_type() != xrt::core::hip::memory_type::invalid);
+    size_t offset = 0;
+    auto hip_mem = get_fill_memory(dst, size, offset);
+    hip_mem->fill(static_cast<unsigned char>(value), size, offset);
+  }
 
-    auto host_src = aligned_alloc(xrt_core::getpagesize(), size);
-    memset(host_src, value, size);
+  // Resolve the memories of a copy when it is enqueued, the transfer
+  // runs later on the stream and keeps the memories alive until done
+  static copy_buffer::transfer_fn
+  get_memcpy_transfer(void* dst, const void* src, size_t size, hipMemcpyKind kind)
+  {
+    switch (kind)
+    {
+      case hipMemcpyHostToDevice: {
+        auto hip_mem = memory_database::instance().get_hip_mem_from_addr(dst);
+        throw_invalid_value_if(!hip_mem, "Invalid destination handle in hipMemcpyAsync");
+        auto offset = get_offset(hip_mem, dst);
+        return [hip_mem, src, size, offset] { hip_mem->write(src, size, 0, offset); };
+      }
+
+      case hipMemcpyDeviceToHost: {
+        auto hip_mem = memory_database::instance().get_hip_mem_from_addr(src);
+        throw_invalid_value_if(!hip_mem, "Invalid src handle in hipMemcpyAsync");
+        auto offset = get_offset(hip_mem, src);
+        return [hip_mem, dst, size, offset] { hip_mem->read(dst, size, 0, offset); };
+      }
+
+      case hipMemcpyDeviceToDevice: {
+        auto dst_mem = memory_database::instance().get_hip_mem_from_addr(dst);
+        throw_invalid_value_if(!dst_mem, "Invalid destination handle in hipMemcpyAsync");
+        auto src_mem = memory_database::instance().get_hip_mem_from_addr(src);
+        throw_invalid_value_if(!src_mem, "Invalid src handle in hipMemcpyAsync");
+        auto dst_offset = get_offset(dst_mem, dst);
+        auto src_offset = get_offset(src_mem, src);
+        return [dst_mem, src_mem, size, dst_offset, src_offset] {
+          dst_mem->get_xrt_bo()->copy(*src_mem->get_xrt_bo(), size, src_offset, dst_offset);
+        };
+      }
 
-    hip_mem->write(host_src, size);
+      case hipMemcpyHostToHost:
+        return [dst, src, size] { hip_memcpy_host2host(dst, src, size); };
 
-    free(host_src);
+      default:
+        throw xrt_core::system_error(hipErrorInvalidValue, "Unsupported copy kind in hipMemcpyAsync");
+    };
+  }
+
+  static void
+  enqueue_transfer(hipStream_t stream, copy_buffer::transfer_fn&& transfer)
+  {
+    auto hip_stream = get_stream(stream);
+    throw_invalid_handle_if(!hip_stream, "stream is invalid");
+
+    // stream is capturing, record the transfer in the graph instead
+    if (auto capture_graph = hip_stream->get_capture_graph()) {
+      capture_graph->add_transfer_node(std::move(transfer));
+      return;
+    }
+
+    auto s_hdl = hip_stream.get();
+    auto cmd_hdl = insert_in_map(command_cache,
+                                 std::make_shared<copy_buffer>(hip_stream, std::move(transfer)));
+    s_hdl->enqueue(command_cache.get(cmd_hdl));
+  }
+
+  // Copy data from src to dst asynchronously in stream order.
+  static void
+  hip_memcpy_async(void* dst, const void* src, size_t size, hipMemcpyKind kind, hipStream_t stream)
+  {
+    enqueue_transfer(stream, get_memcpy_transfer(dst, src, size, kind));
+  }
+
+  // Fill data to dst asynchronously in stream order.
+  static void
+  hip_memset_async(void* dst, int value, size_t size, hipStream_t stream)
+  {
+    size_t offset = 0;
+    auto hip_mem = get_fill_memory(dst, size, offset);
+    auto fill_value = static_cast<unsigned char>(value);
+    enqueue_transfer(stream, [hip_mem, fill_value, size, offset] {
+      hip_mem->fill(fill_value, size, offset);
+    });
   }
 
 } // xrt::core::hip
@@ -307,3 +406,21 @@ hipMemset(void* dst, int value, size_t size)
   return handle_hip_memory_error([&] { xrt::core::hip::hip_memset(dst, value, size); });
 }
 
+// Copy data from src to dst, ordered with the other commands in stream.
+hipError_t
+hipMemcpyAsync(void* dst, const void* src, size_t size, hipMemcpyKind kind, hipStream_t stream)
+{
+  if (size == 0)
+    return hipSuccess;
+  return handle_hip_memory_error([&] { xrt::core::hip::hip_memcpy_async(dst, src, size, kind, stream); });
+}
+
+// Fill size bytes at dst with value, ordered with the other commands in stream.
+hipError_t
+hipMemsetAsync(void* dst, int value, size_t size, hipStream_t stream)
+{
+  if (size == 0)
+    return hipSuccess;
+  return handle_hip_memory_error([&] { xrt::core::hip::hip_memset_async(dst, value, size, stream); });
+}
+
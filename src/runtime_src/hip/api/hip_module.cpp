@@ -3,6 +3,7 @@
 
 #include "hip/core/common.h"
 #include "hip/core/event.h"
+#include "hip/core/graph.h"
 #include "hip/core/module.h"
 #include "hip/core/stream.h"
 
@@ -26,6 +27,14 @@ hip_module_launch_kernel(hipFunction_t f, uint32_t /*gridDimX*/, uint32_t /*grid
   // Revisit if we need to launch multiple times
 
   auto hip_stream = get_stream(hStream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+
+  // stream is capturing, record the launch in the graph instead
+  if (auto capture_graph = hip_stream->get_capture_graph()) {
+    capture_graph->add_kernel_node(hip_func, kernelParams);
+    return;
+  }
+
   auto s_hdl = hip_stream.get();
   auto cmd_hdl = insert_in_map(command_cache,
                                std::make_shared<kernel_start>(hip_stream,
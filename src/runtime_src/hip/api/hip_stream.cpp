@@ -75,6 +75,8 @@ hip_stream_synchronize(hipStream_t stream)
 {
   auto hip_stream = get_stream(stream);
   throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  throw_if(hip_stream->get_capture_graph() != nullptr, hipErrorStreamCaptureUnsupported,
+           "stream is capturing");
   hip_stream->synchronize();
 }
 
@@ -85,6 +87,8 @@ hip_stream_wait_event(hipStream_t stream, hipEvent_t ev, unsigned int flags)
 
   auto hip_wait_stream = get_stream(stream);
   throw_invalid_resource_if(!hip_wait_stream, "stream is invalid");
+  throw_if(hip_wait_stream->get_capture_graph() != nullptr, hipErrorStreamCaptureUnsupported,
+           "stream is capturing");
 
   throw_invalid_handle_if(!ev, "event is nullptr");
   auto hip_event_cmd = std::dynamic_pointer_cast<event>(command_cache.get(ev));
@@ -94,21 +98,21 @@ hip_stream_wait_event(hipStream_t stream, hipEvent_t ev, unsigned int flags)
   auto hip_event_stream = hip_event_cmd->get_stream();
 
   // check stream on which wait is called is same as stream in which event is enqueued
+  // wait for the current record of the event, a later record of
+  // the event doesn't affect this wait
+  auto hip_event_rec = hip_event_cmd->get_record();
   if (hip_wait_stream == hip_event_stream) {
-    hip_wait_stream->record_top_event(hip_event_cmd.get());
+    hip_wait_stream->record_top_event(hip_event_rec.get());
   }
   else {
-    auto wait_stream = hip_wait_stream.get();
-    // create dummy event and add the event to be waited in its dep list
-    auto dummy_event_hdl = static_cast<event*>(
-        insert_in_map(command_cache,
-                      std::make_shared<event>()));
-    dummy_event_hdl->record(hip_wait_stream);
-    dummy_event_hdl->add_dependency(hip_event_cmd);
-
-    // enqueue dummy event into wait stream
-    wait_stream->enqueue(command_cache.get(dummy_event_hdl));
-    wait_stream->record_top_event(dummy_event_hdl);
+    // create dummy record and add the record to be waited in its dep list
+    auto dummy_rec = std::make_shared<event_record>(hip_wait_stream);
+    dummy_rec->add_dependency(hip_event_rec);
+
+    // enqueue dummy record into wait stream
+    auto dummy = dummy_rec.get();
+    hip_wait_stream->enqueue(std::move(dummy_rec));
+    hip_wait_stream->record_top_event(dummy);
   }
 }
 } // // xrt::core::hip
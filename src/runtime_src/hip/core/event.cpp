@@ -5,94 +5,193 @@
 #include "memory.h"
 
 namespace xrt::core::hip {
-event::event()
+void command::notify_completion()
 {
-  ctype = type::event;
+  std::vector<completion_fn> fns;
+  {
+    std::lock_guard<std::mutex> lk(m_completion_mutex);
+    if (m_notified)
+      return;
+    ctime = std::chrono::steady_clock::now();
+    m_notified = true;
+    fns.swap(m_completion_fns);
+  }
+  m_completion_cv.notify_all();
+  for (const auto& fn : fns)
+    fn();
 }
 
-void event::record(std::shared_ptr<stream> s)
+void command::on_completion(completion_fn fn)
 {
-  cstream = std::move(s);
-  auto ev = std::dynamic_pointer_cast<event>(command_cache.get(static_cast<command_handle>(this)));
-  throw_invalid_handle_if(!ev, "event passed is invalid");
-  /*
-  TODO
-  if (is_recorded()) {
-    // already recorded
-    cstream->erase_cmd(ev); It is commented will be uncomment after stream PR is pushed
+  {
+    std::lock_guard<std::mutex> lk(m_completion_mutex);
+    if (!m_notified) {
+      m_completion_fns.push_back(std::move(fn));
+      return;
+    }
   }
-  // update recorded commands list
-  cstream->enqueue_event(std::move(ev));It is commented will be uncomment after stream PR is pushed
-  */
+  fn();
+}
+
+void command::wait_for_completion()
+{
+  std::unique_lock<std::mutex> lk(m_completion_mutex);
+  m_completion_cv.wait(lk, [this] { return m_notified; });
+}
+
+bool command::is_completed()
+{
+  std::lock_guard<std::mutex> lk(m_completion_mutex);
+  return m_notified;
+}
+
+event_record::event_record(std::shared_ptr<stream> s)
+  : command(std::move(s))
+{
+  ctype = type::event;
   set_state(state::recorded);
 }
 
-bool event::is_recorded() const
+bool event_record::wait()
 {
-  return get_state() >= command::state::recorded;
+  wait_for_completion();
+  return true;
 }
 
-bool event::query()
+void event_record::complete()
 {
-  for (auto rec_com : recorded_commands){
-    state command_state = rec_com->get_state();
-    if (command_state != state::completed){
-      return false;
-    }
+  {
+    // chained commands are submitted under the lock so that commands
+    // added to the chain after completion are submitted after them
+    std::lock_guard<std::mutex> lk(m_mutex);
+    set_state(state::completed);
+    recorded_commands.clear();
+    for (const auto& cmd : chain_of_commands)
+      cmd->submit();
+    chain_of_commands.clear();
   }
-  return true;
+  notify_completion();
 }
 
-bool event::synchronize()
+void event_record::dependency_completed()
 {
-  for (auto rec_com : recorded_commands) {
-    rec_com->wait();
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (--m_pending)
+      return;
   }
-  set_state(state::completed);
-  for (auto coms_ch :chain_of_commands){
-    coms_ch->submit();
+  complete();
+}
+
+bool event_record::submit()
+{
+  std::vector<std::shared_ptr<command>> deps;
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (get_state() != state::recorded)
+      return get_state() == state::running;
+
+    set_state(state::running);
+    deps = recorded_commands;
+    // one extra count so the record cannot complete while registering
+    m_pending = deps.size() + 1;
   }
+
+  auto self = std::static_pointer_cast<event_record>(shared_from_this());
+  for (const auto& cmd : deps)
+    cmd->on_completion([self] { self->dependency_completed(); });
+  dependency_completed();
   return true;
 }
 
-bool event::wait()
+std::shared_ptr<stream> event_record::get_stream()
+{
+  return cstream;
+}
+
+void event_record::add_to_chain(std::shared_ptr<command> cmd)
 {
-  ctime = std::chrono::system_clock::now();
-  state event_state = get_state();
-  if (event_state < state::completed)
   {
-    synchronize();
-    set_state(state::completed);
-    return true;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (get_state() < state::completed) {
+      chain_of_commands.push_back(std::move(cmd));
+      return;
+    }
   }
-  return false;
+  cmd->submit();
 }
 
-bool event::submit()
+void event_record::add_dependency(std::shared_ptr<command> cmd)
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  recorded_commands.push_back(std::move(cmd));
+}
+
+event::event(unsigned int flags)
+  : m_flags{flags}
+{
+  ctype = type::event;
+}
+
+std::shared_ptr<event_record> event::record(std::shared_ptr<stream> s)
+{
+  // a new record replaces the previous one, which is left to
+  // complete in its stream without blocking the host
+  auto rec = std::make_shared<event_record>(std::move(s));
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_record = rec;
+  set_state(state::recorded);
+  return rec;
+}
+
+std::shared_ptr<event_record> event::get_record() const
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_record;
+}
+
+bool event::is_recorded() const
 {
+  return get_record() != nullptr;
+}
+
+bool event::query()
+{
+  auto rec = get_record();
+  return !rec || rec->is_completed();
+}
+
+bool event::synchronize()
+{
+  auto rec = get_record();
+  if (!rec)
+    return false;
+
+  rec->wait_for_completion();
   return true;
 }
 
-std::shared_ptr<stream> event::get_stream()
+bool event::submit()
 {
-  return cstream;
+  // the records of the event are submitted by their streams
+  return false;
 }
 
-void event::add_to_chain(std::shared_ptr<command> cmd)
+bool event::wait()
 {
-  // lock and add
+  return synchronize();
 }
 
-void event::add_dependency(std::shared_ptr<command> cmd)
+std::shared_ptr<stream> event::get_stream()
 {
-  // lock and add
+  auto rec = get_record();
+  return rec ? rec->get_stream() : nullptr;
 }
 
-float event::elapsed_time (const std::shared_ptr<command>& end)
+float event::elapsed_time(const std::shared_ptr<event>& end)
 {
-  auto duration = end->get_time() - get_time();
-  auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-  return millis;
+  auto duration = end->get_record()->get_time() - get_record()->get_time();
+  return std::chrono::duration<float, std::milli>(duration).count();
 }
 
 kernel_start::kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function> f, void** args)
@@ -134,13 +233,29 @@ kernel_start::kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function>
   }
 }
 
+void kernel_start::completed(ert_cmd_state ert_state)
+{
+  set_state(ert_state == ERT_CMD_STATE_COMPLETED ? state::completed : state::error);
+  notify_completion();
+}
+
 bool kernel_start::submit()
 {
   state kernel_start_state = get_state();
   if (kernel_start_state == state::init)
   {
-    r.start();
+    // completion is reported by the run callback, so events and
+    // copies waiting on the kernel are resolved when it completes
+    // rather than when the host waits for it
+    std::weak_ptr<command> weak = weak_from_this();
+    r.add_callback(ERT_CMD_STATE_COMPLETED,
+                   [weak](const void*, ert_cmd_state ert_state, void*) {
+                     if (auto cmd = weak.lock())
+                       std::static_pointer_cast<kernel_start>(cmd)->completed(ert_state);
+                   },
+                   nullptr);
     set_state(state::running);
+    r.start();
     return true;
   }
   else if (kernel_start_state == state::running)
@@ -153,32 +268,76 @@ bool kernel_start::wait()
 {
   state kernel_start_state = get_state();
   if (kernel_start_state == state::running)
-  {
     r.wait();
-    set_state(state::completed);
-    return true;
-  }
-  else if (kernel_start_state == state::completed)
-    return true;
 
-  return false;
+  // also waits for a kernel chained behind another command
+  wait_for_completion();
+  return get_state() == state::completed;
 }
 
-copy_buffer::copy_buffer(std::shared_ptr<stream> s)
+copy_buffer::copy_buffer(std::shared_ptr<stream> s, transfer_fn&& fn)
   : command(std::move(s))
+  , m_transfer{std::move(fn)}
 {
   ctype = type::buffer_copy;
 }
 
+void copy_buffer::add_dependency(std::shared_ptr<command> cmd)
+{
+  m_dependencies.push_back(std::move(cmd));
+}
+
+bool copy_buffer::add_to_chain(std::shared_ptr<command> cmd)
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (get_state() >= state::completed)
+    return false;
+
+  m_chain.push_back(std::move(cmd));
+  return true;
+}
+
+void copy_buffer::run()
+{
+  try {
+    for (const auto& cmd : m_dependencies)
+      cmd->wait_for_completion();
+    m_dependencies.clear();
+    m_transfer();
+  }
+  catch (...) {
+    m_error = std::current_exception();
+  }
+
+  // submit chained commands even if the transfer failed, the error
+  // is reported when the copy is waited on
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    set_state(m_error ? state::error : state::completed);
+    for (const auto& cmd : m_chain)
+      cmd->submit();
+    m_chain.clear();
+  }
+  notify_completion();
+}
+
 bool copy_buffer::submit()
 {
-  //handle = std::async(&xrt::bo::sync, &cbo, cdirection);
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (get_state() != state::init)
+    return get_state() == state::running;
+
+  set_state(state::running);
+  handle = std::async(std::launch::async, &copy_buffer::run, this);
   return true;
 }
 
 bool copy_buffer::wait()
 {
-  handle.wait();
+  // also waits for a copy chained behind another command
+  wait_for_completion();
+  if (m_error)
+    std::rethrow_exception(m_error);
   return true;
 }
 
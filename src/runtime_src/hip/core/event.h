@@ -10,7 +10,11 @@
 #include "xrt/xrt_bo.h"
 #include "core/common/api/kernel_int.h"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <exception>
+#include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -21,7 +25,7 @@ namespace xrt::core::hip {
 // command_handle - opaque command handle
 using command_handle = void*;
 
-class command
+class command : public std::enable_shared_from_this<command>
 {
 public:
   enum class state : uint8_t
@@ -41,11 +45,27 @@ public:
     kernel_start
   };
 
+  using completion_fn = std::function<void()>;
+  using time_point = std::chrono::time_point<std::chrono::steady_clock>;
+
 protected:
   std::shared_ptr<stream> cstream;
   type ctype;
-  std::chrono::time_point<std::chrono::system_clock> ctime;
-  state cstate;
+  time_point ctime;
+  std::atomic<state> cstate;
+
+private:
+  // completion notification, see notify_completion()
+  std::mutex m_completion_mutex;
+  std::condition_variable m_completion_cv;
+  std::vector<completion_fn> m_completion_fns;
+  bool m_notified{false};
+
+protected:
+  // Stamp the completion time and call the functions registered
+  // with on_completion().  Called once by the command type when the
+  // command is done, from whichever thread observes the completion.
+  void notify_completion();
 
 public:
   command()
@@ -57,35 +77,87 @@ public:
     , cstate{state::init}
   {}
 
+  virtual ~command() = default;
+
   virtual bool submit() = 0;
   virtual bool wait() = 0;
   state get_state() const { return cstate; }
-  std::chrono::time_point<std::chrono::system_clock> get_time() { return ctime; }
+  time_point get_time() const { return ctime; }
   void set_state(state newstate) { cstate = newstate; };
   type
   get_type() const { return ctype; }
+
+  // Call fn when the command completes, right away if it has already
+  // completed.  fn runs on the thread completing the command and must
+  // not block.
+  void on_completion(completion_fn fn);
+
+  // Block until the command has completed, including commands that
+  // are not submitted yet because they are chained behind another one
+  void wait_for_completion();
+
+  bool is_completed();
 };
 
-class event : public command
+// event_record - one record of an event, the marker in a stream
+//
+// A recorded event completes when the commands ahead of it in the
+// stream have completed.  It does not wait for them on the host, each
+// command notifies the record when it completes and the last one
+// completes the record and stamps its time.
+class event_record : public command
 {
 private:
   std::mutex m_mutex;
+  size_t m_pending{0};  // recorded commands not yet completed
   std::vector<std::shared_ptr<command>> recorded_commands;
   std::vector<std::shared_ptr<command>> chain_of_commands;
 
+  void complete();
+  void dependency_completed();
+
 public:
-  event();
+  explicit event_record(std::shared_ptr<stream> s);
 
-  void record(std::shared_ptr<stream> s);
+  bool submit() override;
+  bool wait() override;
+  std::shared_ptr<stream> get_stream();
+  void add_to_chain(std::shared_ptr<command> cmd);
+  void add_dependency(std::shared_ptr<command> cmd);
+};
+
+// event - hipEvent_t
+//
+// Each record of the event creates a new event_record that is
+// enqueued in the stream.  Recording the event again does not wait
+// for the previous record, which completes on its own and still
+// releases the commands that wait for it.  Queries, synchronization
+// and timing use the most recent record.
+class event : public command
+{
+private:
+  mutable std::mutex m_mutex;
+  unsigned int m_flags;
+  std::shared_ptr<event_record> m_record;
+
+public:
+  explicit event(unsigned int flags = 0);
+
+  std::shared_ptr<event_record> record(std::shared_ptr<stream> s);
+  std::shared_ptr<event_record> get_record() const;
   bool submit() override;
   bool wait() override;
   bool synchronize();
   bool query();
   bool is_recorded() const;
   std::shared_ptr<stream> get_stream();
-  void add_to_chain(std::shared_ptr<command> cmd);
-  void add_dependency(std::shared_ptr<command> cmd);
-  float elapsed_time(const std::shared_ptr<command>& end);
+  float elapsed_time(const std::shared_ptr<event>& end);
+
+  unsigned int
+  get_flags() const
+  {
+    return m_flags;
+  }
 };
 
 class kernel_start : public command
@@ -94,22 +166,44 @@ private:
   std::shared_ptr<function> func;
   xrt::run r;
 
+  void completed(ert_cmd_state state);
+
 public:
   kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function> f, void** args);
   bool submit() override;
   bool wait() override;
 };
 
+// copy_buffer - memory copy or fill enqueued on a stream
+//
+// The transfer runs on a host thread once the commands ahead of it in
+// the stream have completed.  Commands enqueued on the stream while the
+// transfer is pending are chained and submitted when it completes, so
+// the stream stays in order while the host thread overlaps with
+// kernels and transfers on other streams.
 class copy_buffer : public command
 {
 public:
-  copy_buffer(std::shared_ptr<stream> s);
+  using transfer_fn = std::function<void()>;
+
+  copy_buffer(std::shared_ptr<stream> s, transfer_fn&& fn);
   bool submit() override;
   bool wait() override;
 
+  // command ahead in the stream that must complete before the transfer
+  void add_dependency(std::shared_ptr<command> cmd);
+
+  // submit cmd when the transfer completes, false if already completed
+  bool add_to_chain(std::shared_ptr<command> cmd);
+
 private:
-  xclBOSyncDirection cdirection;
-  xrt::bo cbo;
+  void run();
+
+  transfer_fn m_transfer;
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<command>> m_dependencies;
+  std::vector<std::shared_ptr<command>> m_chain;
+  std::exception_ptr m_error;
   std::future<void> handle;
 };
 
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Device, Inc. All rights reserved.
+
+#include "hip/config.h"
+#include "hip/hip_runtime_api.h"
+
+#include "graph.h"
+
+namespace xrt::core::hip {
+void
+graph::
+add_kernel_node(std::shared_ptr<function> func, void** args)
+{
+  auto arginfo = xrt_core::kernel_int::get_args(func->get_kernel());
+
+  graph_node node;
+  node.ntype = graph_node::type::kernel;
+  node.func = std::move(func);
+
+  using karg = xrt_core::xclbin::kernel_argument;
+  size_t idx = 0;
+  for (const auto& arg : arginfo) {
+    // non index args are not supported, this condition will not hit in case of HIP
+    if (arg->index == karg::no_index)
+      throw std::runtime_error("function has invalid argument");
+
+    graph_node::arg_value value;
+    value.index = arg->index;
+    switch (arg->type) {
+      case karg::argtype::scalar : {
+        auto data = static_cast<const uint8_t*>(args[idx]);
+        value.bytes.assign(data, data + arg->size);
+        break;
+      }
+      case karg::argtype::global : {
+        value.buffer = memory_database::instance().get_hip_mem_from_addr(args[idx]);
+        if (!value.buffer)
+          throw std::runtime_error("failed to get memory from arg at index - " + std::to_string(idx));
+        break;
+      }
+      case karg::argtype::constant :
+      case karg::argtype::local :
+      case karg::argtype::stream :
+      default :
+        throw std::runtime_error("function has unsupported arg type");
+    }
+    node.args.push_back(std::move(value));
+    idx++;
+  }
+
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_nodes.push_back(std::move(node));
+}
+
+void
+graph::
+add_transfer_node(copy_buffer::transfer_fn&& transfer)
+{
+  graph_node node;
+  node.ntype = graph_node::type::transfer;
+  node.transfer = std::move(transfer);
+
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_nodes.push_back(std::move(node));
+}
+
+std::vector<graph_node>
+graph::
+get_nodes()
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_nodes;
+}
+
+graph_exec::
+graph_exec(std::vector<graph_node>&& nodes)
+  : m_nodes{std::move(nodes)}
+  , m_runs(m_nodes.size())
+{
+  module* segment_module = nullptr;
+  for (size_t idx = 0; idx < m_nodes.size(); ++idx) {
+    const auto& node = m_nodes[idx];
+    if (node.ntype == graph_node::type::transfer) {
+      m_segments.push_back({xrt::runlist{}, idx, true});
+      segment_module = nullptr;
+      continue;
+    }
+
+    // a runlist is per hw context, which is per module
+    auto mod = node.func->get_module();
+    if (mod != segment_module) {
+      m_segments.push_back({xrt::runlist{mod->get_hw_context()}, 0, false});
+      segment_module = mod;
+    }
+
+    m_runs[idx] = xrt::run(node.func->get_kernel());
+    set_args(m_runs[idx], node, nullptr);
+    m_segments.back().runlist.add(m_runs[idx]);
+  }
+}
+
+void
+graph_exec::
+set_args(xrt::run& run, const graph_node& node, const graph_node* prev)
+{
+  for (size_t idx = 0; idx < node.args.size(); ++idx) {
+    const auto& value = node.args[idx];
+    if (prev && prev->args[idx] == value)
+      continue;
+
+    if (value.buffer)
+      run.set_arg(static_cast<int>(value.index), *(value.buffer->get_xrt_bo()));
+    else
+      xrt_core::kernel_int::set_arg_at_index(run, value.index, value.bytes.data(), value.bytes.size());
+  }
+}
+
+bool
+graph_exec::
+update(std::vector<graph_node>&& nodes)
+{
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (nodes.size() != m_nodes.size())
+    return false;
+
+  for (size_t idx = 0; idx < nodes.size(); ++idx) {
+    if (nodes[idx].ntype != m_nodes[idx].ntype || nodes[idx].func != m_nodes[idx].func)
+      return false;
+  }
+
+  for (size_t idx = 0; idx < nodes.size(); ++idx) {
+    if (nodes[idx].ntype == graph_node::type::kernel)
+      set_args(m_runs[idx], nodes[idx], &m_nodes[idx]);
+    m_nodes[idx] = std::move(nodes[idx]);
+  }
+  return true;
+}
+
+void
+graph_exec::
+execute()
+{
+  // launches of the same graph on different streams run one at a time
+  std::lock_guard<std::mutex> lk(m_mutex);
+  for (auto& seg : m_segments) {
+    if (seg.is_transfer) {
+      m_nodes[seg.transfer_node].transfer();
+      continue;
+    }
+    seg.runlist.execute();
+    seg.runlist.wait();
+  }
+}
+
+// Global map of graphs
+xrt_core::handle_map<graph_handle, std::shared_ptr<graph>> graph_cache;
+
+// Global map of executable graphs
+xrt_core::handle_map<graph_exec_handle, std::shared_ptr<graph_exec>> graph_exec_cache;
+} // xrt::core::hip
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Device, Inc. All rights reserved.
+#ifndef xrthip_graph_h
+#define xrthip_graph_h
+
+#include "event.h"
+#include "memory.h"
+#include "module.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xrt::core::hip {
+
+// graph_handle - opaque graph handle
+using graph_handle = void*;
+
+// graph_exec_handle - opaque executable graph handle
+using graph_exec_handle = void*;
+
+// graph_node - kernel launch or memory transfer captured from a stream
+//
+// Kernel argument values are copied when the launch is captured, as
+// the kernel parameters passed to hipModuleLaunchKernel need not
+// outlive the call.
+struct graph_node
+{
+  enum class type : uint8_t
+  {
+    kernel,
+    transfer
+  };
+
+  // captured value of one kernel argument
+  struct arg_value
+  {
+    size_t index = 0;                // kernel argument index
+    std::vector<uint8_t> bytes;      // scalar argument
+    std::shared_ptr<memory> buffer;  // global argument
+
+    bool
+    operator==(const arg_value& rhs) const
+    {
+      return bytes == rhs.bytes && buffer == rhs.buffer;
+    }
+  };
+
+  type ntype;
+  std::shared_ptr<function> func;
+  std::vector<arg_value> args;
+  copy_buffer::transfer_fn transfer;
+};
+
+// graph - nodes captured from a stream, in stream order
+class graph
+{
+  std::mutex m_mutex;
+  std::vector<graph_node> m_nodes;
+
+public:
+  void
+  add_kernel_node(std::shared_ptr<function> func, void** args);
+
+  void
+  add_transfer_node(copy_buffer::transfer_fn&& transfer);
+
+  std::vector<graph_node>
+  get_nodes();
+};
+
+// graph_exec - instantiated graph
+//
+// Each kernel node gets its run object with arguments set when the
+// graph is instantiated.  Consecutive kernel nodes of the same hw
+// context form a segment that is executed as one xrt::runlist, so
+// launching the graph costs one submission per segment rather than
+// one per kernel.  Transfer nodes run on the host between segments.
+class graph_exec
+{
+  // runlist of consecutive kernel nodes, or a transfer node
+  struct segment
+  {
+    xrt::runlist runlist;
+    size_t transfer_node;
+    bool is_transfer;
+  };
+
+  void
+  set_args(xrt::run& run, const graph_node& node, const graph_node* prev);
+
+  std::mutex m_mutex;
+  std::vector<graph_node> m_nodes;  // nodes with arguments as set
+  std::vector<xrt::run> m_runs;     // run per node, empty for transfers
+  std::vector<segment> m_segments;
+
+public:
+  explicit graph_exec(std::vector<graph_node>&& nodes);
+
+  // Update arguments and transfers from a graph with the same
+  // kernels in the same order.  Only arguments whose value changed
+  // are set again.  Returns false if the graph differs otherwise.
+  bool
+  update(std::vector<graph_node>&& nodes);
+
+  // Execute all nodes in order and wait for completion.  Called on
+  // the host thread of the stream on which the graph is launched.
+  void
+  execute();
+};
+
+// Global map of graphs
+extern xrt_core::handle_map<graph_handle, std::shared_ptr<graph>> graph_cache;
+
+// Global map of executable graphs
+extern xrt_core::handle_map<graph_exec_handle, std::shared_ptr<graph_exec>> graph_exec_cache;
+
+} // xrt::core::hip
+
+#endif
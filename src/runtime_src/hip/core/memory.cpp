@@ -14,6 +14,9 @@
 #include "hip/hip_runtime_api.h"
 #include "memory.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace xrt::core::hip
 {
 
@@ -123,6 +126,23 @@ namespace xrt::core::hip
     }
   }
   
+  void
+  memory::fill(unsigned char value, size_t size, size_t offset)
+  {
+    if (!m_bo)
+      return;
+
+    // write the pattern in chunks rather than staging the whole
+    // range in host memory, then sync the range once
+    constexpr size_t max_chunk = 64 * 1024;
+    std::vector<unsigned char> pattern(std::min(size, max_chunk), value);
+    for (size_t done = 0; done < size; done += pattern.size()) {
+      auto bytes = std::min(size - done, pattern.size());
+      m_bo->write(pattern.data(), bytes, offset + done);
+    }
+    m_bo->sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
+  }
+
   void
   memory::sync(xclBOSyncDirection direction)
   {
@@ -167,18 +187,21 @@ namespace xrt::core::hip
   void
   memory_database::insert(uint64_t addr, size_t size, std::shared_ptr<xrt::core::hip::memory> hip_mem)
   {
+    std::lock_guard<std::mutex> lk(m_mutex);
     m_addr_map.insert({address_range_key(addr, size), hip_mem});
   }
 
   void
   memory_database::remove(uint64_t addr)
   {
+    std::lock_guard<std::mutex> lk(m_mutex);
     m_addr_map.erase(address_range_key(addr, 0));
   }
 
   std::shared_ptr<xrt::core::hip::memory>
   memory_database::get_hip_mem_from_addr(void *addr)
   {
+    std::lock_guard<std::mutex> lk(m_mutex);
     auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
     if (itr == m_addr_map.end()) {
       return nullptr;
@@ -191,6 +214,7 @@ namespace xrt::core::hip
   std::shared_ptr<const xrt::core::hip::memory>
   memory_database::get_hip_mem_from_addr(const void *addr)
   {
+    std::lock_guard<std::mutex> lk(m_mutex);
     auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
     if (itr == m_addr_map.end()) {
       return nullptr;
@@ -11,6 +11,8 @@
 #include "xrt/device/hal.h"
 #include "xrt/util/range.h"
 
+#include <mutex>
+
 namespace xrt::core::hip
 {
   enum class memory_type : int
@@ -53,6 +55,10 @@ namespace xrt::core::hip
 
     void
     read(void *dst, size_t size, size_t dst_offset = 0, size_t offset = 0) const;
+
+    // fill size bytes at offset with value
+    void
+    fill(unsigned char value, size_t size, size_t offset = 0);
     
     void
     sync(xclBOSyncDirection);
@@ -126,6 +132,7 @@ namespace xrt::core::hip
   {
   private:
     addr_map m_addr_map;
+    mutable std::mutex m_mutex; // stream copies look up memory from host threads
   
   protected:
     memory_database();
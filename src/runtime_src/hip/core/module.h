@@ -37,6 +37,12 @@ public:
   xrt::kernel
   create_kernel(std::string& name);
 
+  const xrt::hw_context&
+  get_hw_context() const
+  {
+    return m_hw_ctx;
+  }
+
   function_handle
   add_function(std::shared_ptr<function>&& f)
   {
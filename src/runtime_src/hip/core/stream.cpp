@@ -29,14 +29,29 @@ void
 stream::
 enqueue(std::shared_ptr<command>&& cmd)
 {
-  // if there is top event add command chain list of this event
-  // else submit the command
+  std::lock_guard<std::mutex> lock(m_cmd_lock);
+
+  // a copy runs on a host thread, it waits for the commands ahead
+  // of it in the stream before transferring
+  auto copy = (cmd->get_type() == command::type::buffer_copy)
+    ? std::static_pointer_cast<copy_buffer>(cmd)
+    : nullptr;
+  if (copy) {
+    for (const auto& c : m_cmd_queue)
+      if (c->get_type() != command::type::event && !c->is_completed())
+        copy->add_dependency(c);
+  }
+
+  // if there is top event add command chain list of this event,
+  // else if a copy is pending in this stream submit the command
+  // when the copy completes, else submit the command
   if (m_top_event)
     m_top_event->add_to_chain(cmd);
-  else
+  else if (!m_last_copy || !m_last_copy->add_to_chain(cmd))
     cmd->submit();
 
-  std::lock_guard<std::mutex> lock(m_cmd_lock);
+  if (copy)
+    m_last_copy = std::move(copy);
   m_cmd_queue.emplace_back(std::move(cmd));
 }
 
@@ -68,13 +83,15 @@ erase_cmd(std::shared_ptr<command> cmd)
 
 void
 stream::
-enqueue_event(std::shared_ptr<event>&& ev)
+enqueue_event(std::shared_ptr<event_record>&& ev)
 {
   {
-    // iterate over commands and add them to recorded list of event
+    // iterate over commands and add the pending ones to recorded
+    // list of event, the event completes when they have completed
     std::lock_guard<std::mutex> lock(m_cmd_lock);
     for (const auto& cmd : m_cmd_queue) {
-      ev->add_dependency(cmd);
+      if (!cmd->is_completed())
+        ev->add_dependency(cmd);
     }
   }
   enqueue(std::move(ev));
@@ -114,13 +131,17 @@ await_completion()
   std::lock_guard<std::mutex> lk(m_cmd_lock);
   while(!m_cmd_queue.empty()) {
     auto cmd = m_cmd_queue.front();
-    cmd->wait();
     // kernel_start and copy_buffer cmds needs to be explicitly removed from cache
     // there is no destroy call for them
     if (cmd->get_type() != command::type::event)
       command_cache.remove(cmd.get());
     m_cmd_queue.pop_front();
+    // may throw if the command failed, the command is already
+    // removed from the stream
+    cmd->wait();
   }
+  m_last_copy = nullptr;
+  m_top_event = nullptr;
 }
 
 void
@@ -136,12 +157,38 @@ synchronize()
 
 void
 stream::
-record_top_event(event* ev)
+record_top_event(event_record* ev)
 {
   std::lock_guard<std::mutex> lk(m_cmd_lock);
   m_top_event = ev;
 }
 
+void
+stream::
+begin_capture(std::shared_ptr<graph> g)
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  throw_if(m_capture_graph != nullptr, hipErrorIllegalState, "stream is already capturing");
+  m_capture_graph = std::move(g);
+}
+
+std::shared_ptr<graph>
+stream::
+end_capture()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  throw_if(m_capture_graph == nullptr, hipErrorIllegalState, "stream is not capturing");
+  return std::move(m_capture_graph);
+}
+
+std::shared_ptr<graph>
+stream::
+get_capture_graph()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  return m_capture_graph;
+}
+
 std::shared_ptr<stream>
 get_stream(hipStream_t stream)
 {
@@ -10,8 +10,10 @@
 namespace xrt::core::hip {
 
 // forward declarations
-class event;
+class event_record;
 class command;
+class copy_buffer;
+class graph;
 
 class stream
 {
@@ -21,7 +23,9 @@ class stream
 
   std::list<std::shared_ptr<command>> m_cmd_queue;
   std::mutex m_cmd_lock;
-  event* m_top_event{nullptr};
+  event_record* m_top_event{nullptr};
+  std::shared_ptr<copy_buffer> m_last_copy; // most recent copy in this stream
+  std::shared_ptr<graph> m_capture_graph;   // graph being captured, if any
 
 public:
   stream() = default;
@@ -51,7 +55,7 @@ public:
   erase_cmd(std::shared_ptr<command> cmd);
 
   void
-  enqueue_event(std::shared_ptr<event>&& ev);
+  enqueue_event(std::shared_ptr<event_record>&& ev);
 
   void
   synchronize_streams();
@@ -63,7 +67,20 @@ public:
   synchronize();
 
   void
-  record_top_event(event* ev);
+  record_top_event(event_record* ev);
+
+  // Start capturing launches and copies into graph instead of
+  // executing them.  Throws if the stream is already capturing.
+  void
+  begin_capture(std::shared_ptr<graph> g);
+
+  // Stop capturing and return the captured graph
+  std::shared_ptr<graph>
+  end_capture();
+
+  // Graph being captured or nullptr if stream is not capturing
+  std::shared_ptr<graph>
+  get_capture_graph();
 };
 
 // Global map of streams
@@ -128,8 +128,11 @@ namespace xdp {
 
     // A lookup into the string table.  If the string isn't already in
     // the string table it will be added
-    inline uint64_t addString(const std::string& value)
+    inline uint64_t addString(std::string_view value)
     { return stringTable.addString(value); }
+    // For strings that live as long as the database, like function names
+    inline uint64_t addStaticString(const char* value)
+    { return stringTable.addStaticString(value); }
 
     // A function that iterates on the dynamic events and returns
     // copies of the events based upon the filter passed in
@@ -154,6 +157,8 @@ namespace xdp {
     // A function that each writer calls to dump the string table
     inline void dumpStringTable(std::ofstream& fout)
     { stringTable.dumpTable(fout); }
+    inline void dumpStringTable(VTFBinaryWriter& writer)
+    { stringTable.dumpTable(writer); }
 
     // OpenCL mappings and dependencies
     XDP_CORE_EXPORT void addOpenCLMapping(uint64_t openclID, uint64_t eventID, uint64_t startID) ;
@@ -19,17 +19,26 @@
 #include "xdp/profile/database/dynamic_info/host_db.h"
 #include "xdp/profile/database/events/vtf_event.h"
 #include <algorithm>
+#include <atomic>
 
 namespace xdp {
 
+  HostDB::HostDB()
+    : id([] {
+        static std::atomic<uint64_t> count{0};
+        return ++count;
+      }())
+  {
+  }
+
   HostDB::~HostDB()
   {
     // Delete sorted events still in the database and not moved
     {
-      std::lock_guard<std::mutex> lock(sortedLock);
-      for (auto& iter : sortedEvents) {
-        auto event = iter.second;
-        delete event;
+      std::lock_guard<std::mutex> lock(buffersLock);
+      for (auto& buffer : sortedBuffers) {
+        for (auto event : buffer->events)
+          delete event;
       }
     }
     // Delete unsorted events still in the database and not moved
@@ -40,13 +49,39 @@ namespace xdp {
     }
   }
 
+  HostDB::EventBuffer* HostDB::getThreadBuffer()
+  {
+    // Each thread caches the buffer of the database it last added to.
+    // On a miss the thread's buffer is looked up by thread id so a
+    // thread alternating between databases does not create a new
+    // buffer on every switch.
+    // Databases are identified by id rather than address since a new
+    // database could be allocated at the address of a deleted one.
+    static thread_local uint64_t cachedId = 0;
+    static thread_local EventBuffer* cachedBuffer = nullptr;
+
+    if (cachedId == id)
+      return cachedBuffer;
+
+    std::lock_guard<std::mutex> lock(buffersLock);
+    auto& buffer = threadBuffers[std::this_thread::get_id()];
+    if (buffer == nullptr) {
+      sortedBuffers.push_back(std::make_unique<EventBuffer>());
+      buffer = sortedBuffers.back().get();
+    }
+    cachedId = id;
+    cachedBuffer = buffer;
+    return cachedBuffer;
+  }
+
   void HostDB::addSortedEvent(VTFEvent* event)
   {
     if (event == nullptr)
       return;
 
-    std::lock_guard<std::mutex> lock(sortedLock);
-    sortedEvents.emplace(event->getTimestamp(), event);
+    auto buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->lock);
+    buffer->events.push_back(event);
   }
 
   void HostDB::addUnsortedEvent(VTFEvent* event)
@@ -60,11 +95,13 @@ namespace xdp {
 
   bool HostDB::sortedEventsExist(std::function<bool (VTFEvent*)>& filter)
   {
-    std::lock_guard<std::mutex> lock(sortedLock);
-    for (auto& iter : sortedEvents) {
-      auto event = iter.second;
-      if (filter(event))
-        return true;
+    std::lock_guard<std::mutex> lock(buffersLock);
+    for (auto& buffer : sortedBuffers) {
+      std::lock_guard<std::mutex> bufferLock(buffer->lock);
+      for (auto event : buffer->events) {
+        if (filter(event))
+          return true;
+      }
     }
     return false;
   }
@@ -72,14 +109,21 @@ namespace xdp {
   std::vector<VTFEvent*>
   HostDB::filterSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
-    std::lock_guard<std::mutex> lock(sortedLock);
-
     std::vector<VTFEvent*> collected;
-    for (auto& iter : sortedEvents) {
-      auto event = iter.second;
-      if (filter(event))
-        collected.push_back(event);
+    {
+      std::lock_guard<std::mutex> lock(buffersLock);
+      for (auto& buffer : sortedBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->lock);
+        for (auto event : buffer->events) {
+          if (filter(event))
+            collected.push_back(event);
+        }
+      }
     }
+
+    // Events from each thread are in insertion order, the stable sort
+    // preserves that order for events with the same timestamp
+    std::stable_sort(collected.begin(), collected.end(), VTFEventSorter());
     return collected;
   }
 
@@ -99,19 +143,31 @@ namespace xdp {
   std::vector<std::unique_ptr<VTFEvent>>
   HostDB::moveSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
-    std::lock_guard<std::mutex> lock(sortedLock);
-
-    std::vector<std::unique_ptr<VTFEvent>> collected;
-
-    for (auto iter = sortedEvents.begin(); iter != sortedEvents.end(); ) {
-      auto event = (*iter).second;
-      if (filter(event)) {
-        collected.emplace_back(event);
-        iter = sortedEvents.erase(iter);
+    std::vector<VTFEvent*> moved;
+    {
+      std::lock_guard<std::mutex> lock(buffersLock);
+      for (auto& buffer : sortedBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->lock);
+        auto& events = buffer->events;
+        auto newEnd = std::remove_if(events.begin(), events.end(), [&filter, &moved](VTFEvent* event) {
+          if (filter(event)) {
+            moved.push_back(event);
+            return true;
+          }
+          return false;
+        });
+        events.erase(newEnd, events.end());
       }
-      else
-        ++iter;
     }
+
+    // Events from each thread are in insertion order, the stable sort
+    // preserves that order for events with the same timestamp
+    std::stable_sort(moved.begin(), moved.end(), VTFEventSorter());
+
+    std::vector<std::unique_ptr<VTFEvent>> collected;
+    collected.reserve(moved.size());
+    for (auto event : moved)
+      collected.emplace_back(event);
     return collected;
   }
 
@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "xdp/config.h"
@@ -42,8 +43,23 @@ namespace xdp {
     static constexpr uint64_t eventThreshold = 10000000;
 
     // Before all events are printed in a CSV, they have to be sorted.
-    // The multimap sorts them as we create and insert them.
-    std::multimap<double, VTFEvent*> sortedEvents;
+    // Each thread appends its events to its own buffer so threads
+    // adding events never contend with each other.  The buffers are
+    // merged and sorted by timestamp only when the events are read.
+    struct EventBuffer
+    {
+      std::mutex lock; // Uncontended except when events are read
+      std::vector<VTFEvent*> events;
+    };
+    std::vector<std::unique_ptr<EventBuffer>> sortedBuffers;
+
+    // The buffer of each thread that has added events to this
+    // database, so a thread gets its own buffer back after adding
+    // to another database in between
+    std::map<std::thread::id, EventBuffer*> threadBuffers;
+
+    // Identifies this database in the thread local buffer lookup
+    const uint64_t id;
 
     // For host events that will be sorted later (when printed), we
     // can store them away in a simple vector
@@ -69,11 +85,14 @@ namespace xdp {
     // Different host layers can have dependencies between events
     DependencyManager openclDependencies;
 
-    std::mutex sortedLock; // Protects the "sortedEvents" multimap
+    std::mutex buffersLock; // Protects "sortedBuffers" and "threadBuffers"
     std::mutex unsortedLock; // Protects the "unsortedEvents" vector
 
+    // Get the calling thread's buffer, creating it on first use
+    EventBuffer* getThreadBuffer();
+
   public:
-    HostDB() = default;
+    HostDB();
     XDP_CORE_EXPORT ~HostDB();
 
     // Functions to add host events to the database
@@ -16,26 +16,116 @@
 
 #define XDP_CORE_SOURCE
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "xdp/profile/database/dynamic_info/string_table.h"
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
 
 namespace xdp {
 
-  uint64_t StringTable::addString(const std::string& value)
+  std::pair<uint64_t, const char*> StringTable::intern(std::string_view value)
+  {
+    auto& shard = shards[std::hash<std::string_view>{}(value) % numShards];
+
+    {
+      std::shared_lock<std::shared_mutex> lock(shard.lock);
+      auto iter = shard.ids.find(value);
+      if (iter != shard.ids.end())
+        return {iter->second, iter->first.data()};
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    // Another thread may have added the string while we were unlocked
+    auto iter = shard.ids.find(value);
+    if (iter != shard.ids.end())
+      return {iter->second, iter->first.data()};
+
+    // std::string keeps its contents null terminated, so the interned
+    //  copy can be compared with strcmp
+    const std::string& stored = shard.strings.emplace_back(value);
+    uint64_t id = currentId++;
+    shard.ids.emplace(stored, id);
+    return {id, stored.c_str()};
+  }
+
+  uint64_t StringTable::addString(std::string_view value)
+  {
+    return intern(value).first;
+  }
+
+  uint64_t StringTable::addStaticString(const char* value)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+    auto hash = std::hash<const void*>{}(value);
+
+    // Open addressing over a fixed array.  Entries are only ever added,
+    //  so a key once published never changes.
+    for (size_t probe = 0; probe < numStaticEntries; ++probe) {
+      auto& entry = staticCache[(hash + probe) % numStaticEntries];
+      const char* key = entry.key.load(std::memory_order_acquire);
+
+      if (key == nullptr) {
+        auto [id, text] = intern(value);
+        if (entry.key.compare_exchange_strong(key, value, std::memory_order_acq_rel)) {
+          entry.text.store(text, std::memory_order_relaxed);
+          entry.id.store(id, std::memory_order_release);
+          return id;
+        }
+        // Lost the race for this slot.  If the winner published the
+        //  same string, the ID is the same one we just got.
+        if (key == value)
+          return id;
+        continue;
+      }
 
-    if (table.find(value) == table.end())
-      table[value] = currentId++;
+      if (key == value) {
+        uint64_t id = entry.id.load(std::memory_order_acquire);
+        // The ID is 0 only while the owner of the slot is publishing it
+        if (id == 0)
+          return addString(value);
+        // The address may have been reused for a different string
+        const char* text = entry.text.load(std::memory_order_relaxed);
+        return std::strcmp(text, value) == 0 ? id : addString(value);
+      }
+    }
 
-    return table[value];
+    // The cache is full
+    return addString(value);
+  }
+
+  // Visit all strings in the order they were added
+  template <typename Fn>
+  void StringTable::forEachSorted(Fn&& fn)
+  {
+    std::vector<std::pair<uint64_t, std::string_view>> sorted;
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    for (auto& shard : shards) {
+      locks.emplace_back(shard.lock);
+      for (auto& entry : shard.ids)
+        sorted.emplace_back(entry.second, entry.first);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    for (auto& entry : sorted)
+      fn(entry.first, entry.second);
   }
 
   void StringTable::dumpTable(std::ofstream& fout)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+    forEachSorted([&fout](uint64_t id, std::string_view value) {
+      fout << id << "," << value << "\n";
+    });
+  }
 
-    for (auto& s : table)
-      fout << s.second << "," << s.first.c_str() << "\n";
+  void StringTable::dumpTable(VTFBinaryWriter& writer)
+  {
+    forEachSorted([&writer](uint64_t id, std::string_view value) {
+      writer.writeString(id, value);
+    });
   }
 
 } // end namespace xdp
@@ -17,29 +17,75 @@
 #ifndef STRING_TABLE_DOT_H
 #define STRING_TABLE_DOT_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <fstream>
-#include <map>
-#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include "xdp/config.h"
 
 namespace xdp {
 
+  class VTFBinaryWriter ;
+
+  // The string table interns every string referenced by events (API
+  //  names, kernel names, memory resources, etc.) and hands out stable
+  //  IDs.  Strings are hashed into shards, each with a reader/writer
+  //  lock, so the common case of looking up an already interned string
+  //  only takes a shared lock and threads rarely contend.
   class StringTable
   {
   private:
-    std::map<std::string, uint64_t> table;
-    uint64_t currentId = 1; // Start at 1 so we can use 0 as a special value
+    static constexpr size_t numShards = 16;
+
+    struct Shard
+    {
+      std::shared_mutex lock;
+      // Keys are views into "strings", which never moves its elements
+      std::unordered_map<std::string_view, uint64_t> ids;
+      std::deque<std::string> strings;
+    };
+
+    // Lock free cache of strings keyed by address.  Used for function
+    //  names passed to the plugin callbacks, which are string literals
+    //  or __func__.  A hit is only trusted if the interned copy still
+    //  matches, so a reused address never returns a stale ID.
+    struct StaticEntry
+    {
+      std::atomic<const char*> key{nullptr};
+      std::atomic<const char*> text{nullptr}; // The interned copy
+      std::atomic<uint64_t> id{0};
+    };
+    static constexpr size_t numStaticEntries = 1024;
+
+    std::array<Shard, numShards> shards;
+    std::array<StaticEntry, numStaticEntries> staticCache;
+
+    // Start at 1 so we can use 0 as a special value
+    std::atomic<uint64_t> currentId{1};
+
+    template <typename Fn> void forEachSorted(Fn&& fn);
+
+    // Returns the ID of "value" and its interned copy
+    std::pair<uint64_t, const char*> intern(std::string_view value);
 
-    std::mutex dataLock; // Protects "table" map and currentId
   public:
     StringTable() = default;
     ~StringTable() = default;
 
-    XDP_CORE_EXPORT uint64_t addString(const std::string& value);
+    XDP_CORE_EXPORT uint64_t addString(std::string_view value);
+    // Same as addString, optimized for strings with static storage
+    //  duration.  Repeated lookups of the same pointer skip hashing the
+    //  string and only compare it to the cached copy.
+    XDP_CORE_EXPORT uint64_t addStaticString(const char* value);
     XDP_CORE_EXPORT void dumpTable(std::ofstream& fout);
+    XDP_CORE_EXPORT void dumpTable(VTFBinaryWriter& writer);
   };
 
 } // end namespace xdp
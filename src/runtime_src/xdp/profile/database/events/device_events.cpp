@@ -21,6 +21,7 @@
 
 #include "xdp/profile/database/events/device_events.h"
 #include "xdp/profile/database/static_info_database.h"
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
 
 namespace xdp {
   
@@ -53,9 +54,16 @@ namespace xdp {
   void VTFDeviceEvent::dump(std::ofstream& fout, uint32_t bucket)
   { 
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n";
   } 
 
+  void VTFDeviceEvent::dumpBinary(VTFBinaryRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    // Device timestamps are already in milliseconds
+    record.timestamp = timestamp ;
+  }
+
   KernelEvent::KernelEvent(uint64_t s_id, double ts, VTFEventType ty,
                            uint64_t devId, uint32_t monId, int32_t cuIdx)
              : VTFDeviceEvent(s_id, ts, ty, devId, monId),
@@ -88,7 +96,7 @@ namespace xdp {
   void KernelStall::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n";
   }
 
   DeviceMemoryAccess::DeviceMemoryAccess(uint64_t s_id, double ts, VTFEventType ty,
@@ -110,7 +118,13 @@ namespace xdp {
   void DeviceMemoryAccess::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << "," << memoryName << std::endl;
+    fout << "," << memoryName << "\n";
+  }
+
+  void DeviceMemoryAccess::dumpBinary(VTFBinaryRecord& record, uint32_t bucket)
+  {
+    VTFDeviceEvent::dumpBinary(record, bucket) ;
+    record.args[record.numArgs++] = memoryName ;
   }
 
   DeviceStreamAccess::DeviceStreamAccess(uint64_t s_id, double ts, VTFEventType ty,
@@ -50,6 +50,7 @@ namespace xdp {
     XDP_CORE_EXPORT ~VTFDeviceEvent() ;
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket);
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFBinaryRecord& record, uint32_t bucket);
 
     virtual bool     isDeviceEvent() { return true ; }
     virtual uint64_t getDevice()     { return deviceId ; }
@@ -107,6 +108,7 @@ namespace xdp {
     XDP_CORE_EXPORT ~DeviceMemoryAccess();
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket);
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFBinaryRecord& record, uint32_t bucket);
 
     virtual int32_t getCUId() { return cuId; }
 
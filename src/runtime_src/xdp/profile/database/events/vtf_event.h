@@ -25,6 +25,9 @@
 
 namespace xdp {
 
+  // Fixed width event record of the binary trace format
+  struct VTFBinaryRecord ;
+
   enum VTFEventType {
     // User level events
     USER_MARKER          = 0,
@@ -136,6 +139,12 @@ namespace xdp {
     virtual uint64_t getDevice() { return 0 ; } // CHECK
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
     XDP_CORE_EXPORT virtual void dumpSync(std::ofstream& /*fout*/, uint32_t /*bucket*/) {};
+    // Fill in the fixed width record used by the binary trace format
+    //  with the same information dump() writes as text
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFBinaryRecord& record, uint32_t bucket) ;
+
+    // Human readable name of an event type as used in trace files
+    XDP_CORE_EXPORT static const char* getTypeName(VTFEventType ty) ;
   } ;
 
   // Used so the database can sort based on timestamp order
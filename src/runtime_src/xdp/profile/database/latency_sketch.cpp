@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <algorithm>
+#include <cmath>
+
+#include "xdp/profile/database/latency_sketch.h"
+
+namespace xdp {
+
+  unsigned int LatencySketch::bucketIndex(double value)
+  {
+    // Everything below 1 ns is counted in the first bucket
+    if (!(value > 1.0))
+      return 0 ;
+
+    auto index = std::log2(value) * bucketsPerOctave ;
+    if (index >= numBuckets - 1)
+      return numBuckets - 1 ;
+    return static_cast<unsigned int>(index) ;
+  }
+
+  double LatencySketch::bucketValue(unsigned int index)
+  {
+    // Geometric middle of the bucket
+    return std::exp2((index + 0.5) / bucketsPerOctave) ;
+  }
+
+  void LatencySketch::record(double value)
+  {
+    ++buckets[bucketIndex(value)] ;
+    ++count ;
+    sum += value ;
+    minimum = std::min(minimum, value) ;
+    maximum = std::max(maximum, value) ;
+  }
+
+  void LatencySketch::merge(const LatencySketch& other)
+  {
+    for (unsigned int i = 0 ; i < numBuckets ; ++i)
+      buckets[i] += other.buckets[i] ;
+    count += other.count ;
+    sum += other.sum ;
+    minimum = std::min(minimum, other.minimum) ;
+    maximum = std::max(maximum, other.maximum) ;
+  }
+
+  double LatencySketch::quantile(double q) const
+  {
+    if (count == 0)
+      return 0 ;
+
+    q = std::clamp(q, 0.0, 1.0) ;
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) ;
+
+    uint64_t seen = 0 ;
+    for (unsigned int i = 0 ; i < numBuckets ; ++i) {
+      seen += buckets[i] ;
+      if (seen > rank)
+        return std::clamp(bucketValue(i), getMin(), getMax()) ;
+    }
+    return getMax() ;
+  }
+
+} // end namespace xdp
@@ -0,0 +1,69 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef LATENCY_SKETCH_DOT_H
+#define LATENCY_SKETCH_DOT_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "xdp/config.h"
+
+namespace xdp {
+
+  // A fixed size summary of a stream of durations that can answer
+  //  quantile queries.  Values are counted in logarithmically spaced
+  //  buckets, eight per power of two, so any quantile is reported with
+  //  a relative error of at most 4.5%.  The count, sum, minimum, and
+  //  maximum are exact.  Sketches of the same kind can be merged, which
+  //  is how per thread sketches are combined into per API results.
+  //
+  // Durations are expected in nanoseconds.  The buckets cover values up
+  //  to 2^48 ns (about 78 hours), larger values land in the last bucket.
+  class LatencySketch
+  {
+  public:
+    static constexpr unsigned int bucketsPerOctave = 8 ;
+    static constexpr unsigned int numOctaves = 48 ;
+    static constexpr unsigned int numBuckets = bucketsPerOctave * numOctaves ;
+
+  private:
+    std::array<uint64_t, numBuckets> buckets = {} ;
+    uint64_t count = 0 ;
+    double sum = 0 ;
+    double minimum = std::numeric_limits<double>::max() ;
+    double maximum = 0 ;
+
+    static unsigned int bucketIndex(double value) ;
+    static double bucketValue(unsigned int index) ;
+
+  public:
+    XDP_CORE_EXPORT void record(double value) ;
+    XDP_CORE_EXPORT void merge(const LatencySketch& other) ;
+
+    // Estimate of the value at quantile q (0.0 to 1.0)
+    XDP_CORE_EXPORT double quantile(double q) const ;
+
+    inline uint64_t getCount() const { return count ; }
+    inline double   getSum()   const { return sum ; }
+    inline double   getMin()   const { return count ? minimum : 0 ; }
+    inline double   getMax()   const { return maximum ; }
+  } ;
+
+} // end namespace xdp
+
+#endif
@@ -220,19 +220,10 @@ namespace xdp {
 
     auto threadId = std::this_thread::get_id();
     auto key      = std::make_pair(name, threadId);
-    auto value    = std::make_pair(timestamp, (double)0.0);
-
-    // Since a single thread can call a function multiple times, we store
-    // the starts in a vector.  If the thread makes a recursive call, we'll
-    // have multiple elements where the start value is set but the end value
-    // needs to be filled in.
-    if (callCount.find(key) == callCount.end()) {
-      std::vector<std::pair<double, double>> newVector;
-      newVector.push_back(value);
-      callCount[key] = newVector;
-    }
-    else
-      callCount[key].push_back(value);
+
+    // If the thread makes a recursive call, we'll have multiple start
+    // times waiting for the end of the call.
+    callCount[key].openCalls.push_back(timestamp);
 
     // OpenCL specific information 
     if (name == "clEnqueueMigrateMemObjects")
@@ -247,18 +238,16 @@ namespace xdp {
     auto threadId = std::this_thread::get_id();
     auto key      = std::make_pair(name, threadId);
 
-    // Since some calls might be recursive, we must go backwards to find
-    // the first call that has a start time set but no end time.  Since we've
-    // incorporated the thread id as part of our key, we will match recursive
-    // calls correctly
-    for (auto iter = callCount[key].rbegin();
-         iter != callCount[key].rend();
-         ++iter) {
-      if ((*iter).second == 0) {
-        (*iter).second = timestamp;
-        break;
-      }
-    }
+    // Since some calls might be recursive, the end matches the most
+    // recent start.  Since we've incorporated the thread id as part of
+    // our key, we will match recursive calls correctly
+    auto iter = callCount.find(key);
+    if (iter == callCount.end() || iter->second.openCalls.empty())
+      return;
+
+    auto& stats = iter->second;
+    stats.durations.record(timestamp - stats.openCalls.back());
+    stats.openCalls.pop_back();
   }
 
   void VPStatisticsDatabase::logMemoryTransfer(uint64_t deviceId,
@@ -277,6 +266,13 @@ namespace xdp {
     (memoryStats[deviceId]).channels[channelNum].totalByteCount += count;
   }
 
+  void VPStatisticsDatabase::logTraceOffload(uint64_t deviceId,
+                                             const TraceOffloadStatistics& stats)
+  {
+    std::lock_guard<std::mutex> lock(dbLock) ;
+    traceOffloadStats[deviceId] = stats ;
+  }
+
   void VPStatisticsDatabase::logDeviceActiveTime(const std::string& deviceName,
                                                  uint64_t startTime,
                                                  uint64_t endTime)
@@ -450,14 +446,9 @@ namespace xdp {
 
     for (const auto& c : callCount)
     {
-      if (counts.find(c.first.first) == counts.end())
-      {
-        counts[c.first.first] = c.second.size() ;
-      }
-      else
-      {
-        counts[c.first.first] += c.second.size() ;
-      }
+      // Calls that have not returned yet are counted as well
+      counts[c.first.first] +=
+        c.second.durations.getCount() + c.second.openCalls.size() ;
     }
 
     for (const auto& i : counts)
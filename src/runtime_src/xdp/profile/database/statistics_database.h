@@ -31,6 +31,7 @@
 #include "core/include/xdp/counters.h"
 
 #include "xdp/config.h"
+#include "xdp/profile/database/latency_sketch.h"
 
 namespace xdp {
 
@@ -148,6 +149,20 @@ namespace xdp {
     }
   } ;
 
+  // Statistics on the continuous offload of PL trace from one device
+  struct TraceOffloadStatistics
+  {
+    uint64_t bytesOffloaded = 0 ;
+    uint64_t bytesDecoded = 0 ;
+    uint64_t chunks = 0 ;
+    // Largest amount of offloaded trace waiting to be decoded
+    uint64_t maxDecodeLagBytes = 0 ;
+    // Number of times the device overwrote or filled its trace buffer
+    //  before the host read it
+    uint64_t drops = 0 ;
+    double offloadTimeMs = 0.0 ;
+  } ;
+
   struct MemoryChannelStatistics
   {
     uint64_t transactionCount ;
@@ -169,15 +184,26 @@ namespace xdp {
     MemoryChannelStatistics channels[6] ;
   } ;
 
+  // The FunctionCallStatistics struct keeps track of all calls to
+  //  one API from one thread
+  struct FunctionCallStatistics
+  {
+    // Start times of calls that have not yet returned.  More than one
+    //  only if the function is called recursively.
+    std::vector<double> openCalls ;
+    LatencySketch durations ;
+  } ;
+
   class VPStatisticsDatabase 
   {
   private:
     VPDatabase* db ;
 
   private:
-    // Statistics on API calls (OpenCL and HAL) have to be thread specific
+    // Statistics on API calls (OpenCL and HAL) have to be thread specific.
+    //  The memory used is independent of the number of calls.
     std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount ;
+             FunctionCallStatistics> callCount ;
 
     // **** User Level Event Statistics ****
     std::map<std::string, uint64_t> eventCounts ;
@@ -233,6 +259,9 @@ namespace xdp {
     // Keep track of the device start and end times
     std::map<std::string, std::pair<uint64_t, uint64_t>> deviceActiveTimes ;
 
+    // Keep track of the trace offload pipeline of each device
+    std::map<uint64_t, TraceOffloadStatistics> traceOffloadStats ;
+
     // Information used by trace parser
     double firstKernelStartTime ;
     double lastKernelEndTime ;
@@ -254,7 +283,7 @@ namespace xdp {
 
     // Getters and setters
     inline const std::map<std::pair<std::string, std::thread::id>,
-                    std::vector<std::pair<double, double>>>& getCallCount() 
+                    FunctionCallStatistics>& getCallCount() 
       { return callCount ; }
     inline const std::map<uint64_t, DeviceMemoryStatistics>& getMemoryStats() 
       { return memoryStats ; }
@@ -304,6 +333,8 @@ namespace xdp {
     inline void setCommandQueueOOO(uint64_t cq, bool value)
       { commandQueuesAreOOO[cq] = value ; }
     XDP_CORE_EXPORT uint64_t getDeviceActiveTime(const std::string& deviceName) ;
+    inline const std::map<uint64_t, TraceOffloadStatistics>& getTraceOffloadStats()
+      { return traceOffloadStats ; }
 
     // Functions specific to compute unit executions
     XDP_CORE_EXPORT
@@ -341,6 +372,10 @@ namespace xdp {
                                       DeviceMemoryStatistics::ChannelType channelType,
                                       size_t byteCount) ;
 
+    // Device offload statistic logging
+    XDP_CORE_EXPORT void logTraceOffload(uint64_t deviceId,
+                                         const TraceOffloadStatistics& stats) ;
+
     // OpenCL level statistic logging
     XDP_CORE_EXPORT void logDeviceActiveTime(const std::string& deviceName,
                                         uint64_t startTime,
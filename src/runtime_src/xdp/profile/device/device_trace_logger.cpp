@@ -17,6 +17,9 @@
 
 #define XDP_CORE_SOURCE
 
+#include <algorithm>
+#include <array>
+
 #include "xdp/profile/database/static_info/pl_constructs.h"
 #include "xdp/profile/device/device_trace_logger.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
@@ -31,6 +34,43 @@
 
 namespace xdp {
 
+  namespace {
+
+    enum PacketKind : uint8_t {
+      PACKET_IGNORED        = 0,
+      PACKET_CLOCK_TRAINING = 1,
+      PACKET_AM             = 2,
+      PACKET_AIM            = 4,
+      PACKET_ASM            = 8
+    } ;
+
+    constexpr uint64_t decodeBlockSize = 4096 ;
+
+    // The trace ID ranges of the monitor types do not overlap, so every
+    //  packet is of at most one kind
+    void classifyPackets(const uint64_t* packets, uint64_t count,
+                         uint8_t* kinds)
+    {
+      for (uint64_t i = 0 ; i < count ; ++i) {
+        uint64_t packet  = packets[i] ;
+        uint64_t traceId = (packet >> 49) & 0xFFF ;
+        uint64_t training = packet >> 63 ;
+
+        uint64_t am   = (traceId >= util::min_trace_id_am) &
+                        (traceId <= util::max_trace_id_am) ;
+        uint64_t aim  = (traceId <= util::max_trace_id_aim) ;
+        uint64_t asmn = (traceId >= util::min_trace_id_asm) &
+                        (traceId <  util::max_trace_id_asm) ;
+        uint64_t monitor = (am * PACKET_AM) | (aim * PACKET_AIM)
+                         | (asmn * PACKET_ASM) ;
+
+        kinds[i] = static_cast<uint8_t>((training * PACKET_CLOCK_TRAINING)
+                                        | ((training ^ 1) * monitor)) ;
+      }
+    }
+
+  } // end anonymous namespace
+
   DeviceTraceLogger::DeviceTraceLogger(uint64_t devId)
     : deviceId(devId),
       db(VPDatabase::Instance()),
@@ -699,21 +739,19 @@ namespace xdp {
   // corresponding host timestamps.  We need at least two training packets
   // to plot a line and get the slopes we use for adjusting timestamps.
   // As the device progresses, we'll encounter additional training packets and
-  // they may not be continuous, so this function uses static variables
-  // to keep track of the last packet we've seen.
+  // they may not be continuous, so this function keeps the last packet
+  // we've seen in clockTrainX1 and clockTrainY1.
   void DeviceTraceLogger::trainDeviceHostTimestamps(uint64_t deviceTimestamp, uint64_t hostTimestamp)
   {
-    static double y1 = 0.0;
-    static double y2 = 0.0;
-    static double x1 = 0.0;
-    static double x2 = 0.0;
+    double& y1 = clockTrainY1;
+    double& x1 = clockTrainX1;
 
     if (!y1 && !x1) {
       y1 = static_cast <double> (hostTimestamp);
       x1 = static_cast <double> (deviceTimestamp);
     } else {
-      y2 = static_cast <double> (hostTimestamp);
-      x2 = static_cast <double> (deviceTimestamp);
+      double y2 = static_cast <double> (hostTimestamp);
+      double x2 = static_cast <double> (deviceTimestamp);
       // slope in ns/cycle
       if (xdp::getFlowMode() == HW) {
         clockTrainSlope = 1000.0/traceClockRateMHz;
@@ -733,6 +771,33 @@ namespace xdp {
     return ((clockTrainSlope * (double)deviceTimestamp) + clockTrainOffset)/1e6;
   }
 
+  void DeviceTraceLogger::addClockTrainingPacket(uint64_t trace)
+  {
+    auto clockTrainingDeviceTimestamp = getDeviceTimestamp(trace);
+
+    if (clockTrainingModulus == 0) {
+      if (clockTrainingDeviceTimestamp >= firstTimestamp) {
+        clockTrainingDeviceTimestamp =
+          clockTrainingDeviceTimestamp - firstTimestamp;
+      }
+      else {
+        clockTrainingDeviceTimestamp =
+          clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
+      }
+    }
+    clockTrainingHostTimestamp |=
+      ((trace >> 45) & 0xFFFF) << (16 * clockTrainingModulus);
+    ++clockTrainingModulus;
+    if (clockTrainingModulus == 4) {
+      // It requires four complete clock training packets before
+      //  we can perform the clock training algorithm
+      trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
+                                clockTrainingHostTimestamp);
+      clockTrainingHostTimestamp = 0;
+      clockTrainingModulus = 0;
+    }
+  }
+
   void DeviceTraceLogger::processTraceData(void* data, uint64_t numBytes)
   {
     if (numBytes == 0)
@@ -740,94 +805,62 @@ namespace xdp {
     if (!VPDatabase::alive())
       return;
 
+    auto packets = static_cast<uint64_t*>(data);
     uint64_t numPackets = numBytes / sizeof(uint64_t);
     uint64_t start = 0;
 
     // Try to find 8 contiguous clock training packets.  Anything before that
     //  is garbage from the previous run
     // Note: This needs to be done only in beginning chunk of data
-    static bool found = false;
-    if (!found) {
-      for (uint64_t i = 0; i < numPackets - 8; ++i) {
+    if (!foundClockTraining) {
+      for (uint64_t i = 0; i + 8 <= numPackets; ++i) {
         for (uint64_t j = i; j < i + 8; ++j) {
-          uint64_t packet = (static_cast<uint64_t*>(data))[j];
-          if (!isClockTraining(packet))
+          if (!isClockTraining(packets[j]))
             break;
           if (j == (i + 7)) {
             start = i ;
-            found = true;
+            foundClockTraining = true;
           }
         }
-        if (found)
+        if (foundClockTraining)
           break;
       }
     }
 
-    // Clock Training state is preserved across calls
-    static uint32_t modulus = 0;
-    static uint64_t clockTrainingHostTimestamp = 0;
+    // Packets are classified a block at a time in a branch free loop
+    //  the compiler can vectorize, so the in-order pass below only
+    //  looks at the packets that produce events.  The events themselves
+    //  must be created in packet order as the end of a CU execution
+    //  closes outstanding transfers on the other monitors.
+    std::array<uint8_t, decodeBlockSize> kinds;
 
-    for (uint64_t i = start ; i < numPackets ; ++i) {
-      uint64_t packet = (static_cast<uint64_t*>(data))[i];
-      auto deviceTimestamp = getDeviceTimestamp(packet);
-      auto traceId = getTraceId(packet);
-      auto clockTrainingDeviceTimestamp = deviceTimestamp;
+    for (uint64_t block = start ; block < numPackets ; block += decodeBlockSize) {
+      uint64_t blockSize = std::min<uint64_t>(decodeBlockSize, numPackets - block);
+      classifyPackets(packets + block, blockSize, kinds.data());
 
-      /*
-      if (i == start && firstTimestamp == 0) {
-        firstTimestamp = deviceTimestamp ;
-      }
-      */
+      for (uint64_t i = 0 ; i < blockSize ; ++i) {
+        if (kinds[i] == PACKET_IGNORED)
+          continue;
 
-      if (isClockTraining(packet)) {
-        if (modulus == 0) {
-          if (clockTrainingDeviceTimestamp >= firstTimestamp) {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp - firstTimestamp;
-          }
-          else {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
-          }
-        }
-        clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * modulus);
-        ++modulus;
-        if (modulus == 4) {
-          // It requires four complete clock training packets before
-          //  we can perform the clock training algorithm
-          trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
-                                    clockTrainingHostTimestamp);
-          clockTrainingHostTimestamp = 0;
-          clockTrainingDeviceTimestamp = 0;
-          modulus = 0;
+        uint64_t packet = packets[block + i];
+        if (kinds[i] == PACKET_CLOCK_TRAINING) {
+          addClockTrainingPacket(packet);
+          continue;
         }
-        continue;
-      }
 
-      bool AMPacket  = (traceId >= util::min_trace_id_am &&
-                        traceId <= util::max_trace_id_am);
-      bool AIMPacket = (traceId <= util::max_trace_id_aim); // min trace id aim == 0
-      bool ASMPacket = (traceId >= util::min_trace_id_asm &&
-                        traceId <  util::max_trace_id_asm);
-      if (!AMPacket && !AIMPacket && !ASMPacket) {
-        continue;
-      }
-
-      double hostTimestamp = convertDeviceToHostTimestamp(deviceTimestamp);
-      if (AMPacket) {
-        addAMEvent(packet, hostTimestamp);
-      }
-      if (AIMPacket) {
-        addAIMEvent(packet, hostTimestamp);
+        double hostTimestamp =
+          convertDeviceToHostTimestamp(getDeviceTimestamp(packet));
+        if (kinds[i] == PACKET_AM)
+          addAMEvent(packet, hostTimestamp);
+        else if (kinds[i] == PACKET_AIM)
+          addAIMEvent(packet, hostTimestamp);
+        else
+          addASMEvent(packet, hostTimestamp);
+
+        // keep track of latest timestamp that comes through trace
+        mLatestHostTimestampMs = hostTimestamp;
       }
-      if (ASMPacket) {
-        addASMEvent(packet, hostTimestamp);
-      }
-
-      // keep track of latest timestamp that comes through trace
-      mLatestHostTimestampMs = hostTimestamp;
     }
-
   }
 
   void DeviceTraceLogger::endProcessTraceData()
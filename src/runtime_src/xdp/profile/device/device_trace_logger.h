@@ -62,9 +62,19 @@ namespace xdp {
     double traceClockRateMHz;
     double clockTrainSlope;
 
+    // Clock training state preserved across calls to processTraceData.
+    //  Four consecutive training packets carry one host timestamp, and
+    //  two host/device timestamp pairs are needed to compute the slope.
+    bool foundClockTraining = false;
+    uint32_t clockTrainingModulus = 0;
+    uint64_t clockTrainingHostTimestamp = 0;
+    double clockTrainX1 = 0.0;
+    double clockTrainY1 = 0.0;
+
     bool warnCUIncomplete=false;
 
     void trainDeviceHostTimestamps(uint64_t deviceTimestamp, uint64_t hostTimestamp);
+    void addClockTrainingPacket(uint64_t trace);
     double convertDeviceToHostTimestamp(uint64_t deviceTimestamp);
 
     // Functions for adding device events based on the monitor type
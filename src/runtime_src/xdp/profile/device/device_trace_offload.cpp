@@ -64,6 +64,7 @@ void DeviceTraceOffload::
 offload_device_continuous()
 {
   if (!m_initialized) {
+    stop_process_trace();
     offload_finished();
     return;
   }
@@ -79,9 +80,8 @@ offload_device_continuous()
   // Note : Passing "true" also flushes and resets the datamover
   m_read_trace(true);
 
-  // Stop processing thread
-  m_process_trace = false;
-  while (!m_process_trace_done);
+  // Stop processing thread once it has decoded everything
+  stop_process_trace();
 
   // Clear all state and add approximations
   read_trace_end();
@@ -90,6 +90,15 @@ offload_device_continuous()
   offload_finished();
 }
 
+void DeviceTraceOffload::
+stop_process_trace()
+{
+  std::unique_lock<std::mutex> lock(ts2mm_info.process_queue_lock);
+  m_process_trace = false;
+  ts2mm_info.process_queue_cv.notify_all();
+  ts2mm_info.process_queue_cv.wait(lock, [this] { return m_process_trace_done.load(); });
+}
+
 void DeviceTraceOffload::
 train_clock_continuous()
 {
@@ -101,22 +110,28 @@ train_clock_continuous()
   offload_finished();
 }
 
+// Decode trace as soon as the offload thread has synced it, so reading
+// the device buffer and decoding the previous chunk overlap.
 void DeviceTraceOffload::
 process_trace_continuous()
 {
-  if (!has_ts2mm())
-    return;
-
-  m_process_trace = true;
-  m_process_trace_done = false;
-  while (m_process_trace)
-  {
+  if (has_ts2mm()) {
+    while (m_process_trace) {
+      {
+        std::unique_lock<std::mutex> lock(ts2mm_info.process_queue_lock);
+        ts2mm_info.process_queue_cv.wait(lock, [this] {
+          return !ts2mm_info.data_queue.empty() || !m_process_trace;
+        });
+      }
+      process_trace();
+    }
+    // One last time
     process_trace();
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
   }
-  // One last time
-  process_trace();
+
+  std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
   m_process_trace_done = true;
+  ts2mm_info.process_queue_cv.notify_all();
 }
 
 void DeviceTraceOffload::
@@ -125,22 +140,19 @@ process_trace()
   if (!has_ts2mm())
     return;
 
+  TraceChunk chunk;
   bool q_read = false;
   bool q_empty = true;
-  std::unique_ptr<unsigned char[]> buf;
-  uint64_t size = 0;
   do {
     q_read=false;
     ts2mm_info.process_queue_lock.lock();
     if (!ts2mm_info.data_queue.empty()) {
-      buf = std::move(ts2mm_info.data_queue.front());
-      size = ts2mm_info.size_queue.front();
-      ts2mm_info.data_queue.pop();
-      ts2mm_info.size_queue.pop();
+      chunk = std::move(ts2mm_info.data_queue.front());
+      ts2mm_info.data_queue.pop_front();
       q_read = true;
       q_empty = ts2mm_info.data_queue.empty();
     }
-    if (ts2mm_info.size_queue.size() > TS2MM_QUEUE_SZ_WARN_THRESHOLD) {
+    if (ts2mm_info.data_queue.size() > TS2MM_QUEUE_SZ_WARN_THRESHOLD) {
       std::call_once(ts2mm_queue_warning_flag, [](){
         xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_QUEUE_SZ);
       });
@@ -149,9 +161,15 @@ process_trace()
 
     // Processing takes a lot more time compared to everything else
     if (q_read) {
-      debug_stream << "Process " << size << " bytes of trace" << std::endl;
-      deviceTraceLogger->processTraceData(buf.get(), size) ;
-      buf.reset();
+      debug_stream << "Process " << chunk.size << " bytes of trace" << std::endl;
+      deviceTraceLogger->processTraceData(chunk.data.get(), chunk.size) ;
+
+      std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+      ts2mm_info.queued_bytes -= chunk.size;
+      ts2mm_info.stats.bytesDecoded += chunk.size;
+      if (ts2mm_info.free_chunks.size() < TS2MM_HOST_RING_SIZE)
+        ts2mm_info.free_chunks.push_back(std::move(chunk));
+      chunk = TraceChunk();
     }
   } while (!q_empty);
 }
@@ -173,6 +191,9 @@ start_offload(OffloadThreadType type)
   status = OffloadThreadStatus::RUNNING;
 
   if (type == OffloadThreadType::TRACE) {
+    // Set before either thread starts so a quick stop cannot be missed
+    m_process_trace = true;
+    m_process_trace_done = false;
     offload_thread = std::thread(&DeviceTraceOffload::offload_device_continuous, this);
     process_thread = std::thread(&DeviceTraceOffload::process_trace_continuous, this);
   } else if (type == OffloadThreadType::CLOCK_TRAIN) {
@@ -259,6 +280,7 @@ read_trace_init(bool circ_buf, const std::vector<uint64_t> &buf_sizes)
 {
   if (has_ts2mm()) {
     m_initialized = init_s2mm(circ_buf, buf_sizes);
+    m_offload_start = std::chrono::steady_clock::now();
   } else if (has_fifo()) {
     m_initialized = true;
   } else {
@@ -282,6 +304,11 @@ read_trace_end()
   if (dev_intf->hasTs2mm()) {
     reset_s2mm();
     m_initialized = false;
+
+    std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - m_offload_start;
+    std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+    ts2mm_info.stats.offloadTimeMs = elapsed.count();
   }
 }
 
@@ -311,6 +338,7 @@ read_trace_s2mm(bool force)
         << std::endl;
 
       // Add warnings and user markers
+      add_drop();
       xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_CIRC_BUF_OVERWRITE);
       xrt::profile::user_event events;
       events.mark("Trace Buffer Overwrite Detected");
@@ -393,13 +421,21 @@ sync_and_log(uint64_t index)
     return false;
   }
 
-  auto tmp = std::make_unique<unsigned char[]>(nBytes);
-  std::memcpy(tmp.get(), host_buf, nBytes);
+  auto chunk = get_free_chunk(nBytes);
+  std::memcpy(chunk.data.get(), host_buf, nBytes);
+  chunk.size = nBytes;
+
   // Push new data into queue for processing
-  ts2mm_info.process_queue_lock.lock();
-  ts2mm_info.data_queue.push(std::move(tmp));
-  ts2mm_info.size_queue.push(nBytes);
-  ts2mm_info.process_queue_lock.unlock();
+  {
+    std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+    ts2mm_info.data_queue.push_back(std::move(chunk));
+    ts2mm_info.queued_bytes += nBytes;
+    ts2mm_info.stats.bytesOffloaded += nBytes;
+    ++ts2mm_info.stats.chunks;
+    if (ts2mm_info.queued_bytes > ts2mm_info.stats.maxDecodeLagBytes)
+      ts2mm_info.stats.maxDecodeLagBytes = ts2mm_info.queued_bytes;
+  }
+  ts2mm_info.process_queue_cv.notify_one();
 
   // Print warning if processing large amount of trace
   if (nBytes > TS2MM_WARN_BIG_BUF_SIZE && !bd.big_trace_warn_done) {
@@ -407,12 +443,51 @@ sync_and_log(uint64_t index)
     bd.big_trace_warn_done = true;
   }
 
-  if (bd.used_size == bd.alloc_size && ts2mm_info.use_circ_buf == false)
+  if (bd.used_size == bd.alloc_size && ts2mm_info.use_circ_buf == false && !bd.full) {
     bd.full = true;
+    add_drop();
+  }
 
   return true;
 }
 
+// Reuse the host memory of an already decoded chunk if one is large
+// enough, otherwise allocate a new one
+TraceChunk DeviceTraceOffload::
+get_free_chunk(uint64_t size)
+{
+  {
+    std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+    auto& chunks = ts2mm_info.free_chunks;
+    for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+      if (it->capacity < size)
+        continue;
+      TraceChunk chunk = std::move(*it);
+      chunks.erase(it);
+      return chunk;
+    }
+  }
+
+  TraceChunk chunk;
+  chunk.data = std::make_unique<unsigned char[]>(size);
+  chunk.capacity = size;
+  return chunk;
+}
+
+void DeviceTraceOffload::
+add_drop()
+{
+  std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+  ++ts2mm_info.stats.drops;
+}
+
+TraceOffloadStatistics DeviceTraceOffload::
+get_offload_stats()
+{
+  std::lock_guard<std::mutex> lock(ts2mm_info.process_queue_lock);
+  return ts2mm_info.stats;
+}
+
 bool DeviceTraceOffload::
 init_s2mm(bool circ_buf, const std::vector<uint64_t> &buf_sizes)
 {
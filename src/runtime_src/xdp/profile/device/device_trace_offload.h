@@ -20,6 +20,7 @@
 
 #include "core/common/message.h"
 #include "xdp/config.h"
+#include "xdp/profile/database/statistics_database.h"
 #include "xdp/profile/device/device_intf.h"
 #include "xdp/profile/device/device_trace_logger.h"
 #include "xdp/profile/device/tracedefs.h"
@@ -27,14 +28,16 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace xdp {
 
@@ -77,6 +80,12 @@ struct TraceBufferInfo {
        
 };
 
+struct TraceChunk {
+  std::unique_ptr<unsigned char[]> data;
+  uint64_t capacity = 0;
+  uint64_t size = 0;
+};
+
 struct Ts2mmInfo {
   size_t   num_ts2mm;
   uint64_t full_buf_size;
@@ -89,9 +98,16 @@ struct Ts2mmInfo {
   uint64_t circ_buf_min_rate = TS2MM_DEF_BUF_SIZE * 100;
   uint64_t circ_buf_cur_rate;
 
-  std::queue<std::unique_ptr<unsigned char[]>> data_queue;
-  std::queue<uint64_t> size_queue;
+  // Trace synced from the device waits in data_queue until it is
+  //  decoded.  Decoded chunks go back to free_chunks so the offload
+  //  thread can reuse the host memory.
+  std::deque<TraceChunk> data_queue;
+  std::vector<TraceChunk> free_chunks;
+  uint64_t queued_bytes = 0;
   std::mutex process_queue_lock;
+  std::condition_variable process_queue_cv;
+
+  TraceOffloadStatistics stats;
 
   Ts2mmInfo()
     : num_ts2mm(0),
@@ -128,6 +144,8 @@ public:
   void process_trace();
   XDP_CORE_EXPORT
   bool trace_buffer_full();
+  XDP_CORE_EXPORT
+  TraceOffloadStatistics get_offload_stats();
 
 public:
   bool has_fifo() {
@@ -168,7 +186,10 @@ private:
   void offload_device_continuous();
   void offload_finished();
   void process_trace_continuous();
+  void stop_process_trace();
   bool sync_and_log(uint64_t index);
+  TraceChunk get_free_chunk(uint64_t size);
+  void add_drop();
 
 protected:
   DeviceIntf* dev_intf;
@@ -191,6 +212,8 @@ private:
   std::thread process_thread;
   bool continuous = false;
 
+  std::chrono::time_point<std::chrono::steady_clock> m_offload_start;
+
   // Clock Training Params
   bool m_force_clk_train = true;
   std::chrono::time_point<std::chrono::system_clock> m_prev_clk_train_time;
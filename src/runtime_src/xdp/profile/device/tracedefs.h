@@ -54,6 +54,8 @@
 // Throw warning when too much trace in processing pipeline
 // Use some arbitrary large number here
 #define TS2MM_QUEUE_SZ_WARN_THRESHOLD 5000
+// Number of host buffers kept for reuse between trace offload and decode
+#define TS2MM_HOST_RING_SIZE 8
 
 // In some cases, we cannot use coarse mode
 #define COARSE_MODE_UNSUPPORTED "Coarse mode cannot be enabled. Defaulting to fine mode. Please check compilation for details."
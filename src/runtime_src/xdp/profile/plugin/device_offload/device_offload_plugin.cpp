@@ -133,15 +133,20 @@ namespace xdp {
     std::string xrtVersion   = xdp::getXRTVersion() ;
     std::string toolVersion  = xdp::getToolVersion() ;
 
+    // The binary format is much cheaper to produce when continuously
+    //  offloading large amounts of trace, but must be converted to csv
+    //  before it can be viewed.
+    bool binary = (xrt_core::config::get_device_trace_file_format() == "binary") ;
     std::string filename = 
-      "device_trace_" + std::to_string(deviceId) + ".csv" ;
+      "device_trace_" + std::to_string(deviceId) + (binary ? ".vtfb" : ".csv") ;
 
     VPWriter* writer = new DeviceTraceWriter(filename.c_str(),
                                              deviceId,
                                              version,
                                              creationTime,
                                              xrtVersion,
-                                             toolVersion);
+                                             toolVersion,
+                                             binary);
     writers.push_back(writer);
     (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
 
@@ -415,6 +420,7 @@ namespace xdp {
       auto offloader = std::get<0>(o.second) ;
       flushTraceOffloader(offloader);
       checkTraceBufferFullness(offloader, o.first);
+      logTraceOffloadStatistics(offloader, o.first);
     }
 
     // Also, store away the counter results
@@ -432,6 +438,13 @@ namespace xdp {
     }
   }
 
+  void DeviceOffloadPlugin::logTraceOffloadStatistics(DeviceTraceOffload* offloader, uint64_t deviceId)
+  {
+    if (!device_trace || !offloader || !offloader->has_ts2mm())
+      return;
+    db->getStats().logTraceOffload(deviceId, offloader->get_offload_stats());
+  }
+
   void DeviceOffloadPlugin::broadcast(VPDatabase::MessageType msg, void* /*blob*/)
   {
     switch(msg)
@@ -72,6 +72,7 @@ namespace xdp {
     void readCounters() ;
     virtual void readTrace() = 0 ;
     void checkTraceBufferFullness(DeviceTraceOffload* offloader, uint64_t deviceId) ;
+    void logTraceOffloadStatistics(DeviceTraceOffload* offloader, uint64_t deviceId) ;
     bool flushTraceOffloader(DeviceTraceOffload* offloader);
 
   public:
@@ -93,6 +93,7 @@ namespace xdp {
       auto offloader = std::get<0>(o.second) ;
       flushTraceOffloader(offloader);
       checkTraceBufferFullness(offloader, o.first);
+      logTraceOffloadStatistics(offloader, o.first);
     }
   }
 
@@ -76,6 +76,7 @@ namespace xdp {
       auto offloader = std::get<0>(o.second) ;
       flushTraceOffloader(offloader);
       checkTraceBufferFullness(offloader, o.first);
+      logTraceOffloadStatistics(offloader, o.first);
     }
   }
 
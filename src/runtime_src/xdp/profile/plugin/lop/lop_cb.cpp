@@ -44,7 +44,7 @@ namespace xdp {
     VTFEvent* event = new OpenCLAPICall(0,
                                         timestamp,
                                         functionID,
-                                        (db->getDynamicInfo()).addString(functionName),
+                                        (db->getDynamicInfo()).addStaticString(functionName),
                                         queueAddress,
                                         true); // is Low Overhead
     (db->getDynamicInfo()).addEvent(event) ;
@@ -66,7 +66,7 @@ namespace xdp {
     VTFEvent* event = new OpenCLAPICall(start,
                                         timestamp,
                                         functionID,
-                                        (db->getDynamicInfo()).addString(functionName),
+                                        (db->getDynamicInfo()).addStaticString(functionName),
                                         queueAddress,
                                         true) ; // is Low Overhead
     (db->getDynamicInfo()).addEvent(event) ;
@@ -58,7 +58,7 @@ void native_function_start(const char* functionName,
   xdp::VTFEvent* event =
     new xdp::NativeAPICall(0,
                            0,
-                           db->getDynamicInfo().addString(functionName));
+                           db->getDynamicInfo().addStaticString(functionName));
   db->getDynamicInfo().addUnsortedEvent(event);
   db->getDynamicInfo().markStart(static_cast<uint64_t>(functionID),
                                  event->getEventId());
@@ -91,7 +91,7 @@ void native_function_end(const char* functionName,
   xdp::VTFEvent* event =
     new xdp::NativeAPICall(start,
                            static_cast<double>(timestamp),
-                           db->getDynamicInfo().addString(functionName));
+                           db->getDynamicInfo().addStaticString(functionName));
   db->getDynamicInfo().addUnsortedEvent(event);
 }
 
@@ -118,7 +118,7 @@ void native_sync_start(const char* functionName,
   xdp::VTFEvent* APIEvent      = nullptr;
   xdp::VTFEvent* transferEvent = nullptr;
 
-  auto functionStr = db->getDynamicInfo().addString(functionName);
+  auto functionStr = db->getDynamicInfo().addStaticString(functionName);
   APIEvent = new xdp::NativeAPICall(0, 0, functionStr);
   if (isWrite)
     transferEvent = new xdp::NativeSyncWrite(0, 0, functionStr);
@@ -170,7 +170,7 @@ void native_sync_end(const char* functionName, unsigned long long int functionID
   xdp::VTFEvent* APIEvent = nullptr;
   xdp::VTFEvent* transferEvent = nullptr;
 
-  auto functionStr = db->getDynamicInfo().addString(functionName);
+  auto functionStr = db->getDynamicInfo().addStaticString(functionName);
 
   APIEvent = new xdp::NativeAPICall(startEvents.APIEventId,
                                     static_cast<double>(timestamp),
@@ -186,7 +186,7 @@ void native_sync_end(const char* functionName, unsigned long long int functionID
     transferEvent =
       new xdp::NativeSyncRead(startEvents.transferEventId,
                               static_cast<double>(timestamp),
-                              db->getDynamicInfo().addString(functionName));
+                              db->getDynamicInfo().addStaticString(functionName));
   }
   db->getDynamicInfo().addUnsortedEvent(APIEvent);
   db->getDynamicInfo().addUnsortedEvent(transferEvent);
@@ -14,10 +14,15 @@
  * under the License.
  */
 
-#include <fstream>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <string>
-#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/device/device_trace_logger.h"
@@ -33,12 +38,30 @@ int main(int argc, char* argv[])
   std::string traceFile  = argv[1];
   std::string xclbinFile = argv[2];
 
-  std::ifstream fin(traceFile, std::ios::binary|std::ios::in);
-  if (!fin) {
+  // Map the raw trace file instead of reading it packet by packet.
+  //  Trace dumps can be several GB and are only read once, front to back.
+  int fd = open(traceFile.c_str(), O_RDONLY);
+  if (fd < 0) {
     std::cerr << "Cannot open raw trace file " << traceFile << std::endl;
     return 0;
   }
 
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    std::cerr << "Cannot read raw trace file " << traceFile << std::endl;
+    close(fd);
+    return 0;
+  }
+  uint64_t fileSize = static_cast<uint64_t>(info.st_size);
+
+  void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    std::cerr << "Cannot map raw trace file " << traceFile << std::endl;
+    return 0;
+  }
+  madvise(mapped, fileSize, MADV_SEQUENTIAL);
+
   // Create a database to store and interpret the events
   xdp::VPDatabase* db = xdp::VPDatabase::Instance();
 
@@ -48,27 +71,24 @@ int main(int argc, char* argv[])
 
   db->getStaticInfo().updateDevice(deviceId, xclbinFile);
 
-  std::vector<uint64_t> traceData;
-
-  uint64_t packet = 0;
-  char* ch = reinterpret_cast<char*>(&packet);
-
-  while(fin.read(ch, 8)) {
-    traceData.push_back(packet);
-  }
-  fin.close();
+  // Add all of the events to the database.  The logger keeps its
+  //  decoding state between calls, so hand it the file in chunks the
+  //  same way the offload thread hands it the device buffers.
+  constexpr uint64_t chunkBytes = 64 * 1024 * 1024;
+  uint64_t numBytes = fileSize - (fileSize % sizeof(uint64_t));
+  auto traceData = static_cast<char*>(mapped);
 
-  // Add all of the events to the database
   xdp::DeviceTraceLogger logger(deviceId);
-  uint64_t numBytes = sizeof(uint64_t)*traceData.size();
-  logger.processTraceData(traceData.data(), numBytes);
+  for (uint64_t offset = 0; offset < numBytes; offset += chunkBytes) {
+    uint64_t size = std::min(chunkBytes, numBytes - offset);
+    logger.processTraceData(traceData + offset, size);
+  }
+  munmap(mapped, fileSize);
 
   // Create a writer and have it write.
   xdp::DeviceTraceWriter writer("output.csv", deviceId, "1.1", xdp::getCurrentDateTime(), xdp::getXRTVersion(), xdp::getToolVersion());
   writer.write(false);
 
-  fin.close();
-
   return 0;
 }
 
@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
+
+// Convert a binary device trace file (Debug.device_trace_file_format=binary)
+//  into the CSV trace file that would have been written by default.
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    std::cout << "Usage: " << argv[0] << " <Binary Trace File> <CSV Output File>\n";
+    return 1;
+  }
+
+  std::ifstream fin(argv[1], std::ios::binary|std::ios::in);
+  if (!fin) {
+    std::cerr << "Cannot open binary trace file " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::ofstream fout(argv[2]);
+  if (!fout) {
+    std::cerr << "Cannot open output file " << argv[2] << std::endl;
+    return 1;
+  }
+
+  if (!xdp::convertVTFBinaryToCSV(fin, fout)) {
+    std::cerr << argv[1] << " is not a valid binary trace file" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
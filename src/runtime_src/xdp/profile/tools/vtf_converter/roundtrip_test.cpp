@@ -0,0 +1,143 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "xdp/profile/database/dynamic_info/string_table.h"
+#include "xdp/profile/database/events/device_events.h"
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
+
+// Write the same string table and device events once as CSV, the way
+//  the device trace writer does, and once in the binary format.  The
+//  binary file converted back to CSV must be identical to the CSV file.
+
+namespace {
+
+struct TraceEvent
+{
+  std::unique_ptr<xdp::VTFDeviceEvent> event;
+  uint32_t bucket;
+  // Kernel events carry the kernel and CU name tooltips
+  std::vector<uint64_t> tooltips;
+};
+
+std::string readFile(const std::string& name)
+{
+  std::ifstream fin(name, std::ios::binary);
+  std::stringstream contents;
+  contents << fin.rdbuf();
+  return contents.str();
+}
+
+void writeCSV(const std::string& name, xdp::StringTable& table,
+              const std::vector<TraceEvent>& events)
+{
+  std::ofstream fout(name);
+  fout << "MAPPING\n";
+  table.dumpTable(fout);
+  fout << "\nEVENTS\n";
+  for (auto& e : events) {
+    e.event->dump(fout, e.bucket);
+    if (e.event->getEventType() != xdp::KERNEL)
+      continue;
+    for (auto tooltip : e.tooltips)
+      fout << "," << tooltip;
+    fout << "\n";
+  }
+  fout << "\n";
+}
+
+void writeBinary(const std::string& name, xdp::StringTable& table,
+                 const std::vector<TraceEvent>& events)
+{
+  std::ofstream fout(name, std::ios::binary);
+  xdp::VTFBinaryWriter writer(fout);
+  writer.writeFileHeader();
+  writer.writeText("MAPPING\n");
+  table.dumpTable(writer);
+  writer.writeText("\nEVENTS\n");
+  for (auto& e : events) {
+    xdp::VTFBinaryRecord record = {};
+    e.event->dumpBinary(record, e.bucket);
+    for (auto tooltip : e.tooltips)
+      record.args[record.numArgs++] = tooltip;
+    writer.writeEvent(record);
+  }
+  writer.writeText("\n");
+  writer.flush();
+}
+
+} // end namespace
+
+int main()
+{
+  const std::string csvFile = "roundtrip_test.csv";
+  const std::string binaryFile = "roundtrip_test.bin";
+  const std::string convertedFile = "roundtrip_test_converted.csv";
+
+  xdp::StringTable table;
+  uint64_t kernelName = table.addString("vadd");
+  uint64_t cuName = table.addString("vadd_1");
+  uint64_t memoryName = table.addString("bank0");
+
+  std::vector<TraceEvent> events;
+  auto add = [&events](xdp::VTFDeviceEvent* event, uint32_t bucket,
+                       std::vector<uint64_t> tooltips = {}) {
+    event->setEventId(events.size() + 1);
+    events.push_back({std::unique_ptr<xdp::VTFDeviceEvent>(event), bucket, std::move(tooltips)});
+  };
+
+  // Timestamps with more precision than the CSV file keeps check that
+  //  both paths round the same way
+  add(new xdp::KernelEvent(0, 0.1234564, xdp::KERNEL, 0, 0, 0), 1, {kernelName, cuName});
+  add(new xdp::KernelStall(0, 0.2000001, xdp::KERNEL_STALL_DATAFLOW, 0, 0, 0), 3);
+  add(new xdp::DeviceMemoryAccess(0, 0.25, xdp::KERNEL_READ, 0, 0, 0, memoryName), 5);
+  add(new xdp::DeviceMemoryAccess(3, 0.5, xdp::KERNEL_READ, 0, 0, 0, memoryName), 5);
+  add(new xdp::DeviceStreamAccess(0, 0.75, xdp::KERNEL_STREAM_WRITE, 0, 0, 0), 7);
+  add(new xdp::DeviceStreamAccess(5, 1.0, xdp::KERNEL_STREAM_WRITE, 0, 0, 0), 7);
+  add(new xdp::KernelStall(2, 1.5, xdp::KERNEL_STALL_DATAFLOW, 0, 0, 0), 3);
+  add(new xdp::KernelEvent(1, 123456.789012, xdp::KERNEL, 0, 0, 0), 1, {kernelName, cuName});
+
+  writeCSV(csvFile, table, events);
+  writeBinary(binaryFile, table, events);
+
+  {
+    std::ifstream fin(binaryFile, std::ios::binary);
+    std::ofstream fout(convertedFile);
+    if (!xdp::convertVTFBinaryToCSV(fin, fout)) {
+      std::cout << binaryFile << " is not a valid binary trace file" << std::endl;
+      std::cout << "FAILED TEST" << std::endl;
+      return 1;
+    }
+  }
+
+  std::string expected = readFile(csvFile);
+  std::string converted = readFile(convertedFile);
+  if (expected != converted) {
+    std::cout << "Converted trace differs from the CSV trace\n"
+              << "Expected:\n" << expected << "Converted:\n" << converted;
+    std::cout << "FAILED TEST" << std::endl;
+    return 1;
+  }
+
+  std::cout << "PASSED TEST" << std::endl;
+  return 0;
+}
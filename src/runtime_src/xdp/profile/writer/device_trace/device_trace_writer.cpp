@@ -17,12 +17,15 @@
 
 #define XDP_PLUGIN_SOURCE
 
+#include "core/common/message.h"
+
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/database/events/device_events.h"
 #include "xdp/profile/database/static_info/pl_constructs.h"
 #include "xdp/profile/database/static_info/xclbin_info.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
 #include "xdp/profile/writer/device_trace/device_trace_writer.h"
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
 
 namespace xdp {
 
@@ -30,12 +33,16 @@ namespace xdp {
                                        const std::string& version,
                                        const std::string& creationTime,
                                        const std::string& xrtV,
-                                       const std::string& toolV)
+                                       const std::string& toolV,
+                                       bool binaryFormat)
     : VPTraceWriter(filename, version, creationTime, 9 /* ns */),
       xrtVersion(xrtV),
       toolVersion(toolV),
-      deviceId(devId)
+      deviceId(devId),
+      binary(binaryFormat)
   {
+    if (binary)
+      setBinaryMode();
   }
 
   DeviceTraceWriter::~DeviceTraceWriter()
@@ -317,6 +324,24 @@ namespace xdp {
   void DeviceTraceWriter::writeTraceEvents()
   {
     fout << "EVENTS\n";
+    writeTraceEvents(nullptr);
+  }
+
+  void DeviceTraceWriter::dumpEvent(VTFDeviceEvent* event, uint32_t bucket,
+                                    VTFBinaryWriter* binaryWriter)
+  {
+    if (!binaryWriter) {
+      event->dump(fout, bucket);
+      return;
+    }
+
+    VTFBinaryRecord record = {};
+    event->dumpBinary(record, bucket);
+    binaryWriter->writeEvent(record);
+  }
+
+  void DeviceTraceWriter::writeTraceEvents(VTFBinaryWriter* binaryWriter)
+  {
     auto DeviceEvents = db->getDynamicInfo().moveDeviceEvents(deviceId);
 
     std::vector<XclbinInfo*> loadedXclbins =
@@ -343,29 +368,53 @@ namespace xdp {
           continue; // Coverity - In case dynamic cast fails
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        kernelEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        uint32_t bucket = cuBucketIdMap[index] + eventType - KERNEL;
+        VTFBinaryRecord record = {};
+        if (binaryWriter)
+          kernelEvent->dumpBinary(record, bucket);
+        else
+          kernelEvent->dump(fout, bucket);
         // Also output the tool tips
         for (const auto& iter : xclbin->pl.cus) {
           ComputeUnitInstance* cu = iter.second;
-          if (cu->getAccelMon() == cuId) {
-            fout << "," << db->getDynamicInfo().addString(cu->getKernelName());
-            fout << "," << db->getDynamicInfo().addString(cu->getName());
+          if (cu->getAccelMon() != cuId)
+            continue;
+          uint64_t kernelName = db->getDynamicInfo().addString(cu->getKernelName());
+          uint64_t cuName = db->getDynamicInfo().addString(cu->getName());
+          if (!binaryWriter) {
+            fout << "," << kernelName << "," << cuName;
+          }
+          else if (record.numArgs + 2u <= VTF_BINARY_MAX_ARGS) {
+            record.args[record.numArgs++] = kernelName;
+            record.args[record.numArgs++] = cuName;
+          }
+          else if (!tooltipsTruncated) {
+            tooltipsTruncated = true;
+            std::string msg = "Device trace for device " + std::to_string(deviceId)
+              + " has more compute units per kernel event than fit in a binary trace record."
+              + " The kernel and compute unit names of " + cu->getName()
+              + " and any further compute units of such events are not written."
+              + " Use the csv device trace format to keep them.";
+            xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
           }
         }
-        fout << "\n";
+        if (binaryWriter)
+          binaryWriter->writeEvent(record);
+        else
+          fout << "\n";
       } else if(KERNEL_STALL_EXT_MEM == eventType
                 || KERNEL_STALL_DATAFLOW == eventType
                 || KERNEL_STALL_PIPE == eventType) {
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        deviceEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        dumpEvent(deviceEvent, cuBucketIdMap[index] + eventType - KERNEL, binaryWriter);
       } else {
         // Memory or Stream Acceses
         uint32_t monId = deviceEvent->getMonitorId();
         DeviceMemoryAccess* memoryEvent = dynamic_cast<DeviceMemoryAccess*>(e.get());
         if (memoryEvent) {
           std::pair<XclbinInfo*, uint32_t> index =std::make_pair(xclbin, monId);
-          deviceEvent->dump(fout, aimBucketIdMap[index] + eventType - KERNEL_READ);
+          dumpEvent(deviceEvent, aimBucketIdMap[index] + eventType - KERNEL_READ, binaryWriter);
           continue;
         }
         DeviceStreamAccess* streamEvent = dynamic_cast<DeviceStreamAccess*>(e.get());
@@ -373,9 +422,9 @@ namespace xdp {
           std::pair<XclbinInfo*, uint32_t> index = std::make_pair(xclbin, monId);
           if (KERNEL_STREAM_READ == eventType || KERNEL_STREAM_READ_STALL == eventType
                                               || KERNEL_STREAM_READ_STARVE == eventType) {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
+            dumpEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ, binaryWriter);
           } else {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
+            dumpEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE, binaryWriter);
           }
           continue;
         }
@@ -403,16 +452,21 @@ namespace xdp {
 
     initialize();
 
-    writeHeader();
-    fout << "\n";
-    writeStructure();
-    fout << "\n";
-    writeStringTable();
-    fout << "\n";
-    writeTraceEvents();
-    fout << "\n";
-    writeDependencies();
-    fout << "\n";
+    if (binary) {
+      writeBinary();
+    }
+    else {
+      writeHeader();
+      fout << "\n";
+      writeStructure();
+      fout << "\n";
+      writeStringTable();
+      fout << "\n";
+      writeTraceEvents();
+      fout << "\n";
+      writeDependencies();
+      fout << "\n";
+    }
 
     fout.flush();
 
@@ -423,6 +477,28 @@ namespace xdp {
     return true;
   }
 
+  // The binary format keeps the HEADER and STRUCTURE sections as text
+  //  and replaces the string table and events with fixed width records.
+  void DeviceTraceWriter::writeBinary()
+  {
+    VTFBinaryWriter binaryWriter(fout);
+    binaryWriter.writeFileHeader();
+
+    binaryWriter.beginText();
+    writeHeader();
+    fout << "\n";
+    writeStructure();
+    fout << "\n";
+    fout << "MAPPING\n";
+    binaryWriter.endText();
+
+    (db->getDynamicInfo()).dumpStringTable(binaryWriter);
+    binaryWriter.writeText("\nEVENTS\n");
+    writeTraceEvents(&binaryWriter);
+    binaryWriter.writeText("\nDEPENDENCIES\n\n");
+    binaryWriter.flush();
+  }
+
   void DeviceTraceWriter::initialize()
   {
     std::vector<XclbinInfo*> loadedXclbins =
@@ -25,6 +25,9 @@
 
 namespace xdp {
 
+  class VTFBinaryWriter ;
+  class VTFDeviceEvent ;
+
   class DeviceTraceWriter : public VPTraceWriter
   {
   private:
@@ -40,6 +43,12 @@ namespace xdp {
 
     uint64_t deviceId;
 
+    // Write the compact binary format instead of CSV
+    bool binary;
+    // Set once the CU tooltips of a kernel event did not fit in a
+    //  binary record, so the warning is only issued once per writer
+    bool tooltipsTruncated = false;
+
     // Helper function for making sure the database has enough information
     //  to print out all of the information it will need.
     void initialize() ;
@@ -55,6 +64,12 @@ namespace xdp {
     void writeFloatingMemoryTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount) ;
     void writeFloatingStreamTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount) ;
 
+    // Shared by the CSV and binary formats.  A null binary writer
+    //  dumps the events as CSV text.
+    void writeTraceEvents(VTFBinaryWriter* binaryWriter) ;
+    void dumpEvent(VTFDeviceEvent* event, uint32_t bucket, VTFBinaryWriter* binaryWriter) ;
+    void writeBinary() ;
+
   protected:
     virtual void writeHeader() ;
     virtual void writeStructure() ;
@@ -66,7 +81,8 @@ namespace xdp {
     DeviceTraceWriter(const char* filename, uint64_t deviceId, const std::string& version,
 		      const std::string& creationTime,
 		      const std::string& xrtV,
-		      const std::string& toolV);
+		      const std::string& toolV,
+		      bool binaryFormat = false);
     
     ~DeviceTraceWriter() ;
 
@@ -59,6 +59,9 @@ namespace xdp {
     addParameter("trace_file_dump_interval_s",
                  xrt_core::config::get_trace_file_dump_interval_s(),
                  "Interval for dumping files to host (in s)");              
+    addParameter("device_trace_file_format",
+                 xrt_core::config::get_device_trace_file_format(),
+                 "Format of device trace files (csv|binary)");
     addParameter("lop_trace", xrt_core::config::get_lop_trace(),
                  "Generation of lower overhead OpenCL trace. Should not be used with other OpenCL options.");
     addParameter("debug_mode", xrt_core::config::get_launch_waveform(),
@@ -20,6 +20,7 @@
 #include "core/common/config_reader.h"
 #include "core/common/sysinfo.h"
 
+#include "xdp/profile/database/latency_sketch.h"
 #include "xdp/profile/database/static_info/device_info.h"
 #include "xdp/profile/database/static_info/pl_constructs.h"
 #include "xdp/profile/database/static_info/xclbin_info.h"
@@ -185,17 +186,11 @@ namespace xdp {
   void
   SummaryWriter::writeAPICalls(APIType type)
   {
-    // For each function call, across all of the threads,
-    //  consolidate all the information into what we need
-    std::map<std::string,
-             std::tuple<uint64_t,
-                        double,
-                        double,
-                        double> > rows ;
-
-    std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount =
-      (db->getStats()).getCallCount() ;
+    // For each function call, merge the statistics of all of the
+    //  threads into a single sketch
+    std::map<std::string, LatencySketch> rows ;
+
+    const auto& callCount = (db->getStats()).getCallCount() ;
 
     for (const auto& call : callCount) {
       auto callAndThread = call.first ;
@@ -216,40 +211,43 @@ namespace xdp {
         break ;
       }
 
-      std::vector<std::pair<double, double>> timesOfCalls = call.second ;
-
-      if (rows.find(APIName) == rows.end()) {
-        std::tuple<uint64_t, double, double, double> blank =
-          std::make_tuple<uint64_t, double, double, double>(0,0,std::numeric_limits<double>::max(),0) ;
-
-        rows[APIName] = blank ;
-      }
-
-      for (const auto& executionTime : timesOfCalls) {
-        auto timeTaken = executionTime.second - executionTime.first ;
-
-        ++(std::get<0>(rows[APIName])) ;
-        std::get<1>(rows[APIName]) += timeTaken ;
-        if (timeTaken < std::get<2>(rows[APIName]))
-          std::get<2>(rows[APIName]) = timeTaken ;
-        if (timeTaken > std::get<3>(rows[APIName]))
-          std::get<3>(rows[APIName]) = timeTaken ;
-      }
+      rows[APIName].merge(call.second.durations) ;
     }
 
     for (const auto& row : rows) {
+      const LatencySketch& sketch = row.second ;
+      if (sketch.getCount() == 0)
+        continue ;
+
       auto averageTime =
-        static_cast<double>(std::get<1>(row.second)) / static_cast<double>(std::get<0>(row.second)) ;
+        sketch.getSum() / static_cast<double>(sketch.getCount()) ;
       if (type != OPENCL) fout << "ENTRY:" ;
-      fout << row.first                      << ","     // API Name
-           << std::get<0>(row.second)        << ","     // Number of calls
-           << (std::get<1>(row.second)/one_million) << ","     // Total time
-           << (std::get<2>(row.second)/one_million) << ","     // Minimum time
-           << (averageTime/one_million)             << ","     // Average time
-           << (std::get<3>(row.second)/one_million) << ",\n" ; // Maximum time
+      fout << row.first                          << ","     // API Name
+           << sketch.getCount()                  << ","     // Number of calls
+           << (sketch.getSum()/one_million)      << ","     // Total time
+           << (sketch.getMin()/one_million)      << ","     // Minimum time
+           << (averageTime/one_million)          << ","     // Average time
+           << (sketch.getMax()/one_million)      << "," ;   // Maximum time
+      // The OpenCL table has a fixed format
+      if (type != OPENCL) {
+        fout << (sketch.quantile(0.5)/one_million)   << ","   // Median time
+             << (sketch.quantile(0.99)/one_million)  << ","   // P99 time
+             << (sketch.quantile(0.999)/one_million) << "," ; // P99.9 time
+      }
+      fout << "\n" ;
     }
   }
 
+  void SummaryWriter::writePercentileColumns()
+  {
+    fout << "COLUMN:<html>Median<br>Time (ms)</html>,float,"
+         << "Estimated median execution time (in ms),\n";
+    fout << "COLUMN:<html>P99<br>Time (ms)</html>,float,"
+         << "Estimated 99th percentile execution time (in ms),\n";
+    fout << "COLUMN:<html>P99.9<br>Time (ms)</html>,float,"
+         << "Estimated 99.9th percentile execution time (in ms),\n";
+  }
+
   void SummaryWriter::writeOpenCLAPICalls()
   {
     // Title
@@ -275,6 +273,7 @@ namespace xdp {
          << "Average execution time (in ms),\n";
     fout << "COLUMN:<html>Maximum<br>Time (ms)</html>,float,"
          << "Maximum execution time (in ms),\n";
+    writePercentileColumns() ;
     writeAPICalls(NATIVE) ;
   }
 
@@ -293,6 +292,7 @@ namespace xdp {
          << "Average execution time (in ms),\n";
     fout << "COLUMN:<html>Maximum<br>Time (ms)</html>,float,"
          << "Maximum execution time (in ms),\n";
+    writePercentileColumns() ;
     writeAPICalls(HAL) ;
   }
 
@@ -1808,6 +1808,42 @@ namespace xdp {
     }
   }
 
+  void SummaryWriter::writeTraceOffload()
+  {
+    auto& offloads = db->getStats().getTraceOffloadStats() ;
+    if (offloads.size() == 0)
+      return ;
+
+    fout << "TITLE:Device Trace Offload\n" ;
+    fout << "SECTION:Device Trace,Trace Offload\n" ;
+    fout << "COLUMN:<html>Device</html>,string,Name of device,\n" ;
+    fout << "COLUMN:<html>Trace<br>Offloaded (MB)</html>,float,"
+         << "Amount of trace read from the device (in MB),\n" ;
+    fout << "COLUMN:<html>Offload<br>Rate (MB/s)</html>,float,"
+         << "Rate at which trace was read from the device (in MB/s),\n" ;
+    fout << "COLUMN:<html>Number<br>Of Chunks</html>,int,"
+         << "Number of trace chunks read from the device,\n" ;
+    fout << "COLUMN:<html>Maximum Decode<br>Lag (MB)</html>,float,"
+         << "Largest amount of trace waiting to be decoded (in MB),\n" ;
+    fout << "COLUMN:<html>Buffer<br>Drops</html>,int,"
+         << "Number of times the device trace buffer filled or was overwritten before being read,\n" ;
+
+    for (auto& iter : offloads) {
+      const TraceOffloadStatistics& stats = iter.second ;
+      double offloadedMB = static_cast<double>(stats.bytesOffloaded) / one_million ;
+      double rate = (stats.offloadTimeMs > 0)
+        ? offloadedMB / (stats.offloadTimeMs / one_thousand) : 0.0 ;
+
+      fout << "ENTRY:"
+           << (db->getStaticInfo()).getDeviceName(iter.first) << ","
+           << offloadedMB << ","
+           << rate << ","
+           << stats.chunks << ","
+           << static_cast<double>(stats.maxDecodeLagBytes) / one_million << ","
+           << stats.drops << ",\n" ;
+    }
+  }
+
   void SummaryWriter::writeUserLevelEvents()
   {
     if (!db->getStats().eventInformationPresent()) return ;
@@ -1887,6 +1923,7 @@ namespace xdp {
       writeTopDataTransferKernelAndGlobal() ;            fout << "\n" ;
       writeDataTransferGlobalMemoryToGlobalMemory() ;    fout << "\n" ;
       writeComputeUnitStallInformation() ;               fout << "\n" ;
+      writeTraceOffload() ;                              fout << "\n" ;
     }
 
     if (db->infoAvailable(info::user)) {
@@ -55,6 +55,7 @@ namespace xdp {
     // Generic host tables
     enum APIType { OPENCL, NATIVE, HAL, ALL } ;
     void writeAPICalls(APIType type) ;
+    void writePercentileColumns() ;
 
     // OpenCL specific device tables
     void writeSoftwareEmulationComputeUnitUtilization() ;
@@ -70,6 +71,7 @@ namespace xdp {
     void writeTopDataTransferKernelAndGlobal() ;
     void writeDataTransferGlobalMemoryToGlobalMemory() ;
     void writeComputeUnitUtilization() ;
+    void writeTraceOffload() ;
 
     // Helper function for the kernel data transfer table
     void writeSingleDataTransfer(const std::string& deviceName,
@@ -132,7 +132,7 @@ namespace xdp {
       warnFileNum = true;
     }
 
-    fout.open(currentFileName.c_str()) ;
+    fout.open(currentFileName.c_str(), openMode) ;
   }
 
   // If we are overwriting a file that was previously written (but not
@@ -142,7 +142,13 @@ namespace xdp {
     fout.close() ;
     fout.clear() ;
 
-    fout.open(currentFileName.c_str()) ;
+    fout.open(currentFileName.c_str(), openMode) ;
+  }
+
+  void VPWriter::setBinaryMode()
+  {
+    openMode = std::ios_base::out | std::ios_base::binary ;
+    refreshFile() ;
   }
 
   std::string VPWriter::getcurrentFileName()
@@ -50,6 +50,9 @@ namespace xdp {
     uint32_t fileNum ;
     static bool warnFileNum;
 
+    // Mode used whenever a file is (re)opened
+    std::ios_base::openmode openMode = std::ios_base::out ;
+
   protected:
     // Connection to the database where all the information is stored
     VPDatabase* db ;
@@ -62,6 +65,8 @@ namespace xdp {
     inline const char* getRawBasename() { return basename.c_str() ; } 
     XDP_CORE_EXPORT virtual void switchFiles() ;
     XDP_CORE_EXPORT virtual void refreshFile() ;
+    // Reopen the current and all subsequent files in binary mode
+    XDP_CORE_EXPORT void setBinaryMode() ;
   public:
     XDP_CORE_EXPORT VPWriter(const char* filename) ;
     XDP_CORE_EXPORT VPWriter(const char* filename, VPDatabase* inst, bool useDir = true) ;
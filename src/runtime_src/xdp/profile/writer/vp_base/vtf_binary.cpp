@@ -0,0 +1,213 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <cstring>
+#include <iomanip>
+
+#include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/writer/vp_base/vtf_binary.h"
+
+namespace xdp {
+
+  VTFBinaryWriter::VTFBinaryWriter(std::ofstream& f, size_t bufferSize)
+    : fout(f), capacity(bufferSize)
+  {
+    buffer.reserve(capacity) ;
+  }
+
+  VTFBinaryWriter::~VTFBinaryWriter()
+  {
+    flush() ;
+  }
+
+  void VTFBinaryWriter::writeFileHeader()
+  {
+    flush() ;
+
+    VTFBinaryFileHeader header = {} ;
+    std::memcpy(header.magic, VTF_BINARY_MAGIC, sizeof(header.magic)) ;
+    header.version    = VTF_BINARY_VERSION ;
+    header.recordSize = sizeof(VTFBinaryRecord) ;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header)) ;
+  }
+
+  void VTFBinaryWriter::startChunk(uint32_t kind, size_t bytes)
+  {
+    if (kind != currentKind || buffer.size() + bytes > capacity)
+      flush() ;
+
+    if (buffer.empty()) {
+      buffer.resize(sizeof(VTFBinaryChunkHeader)) ;
+      currentKind = kind ;
+    }
+  }
+
+  void VTFBinaryWriter::append(const void* data, size_t bytes)
+  {
+    auto first = static_cast<const char*>(data) ;
+    buffer.insert(buffer.end(), first, first + bytes) ;
+  }
+
+  void VTFBinaryWriter::writeText(const std::string& text)
+  {
+    startChunk(VTF_CHUNK_TEXT, text.size()) ;
+    append(text.data(), text.size()) ;
+  }
+
+  void VTFBinaryWriter::beginText()
+  {
+    flush() ;
+
+    // Reserve room for the chunk header and fill it in once the
+    //  size of the text is known
+    textStart = fout.tellp() ;
+    VTFBinaryChunkHeader header = {} ;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header)) ;
+  }
+
+  void VTFBinaryWriter::endText()
+  {
+    std::streampos textEnd = fout.tellp() ;
+
+    VTFBinaryChunkHeader header = {} ;
+    header.kind = VTF_CHUNK_TEXT ;
+    header.size =
+      static_cast<uint64_t>(textEnd - textStart) - sizeof(header) ;
+
+    fout.seekp(textStart) ;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header)) ;
+    fout.seekp(textEnd) ;
+  }
+
+  void VTFBinaryWriter::writeString(uint64_t id, std::string_view value)
+  {
+    uint32_t length = static_cast<uint32_t>(value.size()) ;
+    startChunk(VTF_CHUNK_STRINGS, sizeof(id) + sizeof(length) + length) ;
+    append(&id, sizeof(id)) ;
+    append(&length, sizeof(length)) ;
+    append(value.data(), length) ;
+  }
+
+  void VTFBinaryWriter::writeEvent(const VTFBinaryRecord& record)
+  {
+    startChunk(VTF_CHUNK_EVENTS, sizeof(record)) ;
+    append(&record, sizeof(record)) ;
+  }
+
+  void VTFBinaryWriter::flush()
+  {
+    if (buffer.empty())
+      return ;
+
+    VTFBinaryChunkHeader header = {} ;
+    header.kind = currentKind ;
+    header.size = buffer.size() - sizeof(header) ;
+    std::memcpy(buffer.data(), &header, sizeof(header)) ;
+
+    fout.write(buffer.data(), static_cast<std::streamsize>(buffer.size())) ;
+    buffer.clear() ;
+    currentKind = 0 ;
+  }
+
+  static bool convertStrings(const std::vector<char>& payload, std::ostream& out)
+  {
+    size_t offset = 0 ;
+    while (offset < payload.size()) {
+      uint64_t id = 0 ;
+      uint32_t length = 0 ;
+      if (payload.size() - offset < sizeof(id) + sizeof(length))
+        return false ;
+      std::memcpy(&id, payload.data() + offset, sizeof(id)) ;
+      offset += sizeof(id) ;
+      std::memcpy(&length, payload.data() + offset, sizeof(length)) ;
+      offset += sizeof(length) ;
+      if (payload.size() - offset < length)
+        return false ;
+
+      out << id << "," ;
+      out.write(payload.data() + offset, length) ;
+      out << "\n" ;
+      offset += length ;
+    }
+    return true ;
+  }
+
+  static bool convertEvents(const std::vector<char>& payload, std::ostream& out)
+  {
+    if (payload.size() % sizeof(VTFBinaryRecord) != 0)
+      return false ;
+
+    for (size_t offset = 0 ; offset < payload.size() ; offset += sizeof(VTFBinaryRecord)) {
+      VTFBinaryRecord record ;
+      std::memcpy(&record, payload.data() + offset, sizeof(record)) ;
+      if (record.numArgs > VTF_BINARY_MAX_ARGS)
+        return false ;
+
+      out << record.id << "," << record.startId << "," ;
+      std::ios_base::fmtflags flags = out.flags() ;
+      out << std::fixed << std::setprecision(6) << record.timestamp ;
+      out.flags(flags) ;
+      out << "," << record.bucket << ","
+          << VTFEvent::getTypeName(static_cast<VTFEventType>(record.type)) ;
+      for (uint16_t i = 0 ; i < record.numArgs ; ++i)
+        out << "," << record.args[i] ;
+      out << "\n" ;
+    }
+    return true ;
+  }
+
+  bool convertVTFBinaryToCSV(std::istream& fin, std::ostream& out)
+  {
+    VTFBinaryFileHeader fileHeader ;
+    if (!fin.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)))
+      return false ;
+    if (std::memcmp(fileHeader.magic, VTF_BINARY_MAGIC, sizeof(fileHeader.magic)) != 0
+        || fileHeader.version != VTF_BINARY_VERSION
+        || fileHeader.recordSize != sizeof(VTFBinaryRecord))
+      return false ;
+
+    std::vector<char> payload ;
+    VTFBinaryChunkHeader header ;
+    while (fin.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+      payload.resize(static_cast<size_t>(header.size)) ;
+      if (!fin.read(payload.data(), static_cast<std::streamsize>(payload.size())))
+        return false ;
+
+      switch (header.kind) {
+      case VTF_CHUNK_TEXT:
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size())) ;
+        break ;
+      case VTF_CHUNK_STRINGS:
+        if (!convertStrings(payload, out))
+          return false ;
+        break ;
+      case VTF_CHUNK_EVENTS:
+        if (!convertEvents(payload, out))
+          return false ;
+        break ;
+      default:
+        return false ;
+      }
+    }
+
+    // Reading stops at the end of the file or in the middle of a
+    //  truncated chunk header
+    return fin.eof() && fin.gcount() == 0 ;
+  }
+
+} // end namespace xdp
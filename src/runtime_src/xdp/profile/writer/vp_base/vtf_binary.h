@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef VTF_BINARY_DOT_H
+#define VTF_BINARY_DOT_H
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "xdp/config.h"
+
+// The binary VTF format carries the same information as a CSV trace
+//  file in a form that is cheap to produce.  The file starts with a
+//  VTFBinaryFileHeader followed by a sequence of chunks.  Each chunk
+//  is a VTFBinaryChunkHeader followed by "size" bytes of payload:
+//
+//   TEXT    - CSV text copied verbatim into the converted file
+//             (the HEADER and STRUCTURE sections and section names)
+//   STRINGS - String table entries, each a uint64_t id, a uint32_t
+//             length, and the characters of the string
+//   EVENTS  - An array of fixed width VTFBinaryRecords
+//
+// Chunks are converted in file order, so the CSV file is reproduced
+//  by emitting the chunks one after the other.  All values are stored
+//  in host byte order.
+
+namespace xdp {
+
+  constexpr char     VTF_BINARY_MAGIC[8]  = {'X','D','P','V','T','F','B','\0'} ;
+  constexpr uint32_t VTF_BINARY_VERSION   = 1 ;
+  constexpr uint32_t VTF_BINARY_MAX_ARGS  = 2 ;
+
+  enum VTFBinaryChunkKind : uint32_t {
+    VTF_CHUNK_TEXT    = 1,
+    VTF_CHUNK_STRINGS = 2,
+    VTF_CHUNK_EVENTS  = 3
+  } ;
+
+  struct VTFBinaryFileHeader
+  {
+    char     magic[8] ;
+    uint32_t version ;
+    uint32_t recordSize ;
+  } ;
+
+  struct VTFBinaryChunkHeader
+  {
+    uint32_t kind ;
+    uint32_t reserved ;
+    uint64_t size ;
+  } ;
+
+  // One row of the EVENTS section.  The args are the optional trailing
+  //  columns of the row (memory name, kernel and CU name tooltips, etc.)
+  struct VTFBinaryRecord
+  {
+    uint64_t id ;
+    uint64_t startId ;
+    double   timestamp ; // In milliseconds, as written to the CSV file
+    uint32_t bucket ;
+    uint16_t type ;      // VTFEventType
+    uint16_t numArgs ;
+    uint64_t args[VTF_BINARY_MAX_ARGS] ;
+  } ;
+
+  static_assert(sizeof(VTFBinaryRecord) == 48,
+                "Binary trace record layout must not change within a version") ;
+
+  // Accumulates chunks in a large buffer and hands them to the output
+  //  stream in as few writes as possible.  Consecutive entries of the
+  //  same kind are merged into a single chunk.
+  class VTFBinaryWriter
+  {
+  private:
+    std::ofstream& fout ;
+    std::vector<char> buffer ;
+    uint32_t currentKind = 0 ;
+    size_t capacity ;
+    std::streampos textStart = -1 ;
+
+    void startChunk(uint32_t kind, size_t bytes) ;
+    void append(const void* data, size_t bytes) ;
+
+  public:
+    XDP_CORE_EXPORT explicit VTFBinaryWriter(std::ofstream& f,
+                                             size_t bufferSize = 4*1024*1024) ;
+    XDP_CORE_EXPORT ~VTFBinaryWriter() ;
+
+    XDP_CORE_EXPORT void writeFileHeader() ;
+    XDP_CORE_EXPORT void writeText(const std::string& text) ;
+    // Everything written directly to the output stream between
+    //  beginText() and endText() becomes a single TEXT chunk
+    XDP_CORE_EXPORT void beginText() ;
+    XDP_CORE_EXPORT void endText() ;
+    XDP_CORE_EXPORT void writeString(uint64_t id, std::string_view value) ;
+    XDP_CORE_EXPORT void writeEvent(const VTFBinaryRecord& record) ;
+
+    // Write out the pending chunk
+    XDP_CORE_EXPORT void flush() ;
+  } ;
+
+  // Convert a binary trace file to the equivalent CSV trace file.
+  //  Returns false and leaves a partially written output if the input
+  //  is not a valid binary trace.
+  XDP_CORE_EXPORT bool convertVTFBinaryToCSV(std::istream& fin, std::ostream& out) ;
+
+} // end namespace xdp
+
+#endif
@@ -237,6 +237,17 @@ xma_frame_from_device_buffers(XmaFrameProperties *frame_props,
 void
 xma_frame_free(XmaFrame *frame);
 
+/**
+ * xma_frame_pool_trim() - Free host frame planes kept for reuse
+ *
+ * Planes of frames allocated by xma_frame_alloc() are kept for reuse
+ * when the frame is freed, up to a limit per plane size and in total.
+ * This releases all kept planes, e.g. after the last stream of a
+ * resolution is done.  Planes of frames still in use are not affected.
+*/
+void
+xma_frame_pool_trim(void);
+
 /**
  * xma_side_data_alloc() - Allocates side data handle, with
  * reference count equal to 1. The side data buffer 'side_data'
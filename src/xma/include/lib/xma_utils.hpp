@@ -35,8 +35,15 @@ namespace xma_core { namespace utils {
 int32_t load_libxrt();
 int32_t get_cu_index(int32_t dev_index, char* cu_name);
 int32_t get_default_ddr_index(int32_t dev_index, int32_t cu_index);
-int32_t check_all_execbo(XmaSession s_handle);
+void execbo_completed(XmaHwSessionPrivate *priv1, int32_t execbo_idx, ert_cmd_state cu_state);
+float get_cmd_latency_avg(const XmaHwSessionPrivate *priv1);
 int32_t xma_check_device_buffer(const XmaBufferObj* b_obj);
+std::shared_ptr<XmaBufferPool> get_buffer_pool(XmaHwSessionPrivate* priv, uint64_t size, int32_t bank_index,
+                                               int32_t dev_index, bool device_only_buffer);
+bool get_pool_buffer(XmaBufferPool* pool, XmaBufferObj& b_obj);
+bool put_pool_buffer(const XmaBufferObj& b_obj);
+void release_buffer_pools(XmaHwSessionPrivate* priv);
+void release_session(XmaSession* session);
 void logmsg(XmaLogLevelType level, const std::string& tag, const std::string& msg);
 
 } // namespace utils
@@ -59,9 +59,7 @@ typedef struct XmaSingleton
 
     std::atomic<bool> xma_exit;
     std::thread       xma_thread1;
-    std::vector<std::thread> all_thread2;
     std::future<bool> thread1_future;
-    std::vector<std::future<bool>> all_thread2_futures;
 
     uint32_t          reserved[4];
 
@@ -90,12 +88,6 @@ typedef struct XmaSingleton
       if (thread1_future.valid())
         thread1_future.wait_for(std::chrono::milliseconds(400));
     } catch (...) {}
-    try {
-      for (const auto& thread2_f: all_thread2_futures) {
-        if (thread2_f.valid())
-          thread2_f.wait_for(std::chrono::milliseconds(400));
-      }
-    } catch (...) {}
   }
 } XmaSingleton;
 
@@ -38,6 +38,7 @@
 #include <random>
 #include <chrono>
 #include <list>
+#include <mutex>
 #include <condition_variable>
 
 #define MAX_EXECBO_BUFF_SIZE      4096// 4KB
@@ -102,13 +103,18 @@ typedef struct XmaHwExecBO
     bool        in_use = false;
     uint32_t    cu_cmd_id1 = 0;//Counter
     int32_t     cu_cmd_id2 = 0;//Random num
+    std::chrono::steady_clock::time_point start_time;//When cmd was submitted; For latency stats
 } XmaHwExecBO;
 
+// Device buffers of one session with the same size, bank and type.
+// Freed buffers are kept for reuse; a buffer freed while its ref_cnt
+// (see xma_add_ref_cnt) is positive is parked in buffers_busy and
+// becomes free once the count drops to zero.
 typedef struct XmaBufferPool
 {
+    std::mutex m_mutex;
     std::list<XmaBufferObj>   buffers_busy;
     std::vector<XmaBufferObj>  buffers_free;
-    std::atomic<bool> pool_locked;
     uint64_t buffer_size;
     int32_t  bank_index;
     int32_t  dev_index;
@@ -118,7 +124,6 @@ typedef struct XmaBufferPool
     uint32_t reserved[4];
 
   XmaBufferPool() {
-   pool_locked = false;
    num_buffers = 0;
    num_free_buffers = 0;
    buffer_size = 0;
@@ -126,6 +131,7 @@ typedef struct XmaBufferPool
    dev_index = -1;
    device_only_buffer = false;
   }
+  ~XmaBufferPool();
 } XmaBufferPool;
 
 typedef struct XmaBufferPoolObjPrivate
@@ -157,7 +163,7 @@ typedef struct XmaHwSessionPrivate
     std::atomic<uint32_t>  kernel_complete_count{ 0 };
     std::atomic<uint32_t>  kernel_complete_total{ 0 };
     XmaHwDevice     *device = nullptr;
-    std::unordered_map<uint32_t, XmaCUCmdObjPrivate> CU_cmds;//Use execbo lock when accessing this map
+    std::unordered_map<uint32_t, XmaCUCmdObjPrivate> CU_cmds;//Use m_mutex when accessing this map
     std::atomic<uint32_t> num_cu_cmds{ 0 };
     std::atomic<uint32_t> num_cu_cmds_avg{ 0 };
     std::atomic<uint32_t> num_cu_cmds_avg_tmp{ 0 };
@@ -169,18 +175,23 @@ typedef struct XmaHwSessionPrivate
     std::atomic<uint32_t> cmd_busy_ticks_tmp{ 0 };
     std::atomic<uint32_t> cmd_idle_ticks_tmp{ 0 };
     std::atomic<bool> slowest_element{ false };
+    std::atomic<uint32_t> max_cu_cmds{ 0 };//Max queue depth
+    std::atomic<uint32_t> cmd_latency_max{ 0 };//In usec
+    std::atomic<uint64_t> cmd_latency_total{ 0 };//In usec
+    std::atomic<uint32_t> cmd_latency_count{ 0 };
+    //Protects execbos and CU cmd maps. Completion callback of execbo
+    //retires the cmd and notifies below condition variables under this lock
     std::mutex m_mutex;
     std::condition_variable work_item_done_1plus;//Use with xma_plg_work_item_done
     std::condition_variable execbo_is_free; //Use with xma_plg_schedule_work_item and xma_plg_schedule_cu_cmd
     std::condition_variable kernel_done_or_free;//Use with xma_plg_cu_cmd_status; CU completion is must every outstanding cmd;
     std::vector<uint32_t> execbo_lru;
-    std::vector<uint32_t> execbo_to_check;
     bool     using_work_item_done = false;
     std::atomic<bool> using_cu_cmd_status{ false };
-    std::atomic<bool> execbo_locked{ false };
     std::vector<XmaHwExecBO> kernel_execbos;
     int32_t    num_execbo_allocated = -1;
-    std::list<XmaBufferPool>   buffer_pools;
+    std::mutex buffer_pools_mutex;
+    std::list<std::shared_ptr<XmaBufferPool>> buffer_pools;
     uint32_t reserved[4];
 } XmaHwSessionPrivate;
 
@@ -189,6 +200,7 @@ typedef struct XmaBufferObjPrivate
     void*    dummy = nullptr;
     xrt::bo  xrt_bo;
     std::atomic<int32_t> ref_cnt{0};
+    std::weak_ptr<XmaBufferPool> pool;//Session pool the buffer is returned to when freed
     uint32_t reserved[4];
 } XmaBufferObjPrivate;
 
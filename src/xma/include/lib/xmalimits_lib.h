@@ -46,6 +46,10 @@
 #define XMA_CPU_MODE3           3  //Same as legacy
 #define XMA_CPU_MODE4           4  //Low cpu load
 
+#define XMA_MAX_POOL_FREE_BUFFERS    32//Free device buffers kept per session buffer pool
+#define XMA_MAX_POOL_FREE_PLANES     64//Free host frame planes kept per plane size
+#define XMA_MAX_POOL_FREE_PLANE_BYTES (256UL << 20)//Free host frame plane bytes kept in total
+
 #define INVALID_M1             -1
 #define STATS_WINDOW            4096.0f
 #define STATS_WINDOW_1          4095
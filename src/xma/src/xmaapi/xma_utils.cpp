@@ -17,6 +17,7 @@
 #include "core/common/api/bo.h"
 #include "core/common/device.h"
 #include <dlfcn.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <sstream>
@@ -116,6 +117,11 @@ namespace xma_core {
                 std::string updated_cu_name = kernel_name + ":{" + inst_name + "}";
                 dev_execbo.xrt_kernel = xrt::kernel(priv->dev_handle, priv->dev_handle.get_xclbin_uuid(), updated_cu_name);
                 dev_execbo.xrt_run = xrt::run(dev_execbo.xrt_kernel);
+                //Cmds are retired as they complete instead of polling execbo state
+                dev_execbo.xrt_run.add_callback(ERT_CMD_STATE_COMPLETED,
+                    [priv, d](const void*, ert_cmd_state state, void*) {
+                        xma_core::utils::execbo_completed(priv, d, state);
+                    }, nullptr);
             }
             return XMA_SUCCESS;
         }
@@ -414,6 +420,15 @@ void get_system_info() {
     g_xma_singleton->log_msg_list_locked = false;
 }
 
+// get_cmd_latency_avg() - Returns average latency in usec of CU cmds of a session.
+float get_cmd_latency_avg(const XmaHwSessionPrivate *priv1) {
+    uint32_t count = priv1->cmd_latency_count;
+    if (count == 0) {
+        return 0;
+    }
+    return priv1->cmd_latency_total / (float)count;
+}
+
 // get_session_cmd_load() - Used for logging of XMA session info.
 void get_session_cmd_load() {
     static auto verbosity = xrt_core::config::get_verbosity();
@@ -434,6 +449,8 @@ void get_session_cmd_load() {
             xma_core::get_session_name(itr1.session_type).c_str(), avg_cmds, (uint32_t)priv1->cmd_busy, (uint32_t)priv1->cmd_idle);
 
         xma_logmsg(level, "XMA-Session-Stats", "Session id: %d, max busy vs idle ticks: %d vs %d, relative cu load: %d", itr1.session_id, (uint32_t)priv1->cmd_busy_ticks, (uint32_t)priv1->cmd_idle_ticks, (uint32_t)priv1->kernel_complete_total);
+        xma_logmsg(level, "XMA-Session-Stats", "Session id: %d, max queue depth: %d, cu cmd latency avg vs max: %.1f vs %d usec", itr1.session_id,
+            (uint32_t)priv1->max_cu_cmds, get_cmd_latency_avg(priv1), (uint32_t)priv1->cmd_latency_max);
         XmaHwKernel* kernel_info = priv1->kernel_info;
         if (kernel_info == NULL) {
             continue;
@@ -538,175 +555,59 @@ int32_t get_default_ddr_index(int32_t dev_index, int32_t cu_index) {
     }
 }
 
-// check_all_execbo() -  Checks status of xrt::run objects.
-int32_t check_all_execbo(XmaSession s_handle) {
-    //NOTE: execbo lock must be already obtained
-    //Check only for commands in-progress in this sessions else too much checking will waste CPU cycles
-
-    XmaHwSessionPrivate *priv1 = (XmaHwSessionPrivate*) s_handle.hw_session.private_do_not_use;
-
-    if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-        bool notify_execbo_is_free = false;
-        if (priv1->num_cu_cmds != 0) {
-            int32_t i;
-            int32_t num_execbo = priv1->num_execbo_allocated;
-            for (i = 0; i < num_execbo; i++) {
-                auto& ebo = priv1->kernel_execbos[i];
-                if (ebo.in_use) {
-                    // only for PS Kernels, will be removed after PS kernel migration to xrt::kernel  
-                    auto cu_cmd_pkt = 
-                        reinterpret_cast<ert_start_kernel_cmd*>(ebo.xrt_run.get_ert_packet());
-                    if (!cu_cmd_pkt) {
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "check_all_execbo : Invalid ert_start_kernel_cmd\n");
-                        return XMA_ERROR;
-                    }
-                    auto cu_state = ebo.xrt_run.state();
-                    if (cu_state == ERT_CMD_STATE_COMPLETED) {
-                        if (s_handle.session_type < XMA_ADMIN) {
-                            priv1->kernel_complete_count++;
-                            priv1->kernel_complete_total++;
-                        }
-                        notify_execbo_is_free = true;
-                        ebo.in_use = false;
-                        //cu_cmd->state = ERT_CMD_STATE_MAX;
-                        priv1->CU_cmds.erase(ebo.cu_cmd_id1);
-                        priv1->num_cu_cmds--;
-                    } else if (cu_state == ERT_CMD_STATE_SKERROR) {
-                        uint32_t return_code;
-                        //If PS Kernel error, add cmd obj to CU_error_cmds map; Right now this is only for PS Kernels
-                        ert_read_return_code(cu_cmd_pkt, return_code);
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "Session id: %d, type: %s, PS Kernel error code: %d", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), return_code);
-                        if (s_handle.session_type < XMA_ADMIN) {
-                            priv1->kernel_complete_count++;
-                            priv1->kernel_complete_total++;
-                        }
-                        notify_execbo_is_free = true;
-                        ebo.in_use = false;
-                        //cu_cmd->state = ERT_CMD_STATE_MAX;
-                        auto itr_tmp1 = priv1->CU_error_cmds.emplace(ebo.cu_cmd_id1, std::move(priv1->CU_cmds[ebo.cu_cmd_id1]));
-                        priv1->CU_cmds.erase(ebo.cu_cmd_id1);
-                        itr_tmp1.first->second.cmd_finished = true;
-                        itr_tmp1.first->second.return_code = return_code;
-                        itr_tmp1.first->second.cmd_state = xma_cmd_state::psk_error;
-                        priv1->num_cu_cmds--;
-                    } else if (cu_state == ERT_CMD_STATE_ERROR ||
-                        cu_state == ERT_CMD_STATE_ABORT ||
-                        cu_state == ERT_CMD_STATE_TIMEOUT ||
-                        cu_state >= ERT_CMD_STATE_NORESPONSE) {
-                        //Check for invalid/error execo state
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "Session id: %d, type: %s, Unexpected ERT_CMD_STATE. state=%s", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), xma_core::get_cu_cmd_state(cu_state).c_str());
-                        std::string err_tmp("XMA FATAL: Session id: ");
-                        err_tmp.append(std::to_string(s_handle.session_id));
-                        err_tmp.append(", type: ");
-                        err_tmp.append(xma_core::get_session_name(s_handle.session_type));
-                        err_tmp.append("; Unexpected ERT_CMD_STATE. state=");
-                        err_tmp.append(xma_core::get_cu_cmd_state(cu_state));
-                        throw std::runtime_error(err_tmp);
-                    }
-                }
-            }
+// execbo_completed() - Completion callback of session execbo. Retires the CU cmd,
+// records cmds that completed with error and wakes up threads waiting for
+// cmd completion or a free execbo.
+void execbo_completed(XmaHwSessionPrivate *priv1, int32_t execbo_idx, ert_cmd_state cu_state) {
+    auto& ebo = priv1->kernel_execbos[execbo_idx];
+    const char* cu_name = priv1->kernel_info ? reinterpret_cast<char*>(priv1->kernel_info->name) : "admin";
+
+    std::unique_lock<std::mutex> lk(priv1->m_mutex);
+    if (!ebo.in_use) {
+        return;
+    }
+    auto latency = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - ebo.start_time).count());
+    if (cu_state != ERT_CMD_STATE_COMPLETED) {
+        //Add cmd obj to CU_error_cmds map for xma_plg_work_item_return_code
+        uint32_t return_code = 0;
+        xma_cmd_state cmd_state = xma_cmd_state::error;
+        if (cu_state == ERT_CMD_STATE_SKERROR) {
+            ert_read_return_code(reinterpret_cast<ert_start_kernel_cmd*>(ebo.xrt_run.get_ert_packet()), return_code);
+            cmd_state = xma_cmd_state::psk_error;
+            xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "CU: %s, PS Kernel error code: %d", cu_name, return_code);
         } else {
-            notify_execbo_is_free = true;
-        }
-        //In this mode schedule_work_item still waits for this
-        if (notify_execbo_is_free) {
-            priv1->execbo_is_free.notify_all();
+            if (cu_state == ERT_CMD_STATE_SKCRASHED)
+                cmd_state = xma_cmd_state::psk_crashed;
+            else if (cu_state == ERT_CMD_STATE_ABORT)
+                cmd_state = xma_cmd_state::abort;
+            else if (cu_state == ERT_CMD_STATE_TIMEOUT)
+                cmd_state = xma_cmd_state::timeout;
+            xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "CU: %s, Unexpected ERT_CMD_STATE. state=%s", cu_name, xma_core::get_cu_cmd_state(cu_state).c_str());
         }
-    } else {
-        if (priv1->num_cu_cmds != 0) {
-            bool notify_work_item_done_1plus = false;
-            bool notify_execbo_is_free = false;
-
-            for (auto ebo_it = priv1->execbo_to_check.begin(); ebo_it != priv1->execbo_to_check.end(); /*incr inside*/) {
-                int32_t val = *ebo_it;
-                auto& ebo = priv1->kernel_execbos[val];
-                if (ebo.in_use) {
-                    // only for PS Kernels, will be removed after PS kernel migration to xrt::kernel
-                    auto cu_cmd_pkt = 
-                        reinterpret_cast<ert_start_kernel_cmd*>(ebo.xrt_run.get_ert_packet());
-                    if (!cu_cmd_pkt) {
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "check_all_execbo : Invalid ert_start_kernel_cmd\n");
-                        return XMA_ERROR;
-                    }
-                    auto cu_state = ebo.xrt_run.state();                    
-                    if (cu_state == ERT_CMD_STATE_COMPLETED) {
-                        if (s_handle.session_type < XMA_ADMIN) {
-                            priv1->kernel_complete_count++;
-                            priv1->kernel_complete_total++;
-                        }
-                        ebo.in_use = false;
-                        //cu_cmd->state = ERT_CMD_STATE_MAX;
-                        notify_work_item_done_1plus = true;
-                        notify_execbo_is_free = true;
-                        priv1->CU_cmds.erase(ebo.cu_cmd_id1);
-                        priv1->num_cu_cmds--;
-                        //priv1->execbo_lru.emplace_back(val);Let's not reuse execbo immediately after completion
-                        ebo_it = priv1->execbo_to_check.erase(ebo_it);
-                    } else if (cu_state == ERT_CMD_STATE_SKERROR) {
-                        uint32_t return_code;
-                        //If PS Kernel error, add cmd obj to CU_error_cmds map; Right now this is only for PS Kernels
-                        ert_read_return_code(cu_cmd_pkt, return_code);
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "Session id: %d, type: %s, PS Kernel error code: %d", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), return_code);
-                        if (s_handle.session_type < XMA_ADMIN) {
-                            priv1->kernel_complete_count++;
-                            priv1->kernel_complete_total++;
-                        }
-                        notify_execbo_is_free = true;
-                        notify_work_item_done_1plus = true;
-                        ebo.in_use = false;
-                        //cu_cmd->state = ERT_CMD_STATE_MAX;
-                        auto itr_tmp1 = priv1->CU_error_cmds.emplace(ebo.cu_cmd_id1, std::move(priv1->CU_cmds[ebo.cu_cmd_id1]));
-                        priv1->CU_cmds.erase(ebo.cu_cmd_id1);
-                        itr_tmp1.first->second.cmd_finished = true;
-                        itr_tmp1.first->second.return_code = return_code;
-                        itr_tmp1.first->second.cmd_state = xma_cmd_state::psk_error;
-                        priv1->num_cu_cmds--;
-                        ebo_it = priv1->execbo_to_check.erase(ebo_it);
-                    } else if (cu_state == ERT_CMD_STATE_ERROR || 
-                        cu_state == ERT_CMD_STATE_ABORT ||
-                        cu_state == ERT_CMD_STATE_TIMEOUT ||
-                        cu_state >= ERT_CMD_STATE_NORESPONSE) {
-                        //Check for invalid/error execo state
-                        xma_logmsg(XMA_ERROR_LOG, XMAUTILS_MOD, "Session id: %d, type: %s, Unexpected ERT_CMD_STATE. state=%s", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), xma_core::get_cu_cmd_state(cu_state).c_str());
-                        std::string err_tmp("XMA FATAL: Session id: ");
-                        err_tmp.append(std::to_string(s_handle.session_id));
-                        err_tmp.append(", type: ");
-                        err_tmp.append(xma_core::get_session_name(s_handle.session_type));
-                        err_tmp.append("; Unexpected ERT_CMD_STATE. state=");
-                        err_tmp.append(xma_core::get_cu_cmd_state(cu_state));
-                        throw std::runtime_error(err_tmp);
-                    } else {
-                        ebo_it++;
-                    }
-                } else {
-                    notify_execbo_is_free = true;
-                    ebo_it++;
-                }
-            }
-
-            if (notify_execbo_is_free) {
-                priv1->execbo_is_free.notify_all();
-            }
-            if (notify_work_item_done_1plus) {
-                priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
-                priv1->kernel_done_or_free.notify_all();
-                if (priv1->slowest_element) {
-                    std::this_thread::yield();
-                }
-            } else if (priv1->kernel_complete_count != 0) {
-                priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
-                if (priv1->slowest_element) {
-                    std::this_thread::yield();
-                }
-            }
-        } else {
-            priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
-            priv1->kernel_done_or_free.notify_all();
-            priv1->execbo_is_free.notify_all();
-        }
-    }
-
-    return XMA_SUCCESS;
+        auto itr_tmp1 = priv1->CU_error_cmds.emplace(ebo.cu_cmd_id1, std::move(priv1->CU_cmds[ebo.cu_cmd_id1]));
+        itr_tmp1.first->second.cmd_finished = true;
+        itr_tmp1.first->second.return_code = return_code;
+        itr_tmp1.first->second.cmd_state = cmd_state;
+    }
+    priv1->CU_cmds.erase(ebo.cu_cmd_id1);
+    ebo.in_use = false;
+    priv1->num_cu_cmds--;
+    //ADMIN session has no kernel_info and does not use work item done
+    if (priv1->kernel_info) {
+        priv1->kernel_complete_count++;
+        priv1->kernel_complete_total++;
+    }
+    priv1->cmd_latency_total += latency;
+    priv1->cmd_latency_count++;
+    if (latency > priv1->cmd_latency_max) {
+        priv1->cmd_latency_max = latency;
+    }
+    lk.unlock();
+
+    priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
+    priv1->kernel_done_or_free.notify_all();
+    priv1->execbo_is_free.notify_all();
 }
 
 // xma_check_device_buffer() - Checks the given XmaBufferObj is valid or not.
@@ -732,6 +633,104 @@ int32_t xma_check_device_buffer(const XmaBufferObj* b_obj) {
     return XMA_SUCCESS;
 }
 
+// get_buffer_pool() - Returns the session pool of device buffers with the given
+// properties, creating it if this is the first buffer of its kind.
+std::shared_ptr<XmaBufferPool> get_buffer_pool(XmaHwSessionPrivate* priv, uint64_t size, int32_t bank_index,
+                                               int32_t dev_index, bool device_only_buffer) {
+    std::lock_guard<std::mutex> lock(priv->buffer_pools_mutex);
+    auto itr = std::find_if(priv->buffer_pools.begin(), priv->buffer_pools.end(),
+        [=](const std::shared_ptr<XmaBufferPool>& pool) {
+            return pool->buffer_size == size && pool->bank_index == bank_index &&
+                pool->device_only_buffer == device_only_buffer;
+        });
+    if (itr != priv->buffer_pools.end())
+        return *itr;
+
+    auto pool = std::make_shared<XmaBufferPool>();
+    pool->buffer_size = size;
+    pool->bank_index = bank_index;
+    pool->dev_index = dev_index;
+    pool->device_only_buffer = device_only_buffer;
+    priv->buffer_pools.push_back(pool);
+    return pool;
+}
+
+// get_pool_buffer() - Takes a free buffer from the pool. Buffers parked while still
+// referenced are reclaimed first if their ref_cnt has dropped to zero.
+// Returns false if the pool has no free buffer.
+bool get_pool_buffer(XmaBufferPool* pool, XmaBufferObj& b_obj) {
+    std::lock_guard<std::mutex> lock(pool->m_mutex);
+    for (auto itr = pool->buffers_busy.begin(); itr != pool->buffers_busy.end();) {
+        auto b_obj_priv = reinterpret_cast<XmaBufferObjPrivate*>(itr->private_do_not_touch);
+        if (b_obj_priv->ref_cnt > 0) {
+            ++itr;
+            continue;
+        }
+        pool->buffers_free.push_back(*itr);
+        pool->num_free_buffers++;
+        itr = pool->buffers_busy.erase(itr);
+    }
+    if (pool->buffers_free.empty())
+        return false;
+
+    b_obj = pool->buffers_free.back();
+    pool->buffers_free.pop_back();
+    pool->num_free_buffers--;
+    return true;
+}
+
+// put_pool_buffer() - Returns a freed buffer to the pool it was allocated from.
+// Returns false if the buffer is not pooled (no pool, session destroyed or pool
+// full), in which case the caller releases it.
+bool put_pool_buffer(const XmaBufferObj& b_obj) {
+    auto b_obj_priv = reinterpret_cast<XmaBufferObjPrivate*>(b_obj.private_do_not_touch);
+    auto pool = b_obj_priv->pool.lock();
+    if (!pool)
+        return false;
+
+    std::lock_guard<std::mutex> lock(pool->m_mutex);
+    if (b_obj_priv->ref_cnt > 0) {
+        pool->buffers_busy.push_back(b_obj);
+        return true;
+    }
+    if (pool->buffers_free.size() >= XMA_MAX_POOL_FREE_BUFFERS) {
+        pool->num_buffers--;
+        return false;
+    }
+    XmaBufferObj& b_obj_free = pool->buffers_free.emplace_back(b_obj);
+    b_obj_free.user_ptr = nullptr;
+    pool->num_free_buffers++;
+    return true;
+}
+
+// release_buffer_pools() - Frees all pooled buffers of the session. Buffers still
+// held by the application are released normally when freed.
+void release_buffer_pools(XmaHwSessionPrivate* priv) {
+    std::lock_guard<std::mutex> lock(priv->buffer_pools_mutex);
+    priv->buffer_pools.clear();
+}
+
+// release_session() - Releases what all session types own once the plugin is
+// closed. The caller clears its plugin pointer and frees the session.
+void release_session(XmaSession* session) {
+    // Clean up the private data
+    free(session->plugin_data);
+
+    // Device buffers kept for reuse are not needed after plugin close
+    release_buffer_pools((XmaHwSessionPrivate*) session->hw_session.private_do_not_use);
+
+    // Free the session
+    /*
+    delete (XmaHwSessionPrivate*)session->hw_session.private_do_not_use;
+    */
+    session->hw_session.private_do_not_use = nullptr;
+    session->plugin_data = nullptr;
+    session->stats = NULL;
+    //do not change kernel in_use as it maybe in use by another plugin
+    session->hw_session.dev_index = -1;
+    session->session_signature = NULL;
+}
+
 void logmsg(XmaLogLevelType level, const std::string& tag, const std::string& msg) {
     //TODO
     return;
@@ -739,3 +738,13 @@ void logmsg(XmaLogLevelType level, const std::string& tag, const std::string& ms
 
 } // namespace utils
 } // namespace xma_core
+
+XmaBufferPool::~XmaBufferPool() {
+    auto release = [](XmaBufferObj& b_obj) {
+        auto b_obj_priv = reinterpret_cast<XmaBufferObjPrivate*>(b_obj.private_do_not_touch);
+        b_obj_priv->dummy = nullptr;
+        delete b_obj_priv;
+    };
+    std::for_each(buffers_free.begin(), buffers_free.end(), release);
+    std::for_each(buffers_busy.begin(), buffers_busy.end(), release);
+}
@@ -237,6 +237,14 @@ void xma_thread1() {
             (uint32_t)priv1->cmd_idle_ticks,
             (uint32_t)priv1->kernel_complete_total);
 
+        xrt_core::message::send(
+            xrt_core::message::severity_level::info,
+            "XMA-Session-Stats", "Session id: %d, max queue depth: %d, cu cmd latency avg vs max: %.1f vs %d usec",
+            itr1.session_id,
+            (uint32_t)priv1->max_cu_cmds,
+            xma_core::utils::get_cmd_latency_avg(priv1),
+            (uint32_t)priv1->cmd_latency_max);
+
         XmaHwKernel* kernel_info = priv1->kernel_info;
         if (kernel_info == NULL) {
             continue;
@@ -280,52 +288,6 @@ void xma_thread1() {
     xrt_core::message::send(xrt_core::message::severity_level::info, "XMA-Session-Stats", "--------\n");
 }
 
-void xma_thread2(uint32_t hw_dev_index) {
-    std::promise<bool> p;
-    g_xma_singleton->all_thread2_futures.emplace_back(p.get_future());
-    p.set_value_at_thread_exit(true);
-
-    bool expected = false;
-    bool desired = true;
-    auto xrt_device_obj = g_xma_singleton->hwcfg.devices[hw_dev_index].xrt_device;
-    while (!g_xma_singleton->xma_exit) {
-        if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(3));
-        } else {
-            xrt_device_obj.get_handle()->exec_wait(100);
-        }
-
-        std::lock_guard<std::mutex> lock(g_xma_singleton->m_mutex);
-        for (auto& itr1: g_xma_singleton->all_sessions_vec) {
-            if (g_xma_singleton->xma_exit) {
-                break;
-            }
-            XmaHwSessionPrivate *priv1 = (XmaHwSessionPrivate*) itr1.hw_session.private_do_not_use;
-            expected = false;
-/*
-            while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-                std::this_thread::yield();
-                expected = false;
-            }
-*/
-            if (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-                continue;
-            }
-            //execbo lock acquired
-
-            if (xma_core::utils::check_all_execbo(itr1) != XMA_SUCCESS) {
-                xma_logmsg(XMA_ERROR_LOG, XMAAPI_MOD, "XMA thread2 failed-4. Unexpected error\n");
-                //Release execbo lock
-                priv1->execbo_locked = false;
-                continue;
-            }
-
-            //Release execbo lock
-            priv1->execbo_locked = false;
-        }
-    }
-}
-
 void xma_get_session_cmd_load() {
     xma_core::utils::get_session_cmd_load();
 }
@@ -453,14 +415,8 @@ int32_t xma_initialize(XmaXclbinParameter *devXclbins, int32_t num_parms)
     g_xma_singleton->cpu_mode = xrt_core::config::get_xma_cpu_mode();
     xma_logmsg(XMA_DEBUG_LOG, XMAAPI_MOD, "XMA CPU Mode is: %d", g_xma_singleton->cpu_mode.load());
 
+    //CU cmd completion is notified by xrt::run callbacks, no polling thread per device
     g_xma_singleton->xma_thread1 = std::thread(xma_thread1);
-    g_xma_singleton->all_thread2.reserve(MAX_XILINX_DEVICES);
-    g_xma_singleton->all_thread2_futures.reserve(MAX_XILINX_DEVICES);
-    uint32_t num_devices = g_xma_singleton->hwcfg.devices.size();
-    for (uint32_t i = 0; i < num_devices; i++) {
-        g_xma_singleton->all_thread2.emplace_back(std::thread(xma_thread2, i));
-        g_xma_singleton->all_thread2.back().detach();
-    }
     //Detach threads to let them run independently
     g_xma_singleton->xma_thread1.detach();
 
@@ -481,11 +437,5 @@ void xma_exit(void)
         if (g_xma_singleton->thread1_future.valid())
             g_xma_singleton->thread1_future.wait();
     } catch (...) {}
-    try {
-        for (const auto& thread2_f: g_xma_singleton->all_thread2_futures) {
-            if (thread2_f.valid())
-              thread2_f.wait();
-        }
-    } catch (...) {}
 }
 
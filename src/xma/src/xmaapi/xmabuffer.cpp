@@ -21,11 +21,17 @@
 #include "app/xmalogger.h"
 #include "app/xmaerror.h"
 #include "lib/xmahw_lib.h"
+#include "lib/xmalimits_lib.h"
 #include "lib/xma_utils.hpp"
 #include "core/common/api/bo.h"
 //#include <cstdio>
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #define XMA_BUFFER_MOD "xmabuffer"
 
@@ -36,6 +42,176 @@ typedef struct XmaFrameSideData
     enum XmaFrameSideDataType type;
 } XmaFrameSideData;
 
+namespace {
+
+// Host plane buffers allocated by xma_frame_alloc. Freed planes are kept
+// by size and handed out again, as frames of a stream all have the same
+// properties. Buffers not allocated here are released with free().
+//
+// The kept planes are limited per size and in total bytes. When the total
+// is reached, planes of other sizes are evicted first since they belong to
+// resolutions that are no longer allocated.
+class plane_pool
+{
+    std::mutex m_mutex;
+    std::unordered_map<size_t, std::vector<void*>> m_free; // size -> free planes
+    std::unordered_map<void*, size_t> m_size;               // plane -> size
+    size_t m_free_bytes = 0;                                // bytes in m_free
+
+    // Free a kept plane, caller holds the lock
+    void
+    drop(void* buffer, size_t size)
+    {
+        m_size.erase(buffer);
+        m_free_bytes -= size;
+        free(buffer);
+    }
+
+    // Evict kept planes of sizes other than 'keep' until 'bytes' more fit
+    // within the total limit. Returns false if they still do not fit.
+    bool
+    evict(size_t bytes, size_t keep)
+    {
+        for (auto itr = m_free.begin(); itr != m_free.end();) {
+            if (m_free_bytes + bytes <= XMA_MAX_POOL_FREE_PLANE_BYTES)
+                return true;
+            if (itr->first == keep) {
+                ++itr;
+                continue;
+            }
+            auto& planes = itr->second;
+            while (!planes.empty() && m_free_bytes + bytes > XMA_MAX_POOL_FREE_PLANE_BYTES) {
+                drop(planes.back(), itr->first);
+                planes.pop_back();
+            }
+            itr = planes.empty() ? m_free.erase(itr) : std::next(itr);
+        }
+        return m_free_bytes + bytes <= XMA_MAX_POOL_FREE_PLANE_BYTES;
+    }
+
+public:
+    void*
+    alloc(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& planes = m_free[size];
+        if (!planes.empty()) {
+            void* buffer = planes.back();
+            planes.pop_back();
+            m_free_bytes -= size;
+            return buffer;
+        }
+        void* buffer = malloc(size);
+        if (buffer)
+            m_size.emplace(buffer, size);
+        return buffer;
+    }
+
+    void
+    release(void* buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto itr = m_size.find(buffer);
+        if (itr == m_size.end()) {
+            free(buffer);
+            return;
+        }
+        auto size = itr->second;
+        auto& planes = m_free[size];
+        if (planes.size() < XMA_MAX_POOL_FREE_PLANES
+            && size <= XMA_MAX_POOL_FREE_PLANE_BYTES && evict(size, size)) {
+            planes.push_back(buffer);
+            m_free_bytes += size;
+            return;
+        }
+        m_size.erase(itr);
+        free(buffer);
+    }
+
+    // Free all kept planes
+    void
+    trim()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [size, planes] : m_free)
+            for (auto buffer : planes)
+                drop(buffer, size);
+        m_free.clear();
+    }
+};
+
+// Never destroyed, frames may be freed from static destructors at exit
+plane_pool*
+get_plane_pool()
+{
+    static auto pool = new plane_pool;
+    return pool;
+}
+
+// Size in bytes of a plane of frame. Chroma planes of 4:2:0 and 4:2:2
+// formats are subsampled, formats above 8 bits use 2 bytes per sample
+// and the 10 bit VCU formats pack 3 samples in 4 bytes. A larger
+// linesize, if set, is used as the stride.
+size_t
+frame_plane_size(const XmaFrameProperties *frame_props, int32_t plane)
+{
+    const size_t width = frame_props->width;
+    const size_t height = frame_props->height;
+    const size_t bytes = frame_props->bits_per_pixel > 8 ? 2 : 1;
+    size_t stride = width * bytes;
+    size_t rows = height;
+
+    switch (frame_props->format) {
+        case XMA_YUV420_FMT_TYPE:
+            if (plane > 0) {
+                stride = ((width + 1) / 2) * bytes;
+                rows = (height + 1) / 2;
+            }
+            break;
+        case XMA_YUV422_FMT_TYPE:
+            if (plane > 0)
+                stride = ((width + 1) / 2) * bytes;
+            break;
+        case XMA_RGB888_FMT_TYPE:
+            stride = width * 3;
+            break;
+        case XMA_VCU_NV12_FMT_TYPE:
+            //Interleaved chroma plane
+            if (plane > 0) {
+                stride = ((width + 1) / 2) * 2 * bytes;
+                rows = (height + 1) / 2;
+            }
+            break;
+        case XMA_VCU_NV16_FMT_TYPE:
+            if (plane > 0)
+                stride = ((width + 1) / 2) * 2 * bytes;
+            break;
+        case XMA_VCU_NV12_10LE32_FMT_TYPE:
+            stride = ((width + 2) / 3) * 4;
+            if (plane > 0)
+                rows = (height + 1) / 2;
+            break;
+        case XMA_VCU_NV16_10LE32_FMT_TYPE:
+            stride = ((width + 2) / 3) * 4;
+            break;
+        default:
+            break;
+    }
+    if (frame_props->linesize[plane] > 0)
+        stride = std::max(stride, static_cast<size_t>(frame_props->linesize[plane]));
+
+    return stride * rows;
+}
+
+} // namespace
+
+void
+xma_frame_pool_trim(void)
+{
+    xma_logmsg(XMA_DEBUG_LOG, XMA_BUFFER_MOD, "%s()\n", __func__);
+    get_plane_pool()->trim();
+}
+
 int32_t
 xma_frame_planes_get(XmaFrameProperties *frame_props)
 {
@@ -87,14 +263,19 @@ xma_frame_alloc(XmaFrameProperties *frame_props, bool dummy)
     {
         frame->data[i].refcount++;
         frame->data[i].is_clone = false;
-        // TODO: Get plane size for each plane
         if (dummy) {
             frame->data[i].buffer_type = NO_BUFFER;
             frame->data[i].buffer = nullptr;
         } else {
             frame->data[i].buffer_type = XMA_HOST_BUFFER_TYPE;
-            frame->data[i].buffer = malloc(static_cast<size_t>(frame_props->width) *
-                                       frame_props->height);
+            frame->data[i].buffer = get_plane_pool()->alloc(frame_plane_size(frame_props, i));
+            if (!frame->data[i].buffer) {
+                xma_logmsg(XMA_ERROR_LOG, XMA_BUFFER_MOD, "%s() OOM!!\n", __func__);
+                for (int32_t j = 0; j < i; j++)
+                    get_plane_pool()->release(frame->data[j].buffer);
+                free(frame);
+                return nullptr;
+            }
         }
         frame->data[i].xma_device_buf = nullptr;
     }
@@ -200,9 +381,12 @@ xma_device_buffer_free(XmaBufferObj *b_obj)
     if (xma_core::utils::xma_check_device_buffer(b_obj) != XMA_SUCCESS) {
         return;
     }
-    XmaBufferObjPrivate* b_obj_priv = (XmaBufferObjPrivate*) b_obj->private_do_not_touch;
-    b_obj_priv->dummy = nullptr;
-    delete b_obj_priv;
+    //Buffers allocated by a session plugin go back to the session pool
+    if (!xma_core::utils::put_pool_buffer(*b_obj)) {
+        XmaBufferObjPrivate* b_obj_priv = (XmaBufferObjPrivate*) b_obj->private_do_not_touch;
+        b_obj_priv->dummy = nullptr;
+        delete b_obj_priv;
+    }
     b_obj->data = nullptr;
     b_obj->size = -1;
     b_obj->bank_index = -1;
@@ -236,7 +420,7 @@ xma_frame_free(XmaFrame *frame)
                     xma_device_buffer_free(frame->data[i].xma_device_buf);
                     break;
                 case XMA_HOST_BUFFER_TYPE:
-                    free(frame->data[i].buffer);
+                    get_plane_pool()->release(frame->data[i].buffer);
                     break;
                 default:
                     break;
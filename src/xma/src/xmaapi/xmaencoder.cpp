@@ -313,22 +313,10 @@ xma_enc_session_destroy(XmaEncoderSession *session)
         xma_logmsg(XMA_ERROR_LOG, XMA_ENCODER_MOD,
                    "Error closing encoder plugin. Return code %d\n", rc);
 
-    // Clean up the private data
-    free(session->base.plugin_data);
-
-    // Free the session
+    xma_core::utils::release_session(&session->base);
     //Let's not chnage in_use and num of encoders
     //It is better to have different session_id for debugging
-    /*
-    delete (XmaHwSessionPrivate*)session->base.hw_session.private_do_not_use;
-    */
-    session->base.hw_session.private_do_not_use = nullptr;
-    session->base.plugin_data = nullptr;
-    session->base.stats = NULL;
     session->encoder_plugin = NULL;
-    //do not change kernel in_use as it maybe in use by another plugin
-    session->base.hw_session.dev_index = -1;
-    session->base.session_signature = NULL;
     free(session);
     session = nullptr;
 
@@ -263,20 +263,8 @@ xma_kernel_session_destroy(XmaKernelSession *session)
         xma_logmsg(XMA_ERROR_LOG, XMA_KERNEL_MOD,
                    "Error closing kernel plugin\n");
 
-    // Clean up the private data
-    free(session->base.plugin_data);
-
-    // Free the session
-    /*
-    delete (XmaHwSessionPrivate*)session->base.hw_session.private_do_not_use;
-    */
-    session->base.hw_session.private_do_not_use = nullptr;
-    session->base.plugin_data = nullptr;
-    session->base.stats = NULL;
+    xma_core::utils::release_session(&session->base);
     session->kernel_plugin = NULL;
-    //do not change kernel in_use as it maybe in use by another plugin
-    session->base.hw_session.dev_index = -1;
-    session->base.session_signature = NULL;
     free(session);
     session = nullptr;
 
@@ -359,20 +359,8 @@ xma_scaler_session_destroy(XmaScalerSession *session)
         xma_logmsg(XMA_ERROR_LOG, XMA_SCALER_MOD,
                    "Error closing scaler plugin. Return code %d\n", rc);
 
-    // Clean up the private data
-    free(session->base.plugin_data);
-
-    // Free the session
-    /*
-    delete (XmaHwSessionPrivate*)session->base.hw_session.private_do_not_use;
-    */
-    session->base.hw_session.private_do_not_use = nullptr;
-    session->base.plugin_data = nullptr;
-    session->base.stats = NULL;
+    xma_core::utils::release_session(&session->base);
     session->scaler_plugin = NULL;
-    //do not change kernel in_use as it maybe in use by another plugin
-    session->base.hw_session.dev_index = -1;
-    session->base.session_signature = NULL;
     free(session);
     session = nullptr;
 
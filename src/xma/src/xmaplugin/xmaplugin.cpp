@@ -113,6 +113,15 @@ XmaBufferObj  create_xma_buffer_object(XmaSession s_handle, size_t size, bool de
         return b_obj_error;
     }
     
+    //Reuse a buffer freed earlier in this session if one with same properties is available
+    auto pool = xma_core::utils::get_buffer_pool(priv1, size, b_obj.bank_index, b_obj.dev_index, device_only_buffer);
+    if (xma_core::utils::get_pool_buffer(pool.get(), b_obj)) {
+        if (!b_obj.device_only_buffer)
+            std::fill(b_obj.data, b_obj.data + size, 0);
+        if (return_code) *return_code = XMA_SUCCESS;
+        return b_obj;
+    }
+
     xrt::bo b_obj_handle;
     if (create_bo(dev_handle, b_obj, size, ddr_bank, device_only_buffer, b_obj_handle) != XMA_SUCCESS) {
         if (return_code) *return_code = XMA_ERROR;
@@ -123,6 +132,8 @@ XmaBufferObj  create_xma_buffer_object(XmaSession s_handle, size_t size, bool de
     b_obj.private_do_not_touch = tmp1;
     tmp1->dummy = (void*)(((uint64_t)tmp1) | signature);
     tmp1->xrt_bo = b_obj_handle;
+    tmp1->pool = pool;
+    pool->num_buffers++;
 
     if (return_code) *return_code = XMA_SUCCESS;
     return b_obj;
@@ -205,6 +216,10 @@ xma_plg_buffer_free(XmaSession s_handle, XmaBufferObj b_obj)
     if (xma_core::utils::xma_check_device_buffer(&b_obj) != XMA_SUCCESS) {
         return;
     }
+    //Keep the buffer for reuse by the session
+    if (xma_core::utils::put_pool_buffer(b_obj)) {
+        return;
+    }
     auto b_obj_priv = reinterpret_cast<XmaBufferObjPrivate*>(b_obj.private_do_not_touch);
     b_obj_priv->dummy = nullptr;
     delete b_obj_priv;
@@ -304,7 +319,6 @@ int32_t xma_plg_execbo_avail_get(XmaSession s_handle)
         priv1->execbo_lru.pop_back();
         XmaHwExecBO* execbo_tmp1 = &priv1->kernel_execbos[val];
         execbo_tmp1->in_use = true;
-        priv1->execbo_to_check.emplace_back(val);
         return val;
     }
     return -1;
@@ -318,7 +332,7 @@ int32_t xma_plg_execbo_avail_get2(XmaSession s_handle)
     int32_t i; 
     int32_t rc = -1;
     bool    found = false;
-    //NOTE: execbo lock must be already acquired
+    //NOTE: session m_mutex must be already acquired
 
     for (i = 0; i < num_execbo; i++) {
         XmaHwExecBO* execbo_tmp1 = &priv1->kernel_execbos[i];
@@ -336,95 +350,34 @@ int32_t xma_plg_execbo_avail_get2(XmaSession s_handle)
     return rc;
 }
 
-XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
-                                 void            *regmap,
-                                 int32_t         regmap_size,
-                                 int32_t*   return_code)
+// submit_execbo_cmd() - Copies regmap into a free execbo of the session and starts it.
+// The cmd is retired by the execbo completion callback, see execbo_completed().
+static XmaCUCmdObj
+submit_execbo_cmd(XmaSession& s_handle, XmaHwSessionPrivate* priv1, XmaHwKernel* kernel_tmp1,
+                  void* regmap, int32_t regmap_size, int32_t* return_code)
 {
     XmaCUCmdObj cmd_obj_error;
     cmd_obj_default(cmd_obj_error);
-
-    if (xma_core::utils::check_xma_session(s_handle) != XMA_SUCCESS) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "xma_plg_schedule_work_item failed. XMASession is corrupted.");
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-    auto priv1 = reinterpret_cast<XmaHwSessionPrivate*>(s_handle.hw_session.private_do_not_use);
-    if (s_handle.session_type >= XMA_ADMIN) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "xma_plg_schedule_work_item can not be used for this XMASession type");
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-
-    XmaHwKernel* kernel_tmp1 = priv1->kernel_info;
     XmaHwDevice *dev_tmp1 = priv1->device;
-    if (dev_tmp1 == nullptr) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session XMA private pointer is nullptr");
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-    if (regmap == nullptr) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "regmap is NULL");
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-    if (regmap_size <= 0) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. regmap_size of %d is invalid", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), regmap_size);
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-    //Kernel regmap 4KB in xmahw.h; execBO size is 4096 = 4KB in xmahw_hal.cpp; But ERT uses some space for ert pkt so allow max of 4032 Bytes for regmap
-    if (regmap_size > MAX_KERNEL_REGMAP_SIZE) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Max kernel regmap size is %d Bytes", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), MAX_KERNEL_REGMAP_SIZE);
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-    if ((uint32_t)regmap_size != ((uint32_t)regmap_size & 0xFFFFFFFC)) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. regmap_size of %d is not a multiple of four bytes", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), regmap_size);
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }   
-
-    uint8_t *src = (uint8_t*)regmap;    
-    bool expected = false;
-    bool desired = true;
     int32_t bo_idx = -1;
+
+    std::unique_lock<std::mutex> lk(priv1->m_mutex);
     //With KDS2.0 ensure no outstanding command
-    while (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
-        std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->kernel_done_or_free.wait_for(lk, std::chrono::milliseconds(1));
+    if (!g_xma_singleton->kds_old) {
+        priv1->kernel_done_or_free.wait(lk, [priv1] { return priv1->num_cu_cmds == 0; });
     }
     // Find an available execBO buffer
-    uint32_t itr = 0;
-    while (true) {
-        expected = false;
-        while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-            std::this_thread::yield();
-            expected = false;
-        }
-
+    priv1->execbo_is_free.wait(lk, [&] {
         if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
             bo_idx = xma_plg_execbo_avail_get2(s_handle);
         } else {
             bo_idx = xma_plg_execbo_avail_get(s_handle);
         }
-        if (bo_idx != -1) {
-            break;
-        }
-        xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "No available execbo found");
-        priv1->execbo_locked = false;
-        if (itr > 15) {
-            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Unable to find free execbo to use\n");
-            if (return_code) *return_code = XMA_ERROR;
-            return cmd_obj_error;
-        }
-        std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->execbo_is_free.wait(lk);
-        lk.unlock();
-        itr++;
-    }      
-        
-    auto xrt_kernel_reg_map = (xrt_core::kernel_int::get_regmap_size(priv1->kernel_execbos[bo_idx].xrt_kernel)) * 4;
+        return bo_idx != -1;
+    });
+    auto& ebo = priv1->kernel_execbos[bo_idx];
+
+    auto xrt_kernel_reg_map = (xrt_core::kernel_int::get_regmap_size(ebo.xrt_kernel)) * 4;
     if (xrt_kernel_reg_map > 0) {
         if (regmap_size > (int32_t) xrt_kernel_reg_map) {
             xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Can not exceed kernel register_map size. Kernel regamp_size: %d, trying to use size: %d", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), xrt_kernel_reg_map, regmap_size);
@@ -433,48 +386,10 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
             return cmd_obj_error;
             */
         }
-    }    
-    auto cu_cmd = reinterpret_cast<ert_start_kernel_cmd*>(priv1->kernel_execbos[bo_idx].xrt_run.get_ert_packet());
-    // Copy reg_map into execBO buffer 
-    memcpy(&cu_cmd->data + cu_cmd->extra_cu_masks, src, regmap_size);
-
-    //With KDS2.0 ensure no outstanding command
-    if (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Unexpected error. Outstanding cmd found.", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-        priv1->execbo_locked = false;
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-
-    if (priv1->num_cu_cmds != 0) {
-//#ifdef __GNUC__
-//# pragma GCC diagnostic push
-//# pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-//#endif
-//	/* This is no longer supported by new KDS implementation. */
-//        if (xclExecBufWithWaitList(priv1->dev_handle.get_handle()->get_device_handle(),
-//                        priv1->kernel_execbos[bo_idx].handle, 1, &priv1->last_execbo_handle) != 0) {
-//#ifdef __GNUC__
-//# pragma GCC diagnostic pop
-//#endif
-//            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD,
-//                        "Failed to submit kernel start with xclExecBuf");
-//            priv1->execbo_locked = false;
-//            if (return_code) *return_code = XMA_ERROR;
-//            return cmd_obj_error;
-//        }
-    } else {
-        try {
-            priv1->kernel_execbos[bo_idx].xrt_run.start();//start Kernel
-        }
-        catch (const xrt_core::system_error&) {
-            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD,
-                "Failed to submit kernel start with xclExecBuf");
-            priv1->execbo_locked = false;
-            if (return_code) *return_code = XMA_ERROR;
-            return cmd_obj_error;
-        }
     }
+    auto cu_cmd = reinterpret_cast<ert_start_kernel_cmd*>(ebo.xrt_run.get_ert_packet());
+    // Copy reg_map into execBO buffer 
+    memcpy(&cu_cmd->data + cu_cmd->extra_cu_masks, regmap, regmap_size);
 
     XmaCUCmdObj cmd_obj;
     cmd_obj_default(cmd_obj);
@@ -507,18 +422,91 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
             itr_tmp1.first->second.cu_id = cmd_obj.cu_index;
             itr_tmp1.first->second.execbo_id = bo_idx;
 
-            priv1->kernel_execbos[bo_idx].cu_cmd_id1 = tmp_int1;
-            priv1->kernel_execbos[bo_idx].cu_cmd_id2 = cmd_obj.cmd_id2;
+            ebo.cu_cmd_id1 = tmp_int1;
+            ebo.cu_cmd_id2 = cmd_obj.cmd_id2;
         }
     }
+    if (priv1->num_cu_cmds > priv1->max_cu_cmds) {
+        priv1->max_cu_cmds = (uint32_t)priv1->num_cu_cmds;
+    }
+    ebo.start_time = std::chrono::steady_clock::now();
+    //Cmd is fully populated and inserted in the command list before start
+    //so completion callback can retire it; Lock is not held while submitting
+    lk.unlock();
+
+    try {
+        ebo.xrt_run.start();//start Kernel
+    }
+    catch (const xrt_core::system_error&) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD,
+            "Failed to submit kernel start with xclExecBuf");
+        lk.lock();
+        priv1->CU_cmds.erase(cmd_obj.cmd_id1);
+        priv1->num_cu_cmds--;
+        ebo.in_use = false;
+        lk.unlock();
+        priv1->execbo_is_free.notify_all();
+        priv1->kernel_done_or_free.notify_all();
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
 
-    //xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "2. Num of cmds in-progress = %lu", priv1->CU_cmds.size());
-    //Release execbo lock only after the command is fully populated and inserted in the command list
-    priv1->execbo_locked = false;
     if (return_code) *return_code = XMA_SUCCESS;
     return cmd_obj;
 }
 
+XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
+                                 void            *regmap,
+                                 int32_t         regmap_size,
+                                 int32_t*   return_code)
+{
+    XmaCUCmdObj cmd_obj_error;
+    cmd_obj_default(cmd_obj_error);
+
+    if (xma_core::utils::check_xma_session(s_handle) != XMA_SUCCESS) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "xma_plg_schedule_work_item failed. XMASession is corrupted.");
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+    auto priv1 = reinterpret_cast<XmaHwSessionPrivate*>(s_handle.hw_session.private_do_not_use);
+    if (s_handle.session_type >= XMA_ADMIN) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "xma_plg_schedule_work_item can not be used for this XMASession type");
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+
+    XmaHwKernel* kernel_tmp1 = priv1->kernel_info;
+    XmaHwDevice *dev_tmp1 = priv1->device;
+    if (dev_tmp1 == nullptr) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session XMA private pointer is nullptr");
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+    if (regmap == nullptr) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "regmap is NULL");
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+    if (regmap_size <= 0) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. regmap_size of %d is invalid", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), regmap_size);
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+    //Kernel regmap 4KB in xmahw.h; execBO size is 4096 = 4KB in xmahw_hal.cpp; But ERT uses some space for ert pkt so allow max of 4032 Bytes for regmap
+    if (regmap_size > MAX_KERNEL_REGMAP_SIZE) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Max kernel regmap size is %d Bytes", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), MAX_KERNEL_REGMAP_SIZE);
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }
+    if ((uint32_t)regmap_size != ((uint32_t)regmap_size & 0xFFFFFFFC)) {
+        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. regmap_size of %d is not a multiple of four bytes", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), regmap_size);
+        if (return_code) *return_code = XMA_ERROR;
+        return cmd_obj_error;
+    }   
+
+    return submit_execbo_cmd(s_handle, priv1, kernel_tmp1, regmap, regmap_size, return_code);
+}
+
 XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
                                  void       *regmap,
                                  int32_t    regmap_size,
@@ -576,139 +564,7 @@ XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
         return cmd_obj_error;
     }
 
-    uint8_t *src = (uint8_t*)regmap;    
-    bool expected = false;
-    bool desired = true;
-    int32_t bo_idx = -1;
-    //With KDS2.0 ensure no outstanding command
-    while (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
-        std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->kernel_done_or_free.wait_for(lk, std::chrono::milliseconds(1));
-    }
-
-    // Find an available execBO buffer
-    uint32_t itr = 0;
-    while (true) {
-        expected = false;
-        while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-            std::this_thread::yield();
-            expected = false;
-        }
-
-        if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-            bo_idx = xma_plg_execbo_avail_get2(s_handle);
-        } else {
-            bo_idx = xma_plg_execbo_avail_get(s_handle);
-        }
-        if (bo_idx != -1) {
-            break;
-        }
-        priv1->execbo_locked = false;
-        xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "No available execbo found");
-        if (itr > 15) {
-            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Unable to find free execbo to use\n");
-            if (return_code) *return_code = XMA_ERROR;
-            return cmd_obj_error;
-        }
-        std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->execbo_is_free.wait(lk);
-        lk.unlock();
-        itr++;
-    }
-        
-    auto xrt_kernel_reg_map = (xrt_core::kernel_int::get_regmap_size(priv1->kernel_execbos[bo_idx].xrt_kernel)) * 4;
-    if (xrt_kernel_reg_map > 0) {
-        if (regmap_size > (int32_t) xrt_kernel_reg_map) {
-            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Can not exceed kernel register_map size. Kernel regamp_size: %d, trying to use size: %d", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str(), xrt_kernel_reg_map, regmap_size);
-            /*TODO
-            if (return_code) *return_code = XMA_ERROR;
-            return cmd_obj_error;
-            */
-        }
-    }    
-    auto cu_cmd = reinterpret_cast<ert_start_kernel_cmd*>(priv1->kernel_execbos[bo_idx].xrt_run.get_ert_packet());
-    // Copy reg_map into execBO buffer 
-    memcpy(&cu_cmd->data + cu_cmd->extra_cu_masks, src, regmap_size);
-
-    //With KDS2.0 ensure no outstanding command
-    if (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. Unexpected error. Outstanding cmd found.", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-        priv1->execbo_locked = false;
-        if (return_code) *return_code = XMA_ERROR;
-        return cmd_obj_error;
-    }
-
-    if (priv1->num_cu_cmds != 0) {
-//#ifdef __GNUC__
-//# pragma GCC diagnostic push
-//# pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-//#endif
-//	/* This is no longer supported by new KDS implementation. */
-//        if (xclExecBufWithWaitList(priv1->dev_handle.get_handle()->get_device_handle(),
-//                        priv1->kernel_execbos[bo_idx].handle, 1, &priv1->last_execbo_handle) != 0) {
-//#ifdef __GNUC__
-//# pragma GCC diagnostic pop
-//#endif
-//            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD,
-//                        "Failed to submit kernel start with xclExecBuf");
-//            priv1->execbo_locked = false;
-//            if (return_code) *return_code = XMA_ERROR;
-//            return cmd_obj_error;
-//        }
-    } else {
-        try {
-            priv1->kernel_execbos[bo_idx].xrt_run.start();//start Kernel
-        }
-        catch (const xrt_core::system_error&) {
-            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD,
-                "Failed to submit kernel start with xclExecBuf");
-            priv1->execbo_locked = false;
-            if (return_code) *return_code = XMA_ERROR;
-            return cmd_obj_error;
-        }
-    }
-
-    XmaCUCmdObj cmd_obj;
-    cmd_obj_default(cmd_obj);
-    cmd_obj.cu_index = kernel_tmp1->cu_index;
-    cmd_obj.do_not_use1 = s_handle.session_signature;
-
-    bool found = false;
-    while(!found) {
-        dev_tmp1->cu_cmd_id1++;
-        uint32_t tmp_int1 = dev_tmp1->cu_cmd_id1;
-        if (tmp_int1 == 0) {
-            tmp_int1 = 1;
-            dev_tmp1->cu_cmd_id1 = tmp_int1;
-            //Change seed of random_generator
-            std::random_device rd;
-            uint32_t tmp_int = time(0);
-            std::seed_seq seed_seq{rd(), tmp_int};
-            dev_tmp1->mt_gen = std::mt19937(seed_seq);
-            dev_tmp1->cu_cmd_id2 = dev_tmp1->rnd_dis(dev_tmp1->mt_gen);
-        } else {
-            dev_tmp1->cu_cmd_id2++;
-        }
-        auto itr_tmp1 = priv1->CU_cmds.emplace(tmp_int1, XmaCUCmdObjPrivate{});
-        if (itr_tmp1.second) {//It is newly inserted item;
-            priv1->num_cu_cmds++;
-            found = true;
-            cmd_obj.cmd_id1 = tmp_int1;
-            cmd_obj.cmd_id2 = dev_tmp1->cu_cmd_id2;
-            itr_tmp1.first->second.cmd_id2 = cmd_obj.cmd_id2;
-            itr_tmp1.first->second.cu_id = cmd_obj.cu_index;
-            itr_tmp1.first->second.execbo_id = bo_idx;
-
-            priv1->kernel_execbos[bo_idx].cu_cmd_id1 = tmp_int1;
-            priv1->kernel_execbos[bo_idx].cu_cmd_id2 = cmd_obj.cmd_id2;
-        }
-    }
-
-    //xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "2. Num of cmds in-progress = %lu", priv1->CU_cmds.size());
-    //Release execbo lock only after the command is fully populated and inserted in the command list
-    priv1->execbo_locked = false;
-    if (return_code) *return_code = XMA_SUCCESS;
-    return cmd_obj;
+    return submit_execbo_cmd(s_handle, priv1, kernel_tmp1, regmap, regmap_size, return_code);
 }
 
 int32_t xma_plg_cu_cmd_status(XmaSession s_handle, XmaCUCmdObj* cmd_obj_array, int32_t num_cu_objs, bool wait_for_cu_cmds)
@@ -749,62 +605,43 @@ int32_t xma_plg_cu_cmd_status(XmaSession s_handle, XmaCUCmdObj* cmd_obj_array, i
         return XMA_ERROR;
     }
 
-    bool expected = false;
-    bool desired = true;
-    bool all_done = true;
-    while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-        std::this_thread::yield();
-        expected = false;
-    }
-
-    if (xma_core::utils::check_all_execbo(s_handle) != XMA_SUCCESS) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "work_item_done->check_all_execbo. Unexpected error");
-        //Release execbo lock
-        priv1->execbo_locked = false;
-        return XMA_ERROR;
+    std::vector<XmaCUCmdObj> cmd_vector(cmd_obj_array, cmd_obj_array+num_cu_objs);
+    for (auto& cmd: cmd_vector) {
+        if (s_handle.session_type < XMA_ADMIN && cmd.cu_index != kernel_tmp1->cu_index) {
+            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj_array is corrupted-1");
+            return XMA_ERROR;
+        }
+        if (cmd.cmd_id1 == 0 || cmd.cu_index == -1) {
+            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj is invalid. Schedule_command may have  failed");
+            return XMA_ERROR;
+        }
+        if (cmd.do_not_use1 != s_handle.session_signature) {
+            xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj_array is corrupted-5");
+            return XMA_ERROR;
+        }
     }
-    //Release execbo lock
-    priv1->execbo_locked = false;
 
-    std::vector<XmaCUCmdObj> cmd_vector(cmd_obj_array, cmd_obj_array+num_cu_objs);
-    do {
-        all_done = true;
+    //Cmds are removed from CU_cmds by execbo completion callback
+    auto all_done = [priv1, &cmd_vector] {
+        bool done = true;
         for (auto& cmd: cmd_vector) {
-            if (s_handle.session_type < XMA_ADMIN && cmd.cu_index != kernel_tmp1->cu_index) {
-                xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj_array is corrupted-1");
-                return XMA_ERROR;
-            }
-            if (cmd.cmd_id1 == 0 || cmd.cu_index == -1) {
-                xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj is invalid. Schedule_command may have  failed");
-                return XMA_ERROR;
-            }
-            auto itr_tmp1 = priv1->CU_cmds.find(cmd.cmd_id1);
-            if (itr_tmp1 == priv1->CU_cmds.end()) {
+            if (priv1->CU_cmds.find(cmd.cmd_id1) == priv1->CU_cmds.end()) {
                 cmd.cmd_finished = true;
             } else {
-                all_done = false;
-            }
-
-            if (cmd.do_not_use1 != s_handle.session_signature) {
-                xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj_array is corrupted-5");
-                return XMA_ERROR;
+                done = false;
             }
         }
+        return done;
+    };
 
-        if (!wait_for_cu_cmds) {
-            //Don't wait for all cu_cmds to finsh
-            all_done = true;
-        } else if (!all_done) {
-            if (g_xma_singleton->cpu_mode == XMA_CPU_MODE1) {
-                std::unique_lock<std::mutex> lk(priv1->m_mutex);
-                priv1->kernel_done_or_free.wait(lk);
-            } else if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-                std::this_thread::yield();
-            } else {
-                xrt_core::device_int::exec_wait(dev_tmp1->xrt_device, 100ms);
-            }
-        }
-    } while(!all_done);
+    std::unique_lock<std::mutex> lk(priv1->m_mutex);
+    if (wait_for_cu_cmds) {
+        priv1->kernel_done_or_free.wait(lk, all_done);
+    } else {
+        //Don't wait for all cu_cmds to finsh
+        all_done();
+    }
+    lk.unlock();
 
     for(int32_t i = 0; i < num_cu_objs; i++) {
         cmd_obj_array[i].cmd_finished = cmd_vector[i].cmd_finished;
@@ -841,218 +678,22 @@ int32_t xma_plg_is_work_item_done(XmaSession s_handle, uint32_t timeout_ms)
         return XMA_ERROR;
     }
 
-    int32_t count = 0;
-
-    count = priv1->kernel_complete_count;
-    if (count) {
-        priv1->kernel_complete_count--;
-        if (count > 255) {
-            xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
-        }
-        return XMA_SUCCESS;
-    }
-    bool expected = false;
-    bool desired = true;
-/*
-    while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-        std::this_thread::yield();
-        expected = false;
-    }
-
-    if (xma_core::utils::check_all_execbo(s_handle) != XMA_SUCCESS) {
-        xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "work_item_done->check_all_execbo. Unexpected error");
-        //Release execbo lock
-        priv1->execbo_locked = false;
-        return XMA_ERROR;
-    }
-    //Release execbo lock
-    priv1->execbo_locked = false;
-
-    count = priv1->kernel_complete_count;
-    if (count) {
-        priv1->kernel_complete_count--;
-        if (count > 255) {
-            xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
-        }
-        return XMA_SUCCESS;
-    }
-    if (priv1->num_cu_cmds == 0 && count == 0) {
+    //Timeout required if cu is hung
+    auto timeout = std::chrono::milliseconds(std::max<uint32_t>(timeout_ms, 100));
+    std::unique_lock<std::mutex> lk(priv1->m_mutex);
+    if (priv1->num_cu_cmds == 0 && priv1->kernel_complete_count == 0) {
         xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. There may not be any outstandng CU command to wait for\n", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
     }
-*/
-    uint32_t iter1 = timeout_ms / 10;
-    if (iter1 < 10) {
-        iter1 = 10;
-    }
-    uint32_t timeout1 = 10;
-    uint32_t tmp_num_cmds = 1;
-    if (g_xma_singleton->cpu_mode == XMA_CPU_MODE1) {
-        while (iter1 > 0) {
-            std::unique_lock<std::mutex> lk(priv1->m_mutex);
-            //priv1->work_item_done_1plus.wait(lk);
-	    //Timeout required if cu is hung; Unblock and check status again
-            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(timeout1));
-            lk.unlock();
-
-            tmp_num_cmds = priv1->num_cu_cmds;
-            count = priv1->kernel_complete_count;
-            if (count) {
-                priv1->kernel_complete_count--;
-                if (count > 255) {
-                    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
-                }
-                return XMA_SUCCESS;
-            }
-	    //Get num_cmds pending first before the done count check
-            if (tmp_num_cmds == 0 && count == 0) {
-                xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. There may not be any outstandng CU command to wait for\n", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-            }
-
-            iter1--;
-        }
-        xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. CU cmd is still pending. Cu might be stuck", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-        return XMA_ERROR;
-    }
-
-    if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-	iter1 = iter1 * 10;
-        while (iter1 > 0) {
-            expected = false;
-            if (priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-                //kernel completion lock acquired
-
-                if (xma_core::utils::check_all_execbo(s_handle) != XMA_SUCCESS) {
-                    xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "check_all-2: Unexpected error\n");
-                    //Release execbo lock
-                    priv1->execbo_locked = false;
-                    return XMA_ERROR;
-                }
-                //Release execbo lock
-                priv1->execbo_locked = false;
-            }
-            tmp_num_cmds = priv1->num_cu_cmds;
-            count = priv1->kernel_complete_count;
-            if (count) {
-                priv1->kernel_complete_count--;
-                if (count > 255) {
-                    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
-                }
-                return XMA_SUCCESS;
-            }
-	    //Get num_cmds pending first before the done count check
-            if (tmp_num_cmds == 0 && count == 0) {
-                xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. There may not be any outstandng CU command to wait for\n", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-            }
-
-            iter1--;
-            //std::this_thread::yield();
-	    //Debug mode: Use small timeout
-	    std::unique_lock<std::mutex> lk(priv1->m_mutex);
-            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(1));
-
-        }
-        xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. CU cmd is still pending. Cu might be stuck", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-        return XMA_ERROR;
-    }
-
-    if (g_xma_singleton->cpu_mode == XMA_CPU_MODE3) {
-        while (iter1 > 0) {
-            expected = false;
-            while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-                std::this_thread::yield();
-                expected = false;
-            }
-
-            if (xma_core::utils::check_all_execbo(s_handle) != XMA_SUCCESS) {
-                xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "work_item_done->check_all_execbo. Unexpected error");
-                //Release execbo lock
-                priv1->execbo_locked = false;
-                return XMA_ERROR;
-            }
-            //Release execbo lock
-            priv1->execbo_locked = false;
-
-            tmp_num_cmds = priv1->num_cu_cmds;
-            count = priv1->kernel_complete_count;
-            if (count) {
-                priv1->kernel_complete_count--;
-                if (count > 255) {
-                    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
-                }
-                return XMA_SUCCESS;
-            }
-	    //Get num_cmds pending first before the done count check
-            if (tmp_num_cmds == 0 && count == 0) {
-                xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. There may not be any outstandng CU command to wait for\n", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-            }
-            xrt_core::device_int::exec_wait(dev_tmp1->xrt_device, std::chrono::milliseconds(timeout1));
-            iter1--;
-        }
+    //kernel_complete_count is incremented by execbo completion callback
+    if (!priv1->work_item_done_1plus.wait_for(lk, timeout, [priv1] { return priv1->kernel_complete_count != 0; })) {
         xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. CU cmd is still pending. Cu might be stuck", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
         return XMA_ERROR;
     }
-
-    //Below is CPU mode-4; low cpu load mode
-    int32_t give_up = 0;
-    if (iter1 < 20) {
-        iter1 = 20;
-    }
-    while (give_up < (int32_t)iter1) {
-        count = priv1->kernel_complete_count;
-        if (count) {
-            priv1->kernel_complete_count--;
-            if (count > 255) {
-                xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output\n");
-            }
-            return XMA_SUCCESS;
-        }
-
-        expected = false;
-        if (priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-            //kernel completion lock acquired
-
-            if (xma_core::utils::check_all_execbo(s_handle) != XMA_SUCCESS) {
-                xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "check_all-2: Unexpected error\n");
-                //Release execbo lock
-                priv1->execbo_locked = false;
-                return XMA_ERROR;
-            }
-            //Release execbo lock
-            priv1->execbo_locked = false;
-
-            count = priv1->kernel_complete_count;
-            if (count) {
-                priv1->kernel_complete_count--;
-                if (count > 255) {
-                    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output\n");
-                }
-                return XMA_SUCCESS;
-            }
-        }
-    
-        // Wait for a notification
-        if (give_up > 10) {
-            xrt_core::device_int::exec_wait(dev_tmp1->xrt_device, std::chrono::milliseconds(timeout1));
-            tmp_num_cmds = priv1->num_cu_cmds;
-            count = priv1->kernel_complete_count;
-            if (count) {
-                priv1->kernel_complete_count--;
-                if (count > 255) {
-                    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output\n");
-                }
-                return XMA_SUCCESS;
-            }
-	    //Get num_cmds pending first before the done count check
-            if (tmp_num_cmds == 0 && count == 0) {
-                xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. There may not be any outstandng CU command to wait for\n", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-            }
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(3));
-        }
-        give_up++;
+    int32_t count = priv1->kernel_complete_count--;
+    if (count > 255) {
+        xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "CU completion count is more than 256. Application maybe slow to process CU output");
     }
-    xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. CU cmd is still pending. Cu might be stuck", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
-    return XMA_ERROR;
+    return XMA_SUCCESS;
 }
 
 int32_t xma_plg_work_item_return_code(XmaSession s_handle, XmaCUCmdObj* cmd_obj_array, int32_t num_cu_objs, uint32_t* num_cu_errors)
@@ -1085,6 +726,7 @@ int32_t xma_plg_work_item_return_code(XmaSession s_handle, XmaCUCmdObj* cmd_obj_
 
     XmaCUCmdObj* cmd_end = cmd_obj_array+num_cu_objs;
     uint32_t num_errors = 0;
+    std::lock_guard<std::mutex> lk(priv1->m_mutex);
     for (auto itr = cmd_obj_array; itr < cmd_end; ++itr) {
         auto& cmd = *itr;
         if (cmd.do_not_use1 != s_handle.session_signature) {
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+
+// Checks hipEventRecord/hipEventSynchronize/hipEventElapsedTime around
+// kernel launches, and hipStreamWaitEvent ordering work on a second
+// stream after an event recorded on the first.
+
+#include <iostream>
+#include <array>
+#include <vector>
+
+#include "hip/hip_runtime_api.h"
+
+#include "common.h"
+
+namespace {
+
+static constexpr char const *kernel_filename = "kernel.co";
+static constexpr char const *kernel_name = "vectoradd";
+
+static constexpr int vector_length = 0x100000;
+static constexpr int vector_size = vector_length * sizeof(float);
+static constexpr int threads_per_block_x = 32;
+static constexpr int repeat_loop = 100;
+
+int
+mainworker()
+{
+  xrt_hip_test_common::hip_test_device hdevice;
+  hdevice.show_info(std::cout);
+
+  hipFunction_t function = hdevice.get_function(kernel_filename, kernel_name);
+
+  hipStream_t run_stream = nullptr;
+  xrt_hip_test_common::test_hip_check(hipStreamCreateWithFlags(&run_stream, hipStreamNonBlocking));
+  hipStream_t copy_stream = nullptr;
+  xrt_hip_test_common::test_hip_check(hipStreamCreateWithFlags(&copy_stream, hipStreamNonBlocking));
+
+  hipEvent_t start = nullptr;
+  hipEvent_t stop = nullptr;
+  xrt_hip_test_common::test_hip_check(hipEventCreate(&start));
+  xrt_hip_test_common::test_hip_check(hipEventCreate(&stop));
+
+  std::vector<float> host_a(vector_length);
+  std::vector<float> host_b(vector_length);
+  std::vector<float> host_c(vector_length);
+  for (int i = 0; i < vector_length; i++) {
+    host_b[i] = static_cast<float>(i);
+    host_c[i] = static_cast<float>(i * 2);
+    host_a[i] = 0;
+  }
+
+  xrt_hip_test_common::hip_test_device_bo<float> device_a(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_b(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_c(vector_length);
+
+  xrt_hip_test_common::test_hip_check(hipMemsetAsync(device_a.get(), 0, vector_size, run_stream));
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_b.get(), host_b.data(), vector_size, hipMemcpyHostToDevice, run_stream));
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_c.get(), host_c.data(), vector_size, hipMemcpyHostToDevice, run_stream));
+
+  std::array<void *, 3> args = {&device_a.get(), &device_b.get(), &device_c.get()};
+
+  // Time the kernels with events recorded around them on run_stream
+  std::cout << "Run " << kernel_name << ' ' << repeat_loop << " times between events" << std::endl;
+  xrt_hip_test_common::test_hip_check(hipEventRecord(start, run_stream));
+  for (int i = 0; i < repeat_loop; i++) {
+    xrt_hip_test_common::test_hip_check(hipModuleLaunchKernel(function,
+                                         vector_length/threads_per_block_x, 1, 1,
+                                         threads_per_block_x, 1, 1,
+                                         0, run_stream, args.data(), nullptr), kernel_name);
+  }
+  xrt_hip_test_common::test_hip_check(hipEventRecord(stop, run_stream));
+
+  // Read back the result on copy_stream, which must not start the copy
+  // before the kernels recorded ahead of stop have completed
+  xrt_hip_test_common::test_hip_check(hipStreamWaitEvent(copy_stream, stop, 0));
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(host_a.data(), device_a.get(), vector_size, hipMemcpyDeviceToHost, copy_stream));
+
+  int errors = 0;
+
+  xrt_hip_test_common::test_hip_check(hipEventSynchronize(stop));
+  if (hipEventQuery(stop) != hipSuccess) {
+    std::cout << "hipEventQuery on a synchronized event did not return hipSuccess" << std::endl;
+    errors++;
+  }
+  if (hipEventQuery(start) != hipSuccess) {
+    std::cout << "hipEventQuery on an event recorded before a completed event did not return hipSuccess" << std::endl;
+    errors++;
+  }
+
+  float elapsed_ms = 0;
+  xrt_hip_test_common::test_hip_check(hipEventElapsedTime(&elapsed_ms, start, stop));
+  std::cout << '(' << repeat_loop << " loops, " << elapsed_ms << " ms between events)" << std::endl;
+  if (elapsed_ms < 0) {
+    std::cout << "Elapsed time between events is negative" << std::endl;
+    errors++;
+  }
+
+  xrt_hip_test_common::test_hip_check(hipStreamSynchronize(copy_stream));
+  for (int i = 0; i < vector_length; i++) {
+    if (host_a[i] == host_b[i] + host_c[i])
+      continue;
+    std::cout << "Mismatch at " << i << ", got " << host_a[i]
+              << ", expected " << host_b[i] + host_c[i] << std::endl;
+    errors++;
+    break;
+  }
+
+  xrt_hip_test_common::test_hip_check(hipEventDestroy(stop));
+  xrt_hip_test_common::test_hip_check(hipEventDestroy(start));
+  xrt_hip_test_common::test_hip_check(hipStreamDestroy(copy_stream));
+  xrt_hip_test_common::test_hip_check(hipStreamDestroy(run_stream));
+
+  if (errors)
+    std::cout << "FAILED TEST" << std::endl;
+  else
+    std::cout << "PASSED TEST" << std::endl;
+
+  return errors;
+}
+}
+
+int
+main()
+{
+  try {
+    return mainworker();
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+
+// Captures copies and kernel launches issued on a stream into a graph,
+// replays the graph with new host inputs and checks the results, then
+// updates the graph with changed kernel arguments and replays it again.
+
+#include <iostream>
+#include <array>
+#include <vector>
+
+#include "hip/hip_runtime_api.h"
+
+#include "common.h"
+
+namespace {
+
+static constexpr char const *kernel_filename = "kernel.co";
+static constexpr char const *kernel_name = "vectoradd";
+
+static constexpr int vector_length = 0x100000;
+static constexpr int vector_size = vector_length * sizeof(float);
+static constexpr int threads_per_block_x = 32;
+static constexpr int repeat_loop = 16;
+
+// Capture the copy in, vectoradd(out, in0, in1), copy out sequence
+hipGraph_t
+capture(hipStream_t stream, hipFunction_t function, std::array<void *, 3> &args,
+        float *device_in0, float *device_in1, float *device_out,
+        const std::vector<float>& host_in0, const std::vector<float>& host_in1, std::vector<float>& host_out)
+{
+  xrt_hip_test_common::test_hip_check(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_in0, host_in0.data(), vector_size, hipMemcpyHostToDevice, stream));
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_in1, host_in1.data(), vector_size, hipMemcpyHostToDevice, stream));
+  xrt_hip_test_common::test_hip_check(hipModuleLaunchKernel(function,
+                                       vector_length/threads_per_block_x, 1, 1,
+                                       threads_per_block_x, 1, 1,
+                                       0, stream, args.data(), nullptr), kernel_name);
+  xrt_hip_test_common::test_hip_check(hipMemcpyAsync(host_out.data(), device_out, vector_size, hipMemcpyDeviceToHost, stream));
+
+  hipGraph_t graph = nullptr;
+  xrt_hip_test_common::test_hip_check(hipStreamEndCapture(stream, &graph));
+  return graph;
+}
+
+int
+verify(const std::vector<float>& host_out, const std::vector<float>& host_in0,
+       const std::vector<float>& host_in1, int iteration)
+{
+  for (int i = 0; i < vector_length; i++) {
+    if (host_out[i] == host_in0[i] + host_in1[i])
+      continue;
+    std::cout << "Iteration " << iteration << ": mismatch at " << i << ", got "
+              << host_out[i] << ", expected " << host_in0[i] + host_in1[i] << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int
+mainworker()
+{
+  xrt_hip_test_common::hip_test_device hdevice;
+  hdevice.show_info(std::cout);
+
+  hipFunction_t function = hdevice.get_function(kernel_filename, kernel_name);
+
+  hipStream_t stream = nullptr;
+  xrt_hip_test_common::test_hip_check(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+  std::vector<float> host_a(vector_length);
+  std::vector<float> host_b(vector_length);
+  std::vector<float> host_c(vector_length);
+
+  xrt_hip_test_common::hip_test_device_bo<float> device_a(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_b(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_c(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_d(vector_length);
+
+  std::array<void *, 3> args = {&device_a.get(), &device_b.get(), &device_c.get()};
+  hipGraph_t graph = capture(stream, function, args, device_b.get(), device_c.get(), device_a.get(),
+                             host_b, host_c, host_a);
+
+  hipGraphExec_t graph_exec = nullptr;
+  xrt_hip_test_common::test_hip_check(hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0));
+
+  int errors = 0;
+
+  // Replay with new host inputs every iteration, the captured copies
+  // read the host buffers when the graph runs
+  std::cout << "Replay captured graph " << repeat_loop << " times" << std::endl;
+  for (int iter = 0; iter < repeat_loop && !errors; iter++) {
+    for (int i = 0; i < vector_length; i++) {
+      host_b[i] = static_cast<float>(i + iter);
+      host_c[i] = static_cast<float>(i * 2);
+      host_a[i] = 0;
+    }
+
+    xrt_hip_test_common::test_hip_check(hipGraphLaunch(graph_exec, stream));
+    xrt_hip_test_common::test_hip_check(hipStreamSynchronize(stream));
+    errors += verify(host_a, host_b, host_c, iter);
+  }
+
+  // Capture the same sequence writing to another device buffer with
+  // both inputs read from device_b, and update the executable graph
+  if (!errors) {
+    std::cout << "Update graph with changed kernel arguments and replay" << std::endl;
+    std::array<void *, 3> update_args = {&device_d.get(), &device_b.get(), &device_b.get()};
+    hipGraph_t update = capture(stream, function, update_args, device_b.get(), device_c.get(), device_d.get(),
+                                host_b, host_c, host_a);
+
+    hipGraphExecUpdateResult result = hipGraphExecUpdateError;
+    xrt_hip_test_common::test_hip_check(hipGraphExecUpdate(graph_exec, update, nullptr, &result));
+    if (result != hipGraphExecUpdateSuccess) {
+      std::cout << "hipGraphExecUpdate did not report success" << std::endl;
+      errors++;
+    }
+
+    for (int iter = 0; iter < repeat_loop && !errors; iter++) {
+      for (int i = 0; i < vector_length; i++) {
+        host_b[i] = static_cast<float>(i * 3 + iter);
+        host_c[i] = static_cast<float>(i);
+        host_a[i] = 0;
+      }
+
+      xrt_hip_test_common::test_hip_check(hipGraphLaunch(graph_exec, stream));
+      xrt_hip_test_common::test_hip_check(hipStreamSynchronize(stream));
+      errors += verify(host_a, host_b, host_b, iter);
+    }
+
+    xrt_hip_test_common::test_hip_check(hipGraphDestroy(update));
+  }
+
+  xrt_hip_test_common::test_hip_check(hipGraphExecDestroy(graph_exec));
+  xrt_hip_test_common::test_hip_check(hipGraphDestroy(graph));
+  xrt_hip_test_common::test_hip_check(hipStreamDestroy(stream));
+
+  if (errors)
+    std::cout << "FAILED TEST" << std::endl;
+  else
+    std::cout << "PASSED TEST" << std::endl;
+
+  return errors;
+}
+}
+
+int
+main()
+{
+  try {
+    return mainworker();
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+
+// Checks that hipMemcpyAsync and hipMemsetAsync are ordered with the
+// kernels of their stream and have completed once the stream is
+// synchronized.
+
+#include <iostream>
+#include <array>
+#include <vector>
+
+#include "hip/hip_runtime_api.h"
+
+#include "common.h"
+
+namespace {
+
+static constexpr char const *kernel_filename = "kernel.co";
+static constexpr char const *kernel_name = "vectoradd";
+
+static constexpr int vector_length = 0x100000;
+static constexpr int vector_size = vector_length * sizeof(float);
+static constexpr int threads_per_block_x = 32;
+static constexpr int repeat_loop = 16;
+
+int
+verify(const std::vector<float>& host_a, const std::vector<float>& host_b,
+       const std::vector<float>& host_c, int iteration)
+{
+  for (int i = 0; i < vector_length; i++) {
+    if (host_a[i] == host_b[i] + host_c[i])
+      continue;
+    std::cout << "Iteration " << iteration << ": mismatch at " << i << ", got "
+              << host_a[i] << ", expected " << host_b[i] + host_c[i] << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int
+mainworker()
+{
+  xrt_hip_test_common::hip_test_device hdevice;
+  hdevice.show_info(std::cout);
+
+  hipFunction_t function = hdevice.get_function(kernel_filename, kernel_name);
+
+  hipStream_t stream = nullptr;
+  xrt_hip_test_common::test_hip_check(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+  std::vector<float> host_a(vector_length);
+  std::vector<float> host_b(vector_length);
+  std::vector<float> host_c(vector_length);
+
+  xrt_hip_test_common::hip_test_device_bo<float> device_a(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_b(vector_length);
+  xrt_hip_test_common::hip_test_device_bo<float> device_c(vector_length);
+
+  std::array<void *, 3> args = {&device_a.get(), &device_b.get(), &device_c.get()};
+
+  int errors = 0;
+
+  // Copy in, run and copy out without blocking, with fresh inputs every
+  // iteration. Only synchronizing the stream may wait for the work.
+  std::cout << "Run " << kernel_name << ' ' << repeat_loop << " times with async copies" << std::endl;
+  for (int iter = 0; iter < repeat_loop && !errors; iter++) {
+    for (int i = 0; i < vector_length; i++) {
+      host_b[i] = static_cast<float>(i + iter);
+      host_c[i] = static_cast<float>(i * 2);
+      host_a[i] = 0;
+    }
+
+    xrt_hip_test_common::test_hip_check(hipMemsetAsync(device_a.get(), 0, vector_size, stream));
+    xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_b.get(), host_b.data(), vector_size, hipMemcpyHostToDevice, stream));
+    xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_c.get(), host_c.data(), vector_size, hipMemcpyHostToDevice, stream));
+    xrt_hip_test_common::test_hip_check(hipModuleLaunchKernel(function,
+                                         vector_length/threads_per_block_x, 1, 1,
+                                         threads_per_block_x, 1, 1,
+                                         0, stream, args.data(), nullptr), kernel_name);
+    xrt_hip_test_common::test_hip_check(hipMemcpyAsync(host_a.data(), device_a.get(), vector_size, hipMemcpyDeviceToHost, stream));
+    xrt_hip_test_common::test_hip_check(hipStreamSynchronize(stream));
+
+    errors += verify(host_a, host_b, host_c, iter);
+  }
+
+  // A device to device copy followed by a partial memset at an offset
+  // into the allocation, both read back after the stream is synchronized.
+  if (!errors) {
+    std::cout << "Device to device copy and memset at an offset" << std::endl;
+    static constexpr int half_length = vector_length / 2;
+    xrt_hip_test_common::test_hip_check(hipMemcpyAsync(device_c.get(), device_b.get(), vector_size, hipMemcpyDeviceToDevice, stream));
+    xrt_hip_test_common::test_hip_check(hipMemsetAsync(device_c.get() + half_length, 0, vector_size / 2, stream));
+    xrt_hip_test_common::test_hip_check(hipMemcpyAsync(host_c.data(), device_c.get(), vector_size, hipMemcpyDeviceToHost, stream));
+    xrt_hip_test_common::test_hip_check(hipStreamSynchronize(stream));
+
+    for (int i = 0; i < vector_length; i++) {
+      const float expected = (i < half_length) ? host_b[i] : 0.0f;
+      if (host_c[i] == expected)
+        continue;
+      std::cout << "Mismatch at " << i << ", got " << host_c[i] << ", expected " << expected << std::endl;
+      errors++;
+      break;
+    }
+  }
+
+  xrt_hip_test_common::test_hip_check(hipStreamDestroy(stream));
+
+  if (errors)
+    std::cout << "FAILED TEST" << std::endl;
+  else
+    std::cout << "PASSED TEST" << std::endl;
+
+  return errors;
+}
+}
+
+int
+main()
+{
+  try {
+    return mainworker();
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+/****************************************************************
+Fence event shared by several xrt::queue tasks
+
+A fence is signaled by a kernel run and wrapped in an
+xrt::queue::event.  The same event is a dependency of two tasks in
+a multi worker queue and is finally waited on by the host.  Waiting
+on a fence consumes its signal, the event must latch the signalled
+state so every waiter is released.
+
+The test is skipped on devices that do not support fences.
+
+% g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o enqueue_fence.exe enqueue_fence.cpp -lxrt_coreutil -luuid -pthread
+****************************************************************/
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+#include "experimental/xrt_fence.h"
+#include "experimental/xrt_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// void addone (__global ulong8 *in1, __global ulong8* in2, __global ulong8* out, unsigned int elements)
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] \n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+}
+
+// A task blocked forever on the fence cannot be joined, so exit
+// without unwinding.
+static void
+check_ready(std::shared_future<void>& f, const std::string& what)
+{
+  if (f.wait_for(std::chrono::seconds(5)) == std::future_status::timeout) {
+    std::cout << "TEST FAILED: " << what << " did not complete\n";
+    std::exit(1);
+  }
+}
+
+static void
+run_test(const xrt::device& device, const xrt::kernel& kernel)
+{
+  const size_t bytes = ELEMENTS * ARRAY_SIZE * sizeof(unsigned long);
+  xrt::bo in(device, bytes, kernel.group_id(0));
+  xrt::bo out(device, bytes, kernel.group_id(2));
+  xrt::run run(kernel);
+  run.set_arg(0, in);
+  run.set_arg(1, in);
+  run.set_arg(2, out);
+  run.set_arg(3, static_cast<unsigned int>(ELEMENTS));
+
+  xrt::fence fence(device, xrt::fence::access_mode::local);
+  run.start();
+  run.submit_signal(fence);
+
+  xrt::queue queue{2};
+  xrt::queue::event ev{fence};
+  std::atomic<int> count {0};
+  auto t1 = queue.enqueue([&count] { ++count; }, {ev});
+  auto t2 = queue.enqueue([&count] { ++count; }, {ev});
+
+  check_ready(t1, "first task");
+  check_ready(t2, "second task");
+
+  // The host waits on the same event after the tasks
+  auto host = std::async(std::launch::async, [&ev] { ev.wait(); }).share();
+  check_ready(host, "host wait");
+
+  if (!ev.ready())
+    throw std::runtime_error("event not ready after wait");
+
+  if (count != 2)
+    throw std::runtime_error("expected 2 tasks to execute, got " + std::to_string(count));
+
+  run.wait();
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, "addone");
+
+  try {
+    run_test(device, kernel);
+  }
+  catch (const std::system_error& ex) {
+    if (ex.code() != std::errc::not_supported)
+      throw;
+    std::cout << "fences not supported (" << ex.what() << "), test skipped\n";
+  }
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    auto ret = run(argc,argv);
+    if (!ret)
+      std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
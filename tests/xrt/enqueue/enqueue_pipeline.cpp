@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+/****************************************************************
+Micro benchmark of xrt::queue with multiple workers
+
+Each pipeline syncs an input buffer to device, runs the addone kernel,
+and syncs the output buffer from device.  A number of independent
+pipelines are enqueued repeatedly:
+
+  serialized: all operations are enqueued in a single consumer queue
+              and execute one at a time in order of enqueuing
+
+  overlapped: the operations are enqueued in a queue with a pool of
+              consumers.  Each operation depends only on the previous
+              operation of its own pipeline, so DMA and kernel
+              execution of different pipelines overlap
+
+The test can be run without hardware against the noop shim:
+
+% XCL_EMULATION_MODE=noop ./enqueue_pipeline -k kernel.xclbin
+
+Set noop_completion_delay_us in the [Runtime] section of xrt.ini to
+simulate kernel execution time.
+
+% g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o enqueue_pipeline.exe enqueue_pipeline.cpp -lxrt_coreutil -luuid -pthread
+****************************************************************/
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+#include "experimental/xrt_queue.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+// void addone (__global ulong8 *in1, __global ulong8* in2, __global ulong8* out, unsigned int elements)
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+static constexpr size_t MAXCUS = 8;
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] \n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "";
+  std::cout << "  [--pipelines <number>]: number of independent pipelines (default: 4)\n";
+  std::cout << "  [--workers <number>]: number of queue workers for overlapped run (default: pipelines)\n";
+  std::cout << "  [--iterations <number>]: number of times each pipeline is enqueued (default: 1000)\n";
+  std::cout << "  [--cus <number>]: number of cus to use (default: 8) (max: 8)\n";
+}
+
+static std::string
+get_kernel_name(size_t cus)
+{
+  std::string k("addone:{");
+  for (size_t i=1; i<cus; ++i)
+    k.append("addone_").append(std::to_string(i)).append(",");
+  k.append("addone_").append(std::to_string(cus)).append("}");
+  return k;
+}
+
+struct pipeline
+{
+  xrt::bo in;
+  xrt::bo out;
+  xrt::run run;
+
+  pipeline(const xrt::device& device, const xrt::kernel& kernel)
+    : in(device, ELEMENTS * ARRAY_SIZE * sizeof(unsigned long), kernel.group_id(0))
+    , out(device, ELEMENTS * ARRAY_SIZE * sizeof(unsigned long), kernel.group_id(2))
+    , run(kernel)
+  {
+    run.set_arg(0, in);
+    run.set_arg(1, in);
+    run.set_arg(2, out);
+    run.set_arg(3, static_cast<unsigned int>(ELEMENTS));
+  }
+
+  void
+  sync_in()
+  {
+    in.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  }
+
+  void
+  execute()
+  {
+    run.start();
+    run.wait();
+  }
+
+  void
+  sync_out()
+  {
+    out.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  }
+};
+
+// All operations in one in-order queue
+static double
+run_serialized(std::vector<pipeline>& pipelines, size_t iterations)
+{
+  xrt::queue queue;
+  std::shared_future<void> last;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t it = 0; it < iterations; ++it) {
+    for (auto& p : pipelines) {
+      queue.enqueue([&p] { p.sync_in(); });
+      queue.enqueue([&p] { p.execute(); });
+      last = queue.enqueue([&p] { p.sync_out(); });
+    }
+  }
+  last.wait();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+// Each pipeline is a dependency chain in a multi worker queue
+static double
+run_overlapped(std::vector<pipeline>& pipelines, size_t iterations, unsigned int workers)
+{
+  xrt::queue queue{workers};
+  std::vector<xrt::queue::event> last(pipelines.size());
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t it = 0; it < iterations; ++it) {
+    for (size_t idx = 0; idx < pipelines.size(); ++idx) {
+      auto& p = pipelines[idx];
+      std::vector<xrt::queue::event> deps;
+      if (last[idx])
+        deps.push_back(last[idx]);
+      xrt::queue::event ev = queue.enqueue([&p] { p.sync_in(); }, deps);
+      ev = queue.enqueue([&p] { p.execute(); }, {ev});
+      last[idx] = queue.enqueue([&p] { p.sync_out(); }, {ev});
+    }
+  }
+  for (auto& ev : last)
+    ev.wait();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+  size_t num_pipelines = 4;
+  size_t iterations = 1000;
+  unsigned int workers = 0;
+  size_t cus = MAXCUS;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--pipelines")
+      num_pipelines = std::stoi(arg);
+    else if (cur == "--workers")
+      workers = std::stoi(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else if (cur == "--cus")
+      cus = std::stoi(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  if (!workers)
+    workers = static_cast<unsigned int>(num_pipelines);
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, get_kernel_name(std::min(cus, MAXCUS)));
+
+  std::vector<pipeline> pipelines;
+  pipelines.reserve(num_pipelines);
+  for (size_t i = 0; i < num_pipelines; ++i)
+    pipelines.emplace_back(device, kernel);
+
+  auto serialized = run_serialized(pipelines, iterations);
+  auto overlapped = run_overlapped(pipelines, iterations, workers);
+
+  auto total = num_pipelines * iterations;
+  std::cout << "pipelines: " << num_pipelines << " iterations: " << iterations
+            << " workers: " << workers << "\n";
+  std::cout << "serialized: " << serialized << "us ("
+            << (total * 1000000.0 / serialized) << " pipelines/s)\n";
+  std::cout << "overlapped: " << overlapped << "us ("
+            << (total * 1000000.0 / overlapped) << " pipelines/s)\n";
+  std::cout << "speedup: " << (serialized / overlapped) << "\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    auto ret = run(argc,argv);
+    if (!ret)
+      std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
@@ -10,6 +10,7 @@
 
 #include "xrt/xrt_device.h"
 #include "xrt/xrt_bo.h"
+#include "xrt/xrt_hw_context.h"
 #include "xrt/xrt_kernel.h"
 
 #ifdef _WIN32
@@ -77,6 +78,51 @@ testSingleThread(const xrt::device& device, const xrt::uuid& uuid)
   }
 }
 
+static double
+runListTest(xrt::runlist& runlist, unsigned int total)
+{
+  unsigned int completed = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  while (completed < total) {
+    runlist.execute();
+    runlist.wait();
+    completed += runlist.size();
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+}
+
+static void
+testRunlist(const xrt::device& device, const xrt::uuid& uuid)
+{
+  std::vector<unsigned int> cmds_per_list = { 1,2,4,8,16,32,64,128 };
+  unsigned int total = 128 * 1024;  // multiple of all list sizes
+
+  auto hwctx = xrt::hw_context(device, uuid);
+  auto hello = xrt::kernel(hwctx, "hello");
+
+  std::vector<xrt::run> cmds;
+  for (unsigned int i = 0; i < cmds_per_list.back(); i++) {
+    auto run = xrt::run(hello);
+    run.set_arg(0, xrt::bo(device, 20, hello.group_id(0)));
+    cmds.push_back(std::move(run));
+  }
+
+  for (auto num_cmds : cmds_per_list) {
+    xrt::runlist runlist{hwctx};
+    for (unsigned int i = 0; i < num_cmds; i++)
+      runlist.add(cmds[i]);
+
+    double duration = runListTest(runlist, total);
+    std::cout << "Runlist size: " << std::setw(4) << num_cmds
+              << " commands: " << total
+              << " iops: " << (total * 1000.0 * 1000.0 / duration)
+              << std::endl;
+  }
+}
+
 static int
 _main(int argc, char* argv[])
 {
@@ -91,6 +137,7 @@ _main(int argc, char* argv[])
   auto uuid = device.load_xclbin(xclbin_fn);
 
   testSingleThread(device, uuid);
+  testRunlist(device, uuid);
 
   return 0;
 }
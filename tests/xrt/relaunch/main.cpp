@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+/****************************************************************
+Relaunch of managed runs after failed submission
+
+A run with a completion callback is executed as a managed command.
+If submission of the command fails, the run is reverted to its done
+state and can be started again.  This test repeatedly starts a
+managed run where some of the submissions fail and verifies that
+every successful start completes and is notified exactly once.
+
+The test is intended for the noop shim with submission failures
+injected through xrt.ini:
+
+  [Runtime]
+  noop_exec_buf_fail_interval = 3
+
+% XCL_EMULATION_MODE=noop ./relaunch -k kernel.xclbin
+
+% g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o relaunch.exe main.cpp -lxrt_coreutil -luuid -pthread
+****************************************************************/
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n"
+            << "\n"
+            << "  -k <bitstream>\n"
+            << "  -d <index>\n"
+            << "  -i <iterations, default is 1000>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required\n";
+}
+
+// Start a run, retrying as long as submission fails.  Returns number
+// of failed submissions.  A failed start must leave the run ready to
+// be started again right away.
+static size_t
+start(xrt::run& run)
+{
+  size_t failures = 0;
+  while (true) {
+    try {
+      run.start();
+      return failures;
+    }
+    catch (const std::system_error&) {
+      ++failures;
+    }
+  }
+}
+
+static void
+run_test(const xrt::device& device, const xrt::uuid& uuid, size_t iterations)
+{
+  auto addone = xrt::kernel(device, uuid, "addone");
+  const size_t size = ELEMENTS * ARRAY_SIZE;
+  const size_t bytes = sizeof(unsigned long) * size;
+
+  auto a = xrt::bo(device, bytes, addone.group_id(0));
+  auto a_data = a.map<unsigned long*>();
+  std::iota(a_data, a_data + size, 0);
+  a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  auto b = xrt::bo(device, bytes, addone.group_id(1));
+
+  std::atomic<size_t> notified {0};
+  xrt::run run(addone);
+  run.set_arg(0, a);
+  run.set_arg(1, b);
+  run.set_arg(2, static_cast<unsigned int>(ELEMENTS));
+  run.add_callback(ERT_CMD_STATE_COMPLETED,
+                   [](const void*, ert_cmd_state, void* data) {
+                     ++(*static_cast<std::atomic<size_t>*>(data));
+                   }, &notified);
+
+  size_t failures = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    failures += start(run);
+    auto state = run.wait();
+    if (state != ERT_CMD_STATE_COMPLETED)
+      throw std::runtime_error("iteration " + std::to_string(i) + " completed with state " + std::to_string(state));
+  }
+
+  // Callbacks are called after wait() returns
+  for (size_t i = 0; notified != iterations && i < 1000; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  if (notified != iterations)
+    throw std::runtime_error("expected " + std::to_string(iterations)
+                             + " callbacks, got " + std::to_string(notified));
+
+  std::cout << "iterations: " << iterations << ", failed submissions: " << failures << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+  size_t iterations = 1000;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-i")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+
+  run_test(device, uuid, iterations);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+  return 1;
+}
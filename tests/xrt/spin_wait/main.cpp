@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+/****************************************************************
+Spin budget of command waits configured per hardware context
+
+A hardware context is created with configuration parameter
+"exec_wait_spin_us", which sets how long a thread waiting for a
+command of the context polls the command state before blocking.
+The test uses a spin budget far larger than the wait timeout and
+verifies that timed waits return within their timeout and that all
+runs complete with the expected result.
+
+% g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o spin_wait.exe main.cpp -lxrt_coreutil -luuid -pthread
+****************************************************************/
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr size_t ELEMENTS = 16;
+static constexpr size_t ARRAY_SIZE = 8;
+
+// Spin budget much larger than the wait timeout
+static constexpr uint32_t spin_budget_us = 5000000;
+static constexpr std::chrono::milliseconds wait_timeout {1};
+
+// Slack allowed for a timed wait to return past its timeout
+static constexpr std::chrono::milliseconds wait_slack {500};
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n"
+            << "\n"
+            << "  -k <bitstream>\n"
+            << "  -d <index>\n"
+            << "  -i <iterations, default is 100>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required\n";
+}
+
+static void
+run_test(const xrt::device& device, const xrt::uuid& uuid, size_t iterations)
+{
+  xrt::hw_context::cfg_param_type cfg {{"exec_wait_spin_us", spin_budget_us}};
+  xrt::hw_context hwctx(device, uuid, cfg);
+  auto addone = xrt::kernel(hwctx, "addone");
+
+  const size_t size = ELEMENTS * ARRAY_SIZE;
+  const size_t bytes = sizeof(unsigned long) * size;
+
+  auto a = xrt::bo(device, bytes, addone.group_id(0));
+  auto a_data = a.map<unsigned long*>();
+  std::iota(a_data, a_data + size, 0);
+  a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  auto b = xrt::bo(device, bytes, addone.group_id(1));
+  auto b_data = b.map<unsigned long*>();
+
+  xrt::run run(addone);
+  run.set_arg(0, a);
+  run.set_arg(1, b);
+  run.set_arg(2, static_cast<unsigned int>(ELEMENTS));
+
+  size_t timeouts = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    run.start();
+    while (true) {
+      auto start = std::chrono::steady_clock::now();
+      auto state = run.wait(wait_timeout);
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      if (elapsed > wait_timeout + wait_slack)
+        throw std::runtime_error("timed wait took "
+                                 + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count())
+                                 + "ms with timeout " + std::to_string(wait_timeout.count()) + "ms");
+      if (state == ERT_CMD_STATE_COMPLETED)
+        break;
+      if (state != ERT_CMD_STATE_TIMEOUT)
+        throw std::runtime_error("iteration " + std::to_string(i) + " completed with state " + std::to_string(state));
+      ++timeouts;
+    }
+  }
+
+  b.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  for (size_t i = 0; i < size; ++i)
+    if (b_data[i] != a_data[i] + 1)
+      throw std::runtime_error("result mismatch at " + std::to_string(i));
+
+  std::cout << "iterations: " << iterations << ", timed out waits: " << timeouts << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+  size_t iterations = 100;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-i")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.register_xclbin(xrt::xclbin(xclbin_fnm));
+
+  run_test(device, uuid, iterations);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+  return 1;
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark of xclbin meta data extraction with and without the
+// xclbin meta data cache (xrt.ini Runtime.xclbin_metadata_cache).
+//
+// Kernel meta data is extracted from the xclbin the first time a
+// kernel is constructed from an xclbin.  This benchmark measures the
+// extraction by accessing the kernels of a freshly constructed
+// xrt::xclbin object.  A cold run removes the cache file before each
+// iteration, which forces parsing of the XML and writing of the cache
+// file.  A warm run loads the meta data from the cache file.
+//
+// % g++ -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o xclbin_metadata_cache.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+#include "experimental/xrt_ini.h"
+#include "experimental/xrt_xclbin.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: xclbin_metadata_cache.exe [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  [-i <iterations>] (default 100)\n";
+  std::cout << "  [-c <cache dir>] (default ./xclbin_metadata_cache)\n";
+  std::cout << "  [-h]\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+// Construct an xclbin and extract its kernel meta data, return
+// elapsed time in microseconds.
+static double
+extract(const std::string& xclbin_fnm, const std::filesystem::path& cache_file, bool cold)
+{
+  if (cold)
+    std::filesystem::remove(cache_file);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  xrt::xclbin xclbin{xclbin_fnm};
+  auto kernels = xclbin.get_kernels();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (kernels.empty())
+    throw std::runtime_error("xclbin has no kernels");
+
+  return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(end - start).count();
+}
+
+static void
+run(const std::string& xclbin_fnm, const std::filesystem::path& cache_file, size_t iterations, bool cold)
+{
+  double total = 0;
+  for (size_t i = 0; i < iterations; ++i)
+    total += extract(xclbin_fnm, cache_file, cold);
+
+  std::cout << (cold ? "cold" : "warm") << ": " << iterations
+            << " iterations, average " << total / iterations << " us\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+
+  std::string xclbin_fnm;
+  std::string cache_dir = "xclbin_metadata_cache";
+  size_t iterations = 100;
+
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-i")
+      iterations = std::stoul(arg);
+    else if (cur == "-c")
+      cache_dir = arg;
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  // Must be set before any other use of XRT in this process
+  auto dir = std::filesystem::absolute(cache_dir);
+  xrt::ini::set("Runtime.xclbin_metadata_cache", "true");
+  xrt::ini::set("Runtime.xclbin_metadata_cache_dir", dir.string());
+
+  auto cache_file = dir / (xrt::xclbin{xclbin_fnm}.get_uuid().to_string() + ".bin");
+
+  run(xclbin_fnm, cache_file, iterations, true);
+  run(xclbin_fnm, cache_file, iterations, false);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+    return 1;
+  }
+}